@@ -17,7 +17,8 @@
 //=============================================================================
 
 #include "AssetManager.h"
-#include <iostream>
+#include "ContentHash.h"
+#include "Logger.h"
 #include <stdexcept>
 #include <algorithm>
 #include <cctype>
@@ -30,11 +31,24 @@ AssetManager& AssetManager::getInstance() {
 }
 
 void AssetManager::loadTexture(const std::string& name, const std::string& filename) {
+    if (m_headless) {
+        // No GPU upload: decode once to validate the file and keep the CPU copy
+        auto img = std::make_shared<sf::Image>();
+        if (!img->loadFromFile(filename)) {
+            throw std::runtime_error("Texture load failed: " + filename);
+        }
+        m_images[name] = std::move(img);
+        m_texturePaths[name] = filename;
+        return;
+    }
+
     auto tex = std::make_shared<sf::Texture>();
     if (!tex->loadFromFile(filename)) {
         throw std::runtime_error("Texture load failed: " + filename);
     }
     m_textures[name] = std::move(tex);
+    m_texturePaths[name] = filename;
+    m_images.erase(name);
 }
 
 TexturePtr AssetManager::getTexture(const std::string& name) const {
@@ -48,6 +62,7 @@ void AssetManager::loadFont(const std::string& name, const std::string& filename
         throw std::runtime_error("Font load failed: " + filename);
     }
     m_fonts[name] = std::move(font);
+    m_fontPaths[name] = filename;
 }
 
 sf::Font& AssetManager::getFont(const std::string& name) {
@@ -58,14 +73,84 @@ sf::Font& AssetManager::getFont(const std::string& name) {
     return it->second;
 }
 
+void AssetManager::setHeadless(bool headless) { m_headless = headless; }
+
+bool AssetManager::isHeadless() const { return m_headless; }
+
+bool AssetManager::hasTexture(const std::string& name) const {
+    return m_texturePaths.count(name) > 0;
+}
+
+ImagePtr AssetManager::getImage(const std::string& name) {
+    auto cached = m_images.find(name);
+    if (cached != m_images.end()) return cached->second;
+
+    auto path = m_texturePaths.find(name);
+    if (path == m_texturePaths.end()) return nullptr;
+
+    auto img = std::make_shared<sf::Image>();
+    if (!img->loadFromFile(path->second)) {
+        LOG_WARN("AssetManager") << "Image decode failed: " << path->second;
+        return nullptr;
+    }
+    m_images[name] = img;
+    return img;
+}
+
+std::string AssetManager::getTexturePath(const std::string& name) const {
+    auto it = m_texturePaths.find(name);
+    return it == m_texturePaths.end() ? std::string() : it->second;
+}
+
+std::string AssetManager::getFontPath(const std::string& name) const {
+    auto it = m_fontPaths.find(name);
+    return it == m_fontPaths.end() ? std::string() : it->second;
+}
+
+std::uint64_t AssetManager::getTextureHash(const std::string& name) {
+    return hashAssetFile(getTexturePath(name));
+}
+
+std::uint64_t AssetManager::getFontHash(const std::string& name) {
+    return hashAssetFile(getFontPath(name));
+}
+
+std::uint64_t AssetManager::hashAssetFile(const std::string& path) {
+    if (path.empty()) return 0;
+    auto it = m_fileHashes.find(path);
+    if (it != m_fileHashes.end()) return it->second;
+    return m_fileHashes[path] = hashFile(path);
+}
+
+AssetMemoryUsage AssetManager::getMemoryUsage() const {
+    AssetMemoryUsage usage;
+    for (const auto& [name, tex] : m_textures) {
+        if (!tex) continue;
+        usage.textureBytes += static_cast<std::size_t>(tex->getSize().x) * tex->getSize().y * 4;
+        ++usage.textureCount;
+    }
+    for (const auto& [name, img] : m_images) {
+        if (!img) continue;
+        usage.imageBytes += static_cast<std::size_t>(img->getSize().x) * img->getSize().y * 4;
+        ++usage.imageCount;
+    }
+    for (const auto& [name, path] : m_fontPaths) {
+        std::error_code ec;
+        auto size = fs::file_size(path, ec);
+        usage.fontBytes += ec ? 0 : static_cast<std::size_t>(size);
+        ++usage.fontCount;
+    }
+    return usage;
+}
+
 // Auto-load all character images from directory (case-insensitive extensions)
 void AssetManager::autoLoadCharacters(const std::string& dir) {
     if (!fs::exists(dir)) {
-        std::cerr << "[AssetManager] Directory not found: " << dir << "\n";
+        LOG_WARN("AssetManager") << "Directory not found: " << dir;
         return;
     }
 
-    std::cout << "[AssetManager] Scanning characters in: " << dir << "\n";
+    LOG_INFO("AssetManager") << "Scanning characters in: " << dir;
     for (const auto& entry : fs::directory_iterator(dir)) {
         if (!entry.is_regular_file()) continue;
 
@@ -81,9 +166,9 @@ void AssetManager::autoLoadCharacters(const std::string& dir) {
             try {
                 loadTexture(name, path);
                 m_assetList.push_back({ "CHARACTER", name, path });
-                std::cout << "  [✓] Loaded character: " << name << "\n";
+                LOG_DEBUG("AssetManager") << "Loaded character: " << name;
             } catch (const std::exception& e) {
-                std::cerr << "  [x] Failed: " << name << " - " << e.what() << "\n";
+                LOG_WARN("AssetManager") << "Failed: " << name << " - " << e.what();
             }
         }
     }
@@ -93,11 +178,11 @@ void AssetManager::autoLoadCharacters(const std::string& dir) {
 // Auto-load all fonts from directory (case-insensitive extensions)
 void AssetManager::autoLoadFonts(const std::string& dir) {
     if (!fs::exists(dir)) {
-        std::cerr << "[AssetManager] Directory not found: " << dir << "\n";
+        LOG_WARN("AssetManager") << "Directory not found: " << dir;
         return;
     }
 
-    std::cout << "[AssetManager] Scanning fonts in: " << dir << "\n";
+    LOG_INFO("AssetManager") << "Scanning fonts in: " << dir;
     for (const auto& entry : fs::directory_iterator(dir)) {
         if (!entry.is_regular_file()) continue;
 
@@ -113,9 +198,9 @@ void AssetManager::autoLoadFonts(const std::string& dir) {
             try {
                 loadFont(name, path);
                 m_assetList.push_back({ "FONT", name, path });
-                std::cout << "  [✓] Loaded font: " << name << "\n";
+                LOG_DEBUG("AssetManager") << "Loaded font: " << name;
             } catch (const std::exception& e) {
-                std::cerr << "  [x] Failed: " << name << " - " << e.what() << "\n";
+                LOG_WARN("AssetManager") << "Failed: " << name << " - " << e.what();
             }
         }
     }
@@ -126,11 +211,11 @@ void AssetManager::autoLoadFonts(const std::string& dir) {
 // Auto-load all speech bubble images from directory (case-insensitive extensions)
 void AssetManager::autoLoadBubbles(const std::string& dir) {
     if (!fs::exists(dir)) {
-        std::cerr << "[AssetManager] Directory not found: " << dir << "\n";
+        LOG_WARN("AssetManager") << "Directory not found: " << dir;
         return;
     }
 
-    std::cout << "[AssetManager] Scanning bubbles in: " << dir << "\n";
+    LOG_INFO("AssetManager") << "Scanning bubbles in: " << dir;
     for (const auto& entry : fs::directory_iterator(dir)) {
         if (!entry.is_regular_file()) continue;
 
@@ -148,10 +233,9 @@ void AssetManager::autoLoadBubbles(const std::string& dir) {
                 std::string key = "bubble_" + name;
                 loadTexture(key, path);
                 m_assetList.push_back({ "BUBBLE", name, path });
-                std::cout << "  [✓] Loaded bubble: " << name
-                          << " (key: " << key << ")\n";
+                LOG_DEBUG("AssetManager") << "Loaded bubble: " << name << " (key: " << key << ")";
             } catch (const std::exception& e) {
-                std::cerr << "  [x] Failed: " << name << " - " << e.what() << "\n";
+                LOG_WARN("AssetManager") << "Failed: " << name << " - " << e.what();
             }
         }
     }
@@ -11,6 +11,8 @@
 //   - Automatic asset discovery from directories
 //   - Shared pointer management for textures (memory efficient)
 //   - Asset metadata tracking for UI display
+//   - Headless mode: records asset paths and decodes images on the CPU only,
+//     so offscreen renderers can run without an OpenGL context
 //
 // ASSET TYPES:
 //   - Textures: Character sprites, bubble images (png files)
@@ -29,6 +31,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <map>
 #include <vector>
@@ -38,6 +41,19 @@
 // Type alias for shared texture pointers (allows multiple sprites to share same texture)
 using TexturePtr = std::shared_ptr<sf::Texture>;
 
+// CPU-side decoded image (used by the software renderer, no GPU required)
+using ImagePtr = std::shared_ptr<sf::Image>;
+
+// Memory held by loaded assets (see MemoryStats.h)
+struct AssetMemoryUsage {
+    std::size_t textureBytes{0};   // GPU: width x height x 4 per texture
+    std::size_t textureCount{0};
+    std::size_t imageBytes{0};     // Decoded CPU copies
+    std::size_t imageCount{0};
+    std::size_t fontBytes{0};      // Font file sizes
+    std::size_t fontCount{0};
+};
+
 // Asset metadata structure for UI display and queries
 struct AssetInfo {
     std::string type;  // "CHARACTER", "FONT", or "BUBBLE"
@@ -50,10 +66,17 @@ private:
     std::map<std::string, TexturePtr> m_textures;  // Texture cache (key -> shared texture)
     std::map<std::string, sf::Font> m_fonts;       // Font cache (key -> font object)
     std::vector<AssetInfo> m_assetList;            // All loaded assets metadata
+    std::map<std::string, std::string> m_texturePaths;  // Texture key -> source file
+    std::map<std::string, std::string> m_fontPaths;     // Font key -> source file
+    std::map<std::string, ImagePtr> m_images;           // Lazily decoded CPU images
+    std::map<std::string, std::uint64_t> m_fileHashes;  // Source file -> content hash
+    bool m_headless{false};                             // Skip GPU texture creation
 
     // Private constructor for singleton pattern
     AssetManager() = default;
 
+    std::uint64_t hashAssetFile(const std::string& path);
+
 public:
     //-------------------------------------------------------------------------
     // SINGLETON ACCESS - Use this to get the single instance
@@ -85,6 +108,34 @@ public:
     // Get font by name (throws runtime_error if not found)
     sf::Font& getFont(const std::string& name);
 
+    //-------------------------------------------------------------------------
+    // HEADLESS / CPU ACCESS - Used by offscreen and software rendering
+    //-------------------------------------------------------------------------
+
+    // Enable before loading assets on machines without an OpenGL context.
+    // Textures are then only registered by path; use getImage() to read them.
+    void setHeadless(bool headless);
+    bool isHeadless() const;
+
+    // True if a texture with this key was registered (loaded or headless)
+    bool hasTexture(const std::string& name) const;
+
+    // Decoded CPU copy of a registered texture (loaded on first request,
+    // returns nullptr if the key is unknown or the file cannot be decoded)
+    ImagePtr getImage(const std::string& name);
+
+    // Source file of a registered texture/font (empty string if unknown)
+    std::string getTexturePath(const std::string& name) const;
+    std::string getFontPath(const std::string& name) const;
+
+    // Content hash of a registered texture/font file (hashed once, then
+    // memoized; 0 if the key is unknown). Used by the export cache.
+    std::uint64_t getTextureHash(const std::string& name);
+    std::uint64_t getFontHash(const std::string& name);
+
+    // Bytes held by textures, CPU images and fonts
+    AssetMemoryUsage getMemoryUsage() const;
+
     //-------------------------------------------------------------------------
     // AUTO-DISCOVERY - Automatically load all assets from directories
     //-------------------------------------------------------------------------
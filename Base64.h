@@ -0,0 +1,65 @@
+//=============================================================================
+// Base64.h
+//=============================================================================
+// PURPOSE:
+//   Base64 (RFC 4648, with padding) for binary data embedded in text files:
+//   images inlined into SVG exports and paint layer tiles in projects.
+//=============================================================================
+
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+inline std::string base64Encode(const std::string& bytes) {
+    static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve((bytes.size() + 2) / 3 * 4);
+    std::size_t i = 0;
+    for (; i + 2 < bytes.size(); i += 3) {
+        unsigned v = (static_cast<unsigned char>(bytes[i]) << 16) |
+                     (static_cast<unsigned char>(bytes[i + 1]) << 8) |
+                     static_cast<unsigned char>(bytes[i + 2]);
+        out += table[(v >> 18) & 63];
+        out += table[(v >> 12) & 63];
+        out += table[(v >> 6) & 63];
+        out += table[v & 63];
+    }
+    if (i < bytes.size()) {
+        unsigned v = static_cast<unsigned char>(bytes[i]) << 16;
+        if (i + 1 < bytes.size())
+            v |= static_cast<unsigned char>(bytes[i + 1]) << 8;
+        out += table[(v >> 18) & 63];
+        out += table[(v >> 12) & 63];
+        out += i + 1 < bytes.size() ? table[(v >> 6) & 63] : '=';
+        out += '=';
+    }
+    return out;
+}
+
+// Throws std::runtime_error on characters outside the alphabet
+inline std::string base64Decode(const std::string& text) {
+    auto value = [](char c) -> unsigned {
+        if (c >= 'A' && c <= 'Z') return static_cast<unsigned>(c - 'A');
+        if (c >= 'a' && c <= 'z') return static_cast<unsigned>(c - 'a' + 26);
+        if (c >= '0' && c <= '9') return static_cast<unsigned>(c - '0' + 52);
+        if (c == '+') return 62;
+        if (c == '/') return 63;
+        throw std::runtime_error("Invalid base64 data");
+    };
+
+    std::string out;
+    out.reserve(text.size() / 4 * 3);
+    unsigned bits = 0, count = 0;
+    for (char c : text) {
+        if (c == '=')
+            break;
+        bits = (bits << 6) | value(c);
+        count += 6;
+        if (count >= 8) {
+            count -= 8;
+            out += static_cast<char>((bits >> count) & 0xFF);
+        }
+    }
+    return out;
+}
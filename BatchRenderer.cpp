@@ -0,0 +1,482 @@
+//=============================================================================
+// BatchRenderer.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the sharded batch renderer (see BatchRenderer.h).
+//
+// NOTES:
+//   - Each worker owns one journal file, so records never interleave and a
+//     crash loses at most the page in flight.
+//   - Workers render single-threaded; parallelism comes from the processes.
+//   - Workers are started with spawnProcess() (Process.h).
+//=============================================================================
+
+#include "BatchRenderer.h"
+#include "ContentHash.h"
+#include "Exporter.h"
+#include "Process.h"
+#include "Scene.h"
+#include "SceneHash.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedMs(Clock::time_point since)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+    }
+
+    // Run ids are "<millisecond timestamp>-<pid>" (older journals: a plain
+    // timestamp in seconds). Compare the timestamps as decimal numbers:
+    // by length, then digits; the pid only breaks ties
+    bool isNewerRun(const std::string &a, const std::string &b)
+    {
+        const std::string ta = a.substr(0, a.find('-')), tb = b.substr(0, b.find('-'));
+        if (ta.size() != tb.size())
+            return ta.size() > tb.size();
+        return ta != tb ? ta > tb : a > b;
+    }
+
+    double percentile(std::vector<double> sorted, double p)
+    {
+        if (sorted.empty())
+            return 0.0;
+        std::size_t idx = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[std::min(idx, sorted.size() - 1)];
+    }
+}
+
+void configureExporter(Exporter &exporter, const BatchOptions &options)
+{
+    SvgOptions svg;
+    svg.embedImages = options.svgEmbed;
+
+    // No --format: exportScene() picks the format from the file extension
+    ImageFormat format;
+    if (options.format == "svg")
+        exporter.setVectorOutput(true, svg);
+    else if (parseImageFormat(options.format, format))
+        exporter.setFormat(format);
+    exporter.setCompressionLevel(options.pngLevel);
+    exporter.setJpegQuality(options.jpegQuality);
+    exporter.setPaletteColors(options.paletteColors);
+    DownscaleFilter filter = DownscaleFilter::Box;
+    parseDownscaleFilter(options.downscaleFilter, filter);
+    exporter.setSupersample(options.supersample, filter);
+}
+
+BatchRenderer::BatchRenderer(const BatchOptions &options) : m_options(options)
+{
+    // Pages have no output extension to pick a format from
+    if (m_options.format.empty())
+        m_options.format = "png";
+}
+
+std::string BatchRenderer::journalDir() const
+{
+    return m_options.outputDir + "/.journal";
+}
+
+std::string BatchRenderer::settingsHash() const
+{
+    std::ostringstream key;
+    key << m_options.format << " " << m_options.pngLevel << " " << m_options.jpegQuality << " "
+        << m_options.paletteColors << " " << m_options.svgEmbed << " " << m_options.supersample << " "
+        << m_options.downscaleFilter;
+    return toHex(fnv1a64(key.str()));
+}
+
+std::string BatchRenderer::outputPathFor(const std::string &project) const
+{
+    ImageFormat format = ImageFormat::Png;
+    parseImageFormat(m_options.format, format);
+    std::string ext = m_options.format == "svg" ? ".svg" : imageFormatExtension(format);
+
+    // Mirror the project's place below the manifest, so a/page1.comic and
+    // b/page1.comic do not share an output file
+    const fs::path absolute = fs::absolute(project).lexically_normal();
+    const fs::path manifestDir = fs::absolute(m_options.manifestPath).lexically_normal().parent_path();
+    fs::path relative = absolute.lexically_relative(manifestDir);
+    if (relative.empty() || *relative.begin() == "..")
+    {
+        // Outside the manifest's directory: stem plus a hash of the full path
+        relative = absolute.stem().string() + "_" + toHex(fnv1a64(absolute.generic_string())).substr(0, 8);
+    }
+    relative.replace_extension(ext);
+    return (fs::path(m_options.outputDir) / relative).generic_string();
+}
+
+std::vector<std::string> BatchRenderer::readManifest() const
+{
+    std::ifstream in(m_options.manifestPath);
+    if (!in)
+        throw std::runtime_error("Manifest open failed: " + m_options.manifestPath);
+
+    std::vector<std::string> projects;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        // Trim whitespace (manifests are often edited on Windows)
+        auto first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#')
+            continue;
+        auto last = line.find_last_not_of(" \t\r");
+        projects.push_back(line.substr(first, last - first + 1));
+    }
+    return projects;
+}
+
+std::vector<BatchRenderer::JournalEntry> BatchRenderer::readJournal() const
+{
+    std::vector<JournalEntry> entries;
+    if (!fs::exists(journalDir()))
+        return entries;
+
+    for (const auto &file : fs::directory_iterator(journalDir()))
+    {
+        if (file.path().extension() != ".log")
+            continue;
+        std::ifstream in(file.path());
+        std::string line;
+        while (std::getline(in, line))
+        {
+            std::istringstream ss(line);
+            std::string kind;
+            JournalEntry e;
+            ss >> kind >> e.runId;
+            if (kind == "DONE")
+            {
+                e.done = true;
+                ss >> e.contentHash >> e.depsHash >> e.settingsHash >> e.loadMs >> e.renderMs >> e.encodeMs >> std::quoted(e.project);
+            }
+            else if (kind == "FAIL")
+            {
+                ss >> std::quoted(e.project) >> std::quoted(e.error);
+            }
+            // A torn last line from a killed worker simply fails to parse
+            if (ss && !e.project.empty())
+                entries.push_back(e);
+        }
+    }
+    return entries;
+}
+
+int BatchRenderer::run()
+{
+    auto start = Clock::now();
+
+    std::vector<std::string> projects = readManifest();
+
+    // Two pages must never write the same file (or journal entry)
+    std::map<std::string, std::string> outputs;
+    bool duplicates = false;
+    for (const auto &p : projects)
+    {
+        auto [it, added] = outputs.emplace(outputPathFor(p), p);
+        if (!added)
+        {
+            std::cerr << "[Batch] " << std::quoted(p) << " and " << std::quoted(it->second)
+                      << " both render to " << it->first << "\n";
+            duplicates = true;
+        }
+    }
+    if (duplicates)
+    {
+        std::cerr << "[Batch] Duplicate output names in " << m_options.manifestPath << "; nothing rendered\n";
+        return 1;
+    }
+
+    fs::create_directories(journalDir());
+
+    // Latest successful render of every page (run ids increase over time)
+    std::map<std::string, JournalEntry> lastDone;
+    if (!m_options.force)
+    {
+        for (const auto &e : readJournal())
+        {
+            if (!e.done)
+                continue;
+            auto it = lastDone.find(e.project);
+            if (it == lastDone.end() || !isNewerRun(it->second.runId, e.runId))
+                lastDone[e.project] = e;
+        }
+    }
+
+    // Fingerprint every page. Asset files are shared by many pages, so
+    // each one is hashed once (asset path -> hash).
+    std::map<std::string, std::uint64_t> assetHashes;
+    std::vector<PageJob> pending;
+    const std::string settings = settingsHash();
+    std::size_t fresh = 0, contentChanged = 0, assetsChanged = 0, settingsChanged = 0, outputMissing = 0;
+    for (const auto &p : projects)
+    {
+        PageJob job;
+        job.project = p;
+        job.contentHash = toHex(hashFile(p));
+
+        std::uint64_t deps = FnvOffsetBasis;
+        try
+        {
+            for (const auto &ref : readProjectAssets(p))
+            {
+                auto it = assetHashes.find(ref.path);
+                if (it == assetHashes.end())
+                    it = assetHashes.emplace(ref.path, hashFile(ref.path)).first;
+                deps = fnv1a64(ref.kind + ":" + ref.key + ":" + ref.path, deps);
+                deps = fnv1a64(&it->second, sizeof(it->second), deps);
+            }
+        }
+        catch (const std::exception &)
+        {
+            // Unreadable project: let the worker report the error
+        }
+        job.depsHash = toHex(deps);
+
+        auto last = lastDone.find(p);
+        if (last == lastDone.end())
+            ++fresh;
+        else if (last->second.contentHash != job.contentHash)
+            ++contentChanged;
+        else if (last->second.depsHash != job.depsHash)
+            ++assetsChanged;
+        else if (last->second.settingsHash != settings)
+            ++settingsChanged;
+        else if (!fs::exists(outputPathFor(p)))
+            ++outputMissing;
+        else
+            continue;
+        pending.push_back(job);
+    }
+
+    std::size_t skipped = projects.size() - pending.size();
+    std::cout << "[Batch] " << projects.size() << " pages in manifest, "
+              << skipped << " up to date, " << pending.size() << " to render ("
+              << fresh << " new, " << contentChanged << " edited, "
+              << assetsChanged << " with changed assets, " << settingsChanged
+              << " with changed export settings, " << outputMissing << " with missing output; "
+              << assetHashes.size() << " assets hashed)\n";
+    if (pending.empty())
+        return 0;
+
+    unsigned jobs = m_options.jobs ? m_options.jobs : std::max(1u, std::thread::hardware_concurrency());
+    jobs = std::min<unsigned>(jobs, static_cast<unsigned>(pending.size()));
+
+    // Round-robin sharding keeps large and small projects spread out
+    // Milliseconds plus pid: two runs started together still get distinct ids
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    std::string runId = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(now).count()) + "-" +
+                        std::to_string(currentProcessId());
+    std::vector<ProcessHandle> workers;
+    std::string exe = selfExecutable(m_options.executable);
+    for (unsigned k = 0; k < jobs; ++k)
+    {
+        std::string listPath = journalDir() + "/shard_" + std::to_string(k) + ".todo";
+        {
+            std::ofstream list(listPath);
+            for (std::size_t i = k; i < pending.size(); i += jobs)
+                list << pending[i].contentHash << " " << pending[i].depsHash << " "
+                     << std::quoted(pending[i].project) << "\n";
+        }
+
+        std::vector<std::string> args = {
+            exe, "--batch-worker", m_options.manifestPath,
+            "--out", m_options.outputDir,
+            "--shard", std::to_string(k),
+            "--shard-list", listPath,
+            "--run-id", runId,
+            "--format", m_options.format,
+            "--png-level", std::to_string(m_options.pngLevel),
+            "--quality", std::to_string(m_options.jpegQuality),
+            "--colors", std::to_string(m_options.paletteColors),
+            "--supersample", std::to_string(m_options.supersample),
+            "--downscale", m_options.downscaleFilter};
+        if (!m_options.useCache)
+            args.push_back("--no-cache");
+        if (m_options.svgEmbed)
+            args.push_back("--svg-embed");
+
+        ProcessHandle handle{};
+        if (!spawnProcess(args, handle))
+        {
+            std::cerr << "[Batch] Failed to start worker " << k << "\n";
+            continue;
+        }
+        workers.push_back(handle);
+    }
+    std::cout << "[Batch] Started " << workers.size() << " worker processes (run " << runId << ")\n";
+
+    int failedWorkers = 0;
+    for (auto handle : workers)
+        if (waitProcess(handle) != 0)
+            ++failedWorkers;
+
+    m_options.runId = runId;
+    report(std::chrono::duration<double>(Clock::now() - start).count(), skipped);
+
+    if (workers.size() != jobs || failedWorkers > 0)
+    {
+        std::cerr << "[Batch] " << failedWorkers << " worker(s) reported failures; rerun to retry\n";
+        return 1;
+    }
+    return 0;
+}
+
+int BatchRenderer::runWorker()
+{
+    std::ifstream list(m_options.shardList);
+    if (!list)
+    {
+        std::cerr << "[Batch] Shard list missing: " << m_options.shardList << "\n";
+        return 1;
+    }
+
+    fs::create_directories(m_options.outputDir);
+    std::ofstream journal(journalDir() + "/shard_" + std::to_string(m_options.shard) + ".log",
+                          std::ios::app);
+
+    // One process per core already: keep the rasterizer single-threaded
+    Exporter exporter(RenderBackend::Software, 1);
+    configureExporter(exporter, m_options);
+    ExportCache cache(m_options.outputDir + "/.cache");
+    if (m_options.useCache)
+        exporter.setCache(&cache);
+    const std::string settings = settingsHash();
+    int failures = 0;
+    int cacheHits = 0;
+
+    std::string line;
+    while (std::getline(list, line))
+    {
+        std::istringstream ss(line);
+        PageJob job;
+        if (!(ss >> job.contentHash >> job.depsHash >> std::quoted(job.project)))
+            continue;
+        const std::string &project = job.project;
+        try
+        {
+            auto t0 = Clock::now();
+            Scene scene;
+            ProjectCanvas canvas = loadProject(project, scene);
+            double loadMs = elapsedMs(t0);
+
+            // Cache lookup counts as encode time (it writes the output file)
+            const std::string outputPath = outputPathFor(project);
+            fs::create_directories(fs::path(outputPath).parent_path());
+            std::uint64_t key = 0;
+            double renderMs = 0.0, encodeMs = 0.0;
+            auto t1 = Clock::now();
+            if (m_options.useCache)
+                key = exporter.cacheKey(SceneHasher().hash(scene), canvas, nullptr, outputPath);
+
+            if (key != 0 && cache.fetch(key, outputPath))
+            {
+                encodeMs = elapsedMs(t1);
+                ++cacheHits;
+            }
+            else if (exporter.isVectorOutput())
+            {
+                // SVG has no raster step: all time counts as encoding
+                if (!exporter.exportScene(scene, canvas, nullptr, outputPath))
+                    throw std::runtime_error("SVG write failed: " + outputPath);
+                encodeMs = elapsedMs(t1);
+                if (key != 0)
+                    cache.store(key, outputPath);
+            }
+            else
+            {
+                sf::Image image;
+                if (!exporter.render(scene, canvas, nullptr, image))
+                    throw std::runtime_error("empty canvas");
+                renderMs = elapsedMs(t1);
+
+                auto t2 = Clock::now();
+                if (!exporter.save(image, outputPath))
+                    throw std::runtime_error("encode failed: " + outputPath);
+                encodeMs = elapsedMs(t2);
+                if (key != 0)
+                    cache.store(key, outputPath);
+            }
+
+            journal << "DONE " << m_options.runId << " " << job.contentHash << " "
+                    << job.depsHash << " " << settings << " " << std::fixed << std::setprecision(3)
+                    << loadMs << " " << renderMs << " " << encodeMs << " "
+                    << std::quoted(project) << std::endl;
+        }
+        catch (const std::exception &e)
+        {
+            ++failures;
+            std::cerr << "[Batch] " << project << ": " << e.what() << "\n";
+            journal << "FAIL " << m_options.runId << " " << std::quoted(project) << " "
+                    << std::quoted(std::string(e.what())) << std::endl;
+        }
+    }
+    if (cacheHits > 0)
+        std::cout << "[Batch] Worker " << m_options.shard << ": " << cacheHits
+                  << " pages copied from the export cache\n";
+    return failures == 0 ? 0 : 1;
+}
+
+void BatchRenderer::report(double wallSeconds, std::size_t skipped) const
+{
+    std::vector<JournalEntry> thisRun;
+    for (const auto &e : readJournal())
+        if (e.runId == m_options.runId)
+            thisRun.push_back(e);
+
+    std::vector<double> totals;
+    std::vector<std::pair<double, std::string>> slowest;
+    double loadSum = 0.0, renderSum = 0.0, encodeSum = 0.0;
+    std::size_t failed = 0;
+    for (const auto &e : thisRun)
+    {
+        if (!e.done)
+        {
+            ++failed;
+            continue;
+        }
+        double total = e.loadMs + e.renderMs + e.encodeMs;
+        totals.push_back(total);
+        slowest.push_back({total, e.project});
+        loadSum += e.loadMs;
+        renderSum += e.renderMs;
+        encodeSum += e.encodeMs;
+    }
+    std::sort(totals.begin(), totals.end());
+    std::sort(slowest.rbegin(), slowest.rend());
+
+    const std::size_t rendered = totals.size();
+    const double n = rendered ? static_cast<double>(rendered) : 1.0;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\n[Batch] ===== Report =====\n";
+    std::cout << "  Rendered:   " << rendered << " pages (" << failed << " failed, "
+              << skipped << " up to date)\n";
+    std::cout << "  Wall time:  " << wallSeconds << " s\n";
+    std::cout << "  Throughput: " << (wallSeconds > 0.0 ? static_cast<double>(rendered) / wallSeconds : 0.0)
+              << " pages/s\n";
+    if (rendered == 0)
+        return;
+    std::cout << "  Per page (ms): min " << totals.front()
+              << ", median " << percentile(totals, 0.5)
+              << ", p95 " << percentile(totals, 0.95)
+              << ", max " << totals.back() << "\n";
+    std::cout << "  Mean split (ms): load " << loadSum / n
+              << ", render " << renderSum / n
+              << ", encode " << encodeSum / n << "\n";
+    std::cout << "  Slowest pages:\n";
+    for (std::size_t i = 0; i < std::min<std::size_t>(5, slowest.size()); ++i)
+        std::cout << "    " << slowest[i].first << " ms  " << slowest[i].second << "\n";
+}
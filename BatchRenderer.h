@@ -0,0 +1,131 @@
+//=============================================================================
+// BatchRenderer.h
+//=============================================================================
+// PURPOSE:
+//   Re-renders archives of project files (*.comic) headlessly. A driver
+//   process shards the manifest across N worker processes (one per core by
+//   default); each worker renders with the CPU SoftwareRenderer and encodes
+//   its pages through the shared Exporter pipeline.
+//
+// MANIFEST:
+//   Plain text, one project path per line. Empty lines and lines starting
+//   with '#' are ignored.
+//
+// OUTPUT NAMES:
+//   <outputDir>/<project path relative to the manifest>.<ext>, e.g.
+//   a/page1.comic -> <outputDir>/a/page1.png. Projects outside the
+//   manifest's directory become <stem>_<path hash>.<ext>. A manifest whose
+//   pages would share an output file is rejected before anything renders.
+//
+// RESUMABLE JOURNAL:
+//   <outputDir>/.journal/shard_<k>.log, appended and flushed per page:
+//     DONE <runId> <contentHash> <depsHash> <settingsHash> <loadMs> <renderMs> <encodeMs> "<project>"
+//     FAIL <runId> "<project>" "<error>"
+//   FAIL pages are retried on the next run. runId is
+//   <millisecond timestamp>-<driver pid>.
+//
+// INCREMENTAL RE-RENDER:
+//   contentHash is the hash of the project file, depsHash combines the
+//   current hashes of every asset the project references (its ASSET
+//   records), settingsHash covers the export settings (format, PNG level,
+//   quality, colors, SVG image embedding, supersample, downscale filter).
+//   A page is skipped when its latest DONE record matches all three and its
+//   output file still exists, so an interrupted batch resumes and a changed
+//   character PNG or font only re-renders the pages that use it. Each asset
+//   file is hashed once per run no matter how many pages depend on it.
+//   Records written before settingsHash existed no longer parse, so those
+//   pages render once.
+//
+// EXPORT CACHE:
+//   Pages that do get rendered (new, edited, --force) are first looked up
+//   by scene hash in <outputDir>/.cache (ExportCache.h), so identical pages
+//   across projects and forced re-runs are copied instead of re-rendered.
+//   Disable with --no-cache.
+//
+// USAGE:
+//   ComicStripMaker --batch manifest.txt [--jobs N] [--out DIR] [--force] [--no-cache]
+//                   [--format png|png8|qoi|jpg|svg] [--png-level L] [--quality Q]
+//                   [--colors N] [--svg-embed]
+//                   [--supersample N] [--downscale box|lanczos]
+//   (workers are spawned internally with --batch-worker)
+//
+// WHERE TO MODIFY:
+//   - Output naming: Modify BatchRenderer::outputPathFor()
+//   - Report contents: Modify BatchRenderer::report()
+//=============================================================================
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+class Exporter;
+
+struct BatchOptions {
+    std::string manifestPath;                       // Manifest of project files
+    std::string outputDir{"SavedComics/Batch"};     // Rendered pages + journal
+    unsigned jobs{0};                               // Worker processes (0 = one per core)
+    std::string executable;                         // This program (used to spawn workers)
+    bool force{false};                              // Ignore the journal, render everything
+    bool useCache{true};                            // Reuse identical exports (ExportCache.h)
+    std::string format;                             // Output format (see ImageEncoder.h); empty =
+                                                    // by file extension (batch pages: png)
+    int pngLevel{6};                                // PNG compression level (0..9)
+    int jpegQuality{90};                            // JPEG quality (1..100)
+    unsigned paletteColors{256};                    // png8 palette size (2..256)
+    bool svgEmbed{false};                           // svg: embed images instead of linking
+    unsigned supersample{1};                        // Antialiasing factor (see Exporter.h)
+    std::string downscaleFilter{"box"};             // box / lanczos
+
+    // Worker-only (filled in by the driver on the worker command line)
+    unsigned shard{0};                              // Index of this worker
+    std::string shardList;                          // File listing this worker's pages
+    std::string runId;                              // Tags journal records of one run
+};
+
+// Applies the export settings of options to exporter. Shared by the batch
+// workers and the single-page/strip exports, so both honor the same flags
+void configureExporter(Exporter& exporter, const BatchOptions& options);
+
+class BatchRenderer {
+public:
+    explicit BatchRenderer(const BatchOptions& options);
+
+    // Driver: shard pending pages, spawn workers, wait, report.
+    // Returns 0 if every page rendered, 1 otherwise.
+    int run();
+
+    // Worker: render the pages listed in options.shardList.
+    // Requires assets to be loaded (headless) before calling.
+    int runWorker();
+
+private:
+    struct JournalEntry {
+        bool done{false};
+        std::string runId;
+        std::string project;
+        std::string contentHash;
+        std::string depsHash;
+        std::string settingsHash;
+        double loadMs{0.0};
+        double renderMs{0.0};
+        double encodeMs{0.0};
+        std::string error;
+    };
+
+    // A page of the manifest with its current fingerprint
+    struct PageJob {
+        std::string project;
+        std::string contentHash;
+        std::string depsHash;
+    };
+
+    std::vector<std::string> readManifest() const;
+    std::vector<JournalEntry> readJournal() const;
+    std::string journalDir() const;
+    std::string settingsHash() const;
+    std::string outputPathFor(const std::string& project) const;
+    void report(double wallSeconds, std::size_t skipped) const;
+
+    BatchOptions m_options;
+};
@@ -0,0 +1,383 @@
+//=============================================================================
+// Benchmark.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the microbenchmark harness (see Benchmark.h).
+//=============================================================================
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cmath>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double secondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    double timeBatch(const std::function<void()> &op, std::uint64_t ops)
+    {
+        auto start = Clock::now();
+        for (std::uint64_t i = 0; i < ops; ++i)
+            op();
+        return secondsSince(start);
+    }
+
+    // Nearest-rank percentile of sorted samples
+    double percentile(const std::vector<double> &sorted, double p)
+    {
+        std::size_t rank = static_cast<std::size_t>(std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+        return sorted[std::min(sorted.size(), std::max<std::size_t>(rank, 1)) - 1];
+    }
+
+    std::string jsonString(const std::string &s)
+    {
+        std::ostringstream out;
+        out << '"';
+        for (char c : s)
+        {
+            if (c == '"' || c == '\\')
+                out << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20)
+                out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec;
+            else
+                out << c;
+        }
+        out << '"';
+        return out.str();
+    }
+
+    //-------------------------------------------------------------------------
+    // JSON READING (just enough for the files written below)
+    //-------------------------------------------------------------------------
+
+    struct JsonValue
+    {
+        enum class Type { Null, Bool, Number, String, Array, Object } type{Type::Null};
+        double number{0.0};
+        std::string string;
+        std::vector<JsonValue> array;
+        std::vector<std::pair<std::string, JsonValue>> object;
+
+        const JsonValue *get(const std::string &key) const
+        {
+            for (const auto &member : object)
+                if (member.first == key)
+                    return &member.second;
+            return nullptr;
+        }
+
+        double numberAt(const std::string &key) const
+        {
+            const JsonValue *v = get(key);
+            return v && v->type == Type::Number ? v->number : 0.0;
+        }
+
+        std::string stringAt(const std::string &key) const
+        {
+            const JsonValue *v = get(key);
+            return v && v->type == Type::String ? v->string : std::string();
+        }
+    };
+
+    class JsonParser
+    {
+    public:
+        explicit JsonParser(const std::string &text) : m_text(text) {}
+
+        JsonValue parseDocument()
+        {
+            JsonValue v = parseValue();
+            skipSpace();
+            if (m_pos != m_text.size())
+                fail("trailing characters");
+            return v;
+        }
+
+    private:
+        [[noreturn]] void fail(const std::string &what) const
+        {
+            throw std::runtime_error("JSON parse error at offset " + std::to_string(m_pos) + ": " + what);
+        }
+
+        void skipSpace()
+        {
+            while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos])))
+                ++m_pos;
+        }
+
+        bool consume(char c)
+        {
+            skipSpace();
+            if (m_pos < m_text.size() && m_text[m_pos] == c)
+            {
+                ++m_pos;
+                return true;
+            }
+            return false;
+        }
+
+        void expect(char c)
+        {
+            if (!consume(c))
+                fail(std::string("expected '") + c + "'");
+        }
+
+        std::string parseString()
+        {
+            expect('"');
+            std::string s;
+            while (m_pos < m_text.size() && m_text[m_pos] != '"')
+            {
+                char c = m_text[m_pos++];
+                if (c == '\\' && m_pos < m_text.size())
+                {
+                    char e = m_text[m_pos++];
+                    if (e == 'u' && m_pos + 4 <= m_text.size())
+                    {
+                        s += static_cast<char>(std::stoi(m_text.substr(m_pos, 4), nullptr, 16)); // ASCII only
+                        m_pos += 4;
+                    }
+                    else
+                        s += e == 'n' ? '\n' : e == 't' ? '\t' : e;
+                }
+                else
+                    s += c;
+            }
+            expect('"');
+            return s;
+        }
+
+        JsonValue parseValue()
+        {
+            skipSpace();
+            if (m_pos >= m_text.size())
+                fail("unexpected end");
+
+            JsonValue v;
+            const char c = m_text[m_pos];
+            if (c == '{')
+            {
+                ++m_pos;
+                v.type = JsonValue::Type::Object;
+                if (consume('}'))
+                    return v;
+                do
+                {
+                    skipSpace();
+                    std::string key = parseString();
+                    expect(':');
+                    v.object.emplace_back(std::move(key), parseValue());
+                } while (consume(','));
+                expect('}');
+            }
+            else if (c == '[')
+            {
+                ++m_pos;
+                v.type = JsonValue::Type::Array;
+                if (consume(']'))
+                    return v;
+                do
+                    v.array.push_back(parseValue());
+                while (consume(','));
+                expect(']');
+            }
+            else if (c == '"')
+            {
+                v.type = JsonValue::Type::String;
+                v.string = parseString();
+            }
+            else if (m_text.compare(m_pos, 4, "true") == 0 || m_text.compare(m_pos, 5, "false") == 0)
+            {
+                v.type = JsonValue::Type::Bool;
+                v.number = c == 't' ? 1.0 : 0.0;
+                m_pos += c == 't' ? 4 : 5;
+            }
+            else if (m_text.compare(m_pos, 4, "null") == 0)
+            {
+                m_pos += 4;
+            }
+            else
+            {
+                std::size_t used = 0;
+                try
+                {
+                    v.number = std::stod(m_text.substr(m_pos, 32), &used);
+                }
+                catch (const std::exception &)
+                {
+                    fail("bad value");
+                }
+                v.type = JsonValue::Type::Number;
+                m_pos += used;
+            }
+            return v;
+        }
+
+        const std::string &m_text;
+        std::size_t m_pos{0};
+    };
+}
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkOptions &options) : m_options(options)
+{
+    m_options.samples = std::max<std::size_t>(1, m_options.samples);
+}
+
+void BenchmarkRunner::add(BenchmarkCase benchmark) { m_cases.push_back(std::move(benchmark)); }
+
+bool BenchmarkRunner::matches(const std::string &name) const
+{
+    return m_options.filter.empty() || name.find(m_options.filter) != std::string::npos;
+}
+
+std::vector<std::string> BenchmarkRunner::list() const
+{
+    std::vector<std::string> names;
+    for (const auto &c : m_cases)
+        if (matches(c.name))
+            names.push_back(c.name);
+    return names;
+}
+
+std::vector<BenchmarkResult> BenchmarkRunner::run(std::ostream &log) const
+{
+    std::vector<BenchmarkResult> results;
+    for (const auto &c : m_cases)
+    {
+        if (!matches(c.name))
+            continue;
+        BenchmarkResult r = measure(c, m_options);
+        log << "[Bench] " << std::left << std::setw(36) << r.name << std::right << std::fixed
+            << std::setprecision(1) << std::setw(14) << r.medianNs << " ns/op  (+/- " << std::setprecision(1)
+            << (r.medianNs > 0.0 ? 100.0 * r.stddevNs / r.medianNs : 0.0) << "%)  " << std::setprecision(3)
+            << r.itemsPerSecond / 1e6 << " M" << r.unit << "/s" << std::endl;
+        results.push_back(r);
+    }
+    return results;
+}
+
+BenchmarkResult BenchmarkRunner::measure(const BenchmarkCase &benchmark, const BenchmarkOptions &options)
+{
+    std::function<void()> op = benchmark.setup();
+
+    // Warm-up (first-touch allocations, caches), then grow the batch until
+    // a sample is long enough for the clock resolution not to matter
+    op();
+    std::uint64_t ops = 1;
+    while (timeBatch(op, ops) < options.minSampleSeconds && ops < (std::uint64_t(1) << 40))
+        ops *= 2;
+
+    std::vector<double> ns;
+    for (std::size_t s = 0; s < options.samples; ++s)
+        ns.push_back(timeBatch(op, ops) * 1e9 / static_cast<double>(ops));
+    return summarizeSamples(benchmark.name, benchmark.unit, benchmark.itemsPerOp, ops, std::move(ns));
+}
+
+BenchmarkResult summarizeSamples(const std::string &name, const std::string &unit, double itemsPerOp,
+                                 std::uint64_t ops, std::vector<double> ns)
+{
+    BenchmarkResult r;
+    r.name = name;
+    r.unit = unit;
+    r.ops = ops;
+    r.samples = ns.size();
+    if (ns.empty())
+        return r;
+
+    std::sort(ns.begin(), ns.end());
+    const std::size_t n = ns.size();
+    r.medianNs = n % 2 ? ns[n / 2] : (ns[n / 2 - 1] + ns[n / 2]) / 2.0;
+    r.minNs = ns.front();
+    r.maxNs = ns.back();
+    r.p95Ns = percentile(ns, 95.0);
+    r.p99Ns = percentile(ns, 99.0);
+    double sum = 0.0;
+    for (double v : ns)
+        sum += v;
+    r.meanNs = sum / static_cast<double>(n);
+    double var = 0.0;
+    for (double v : ns)
+        var += (v - r.meanNs) * (v - r.meanNs);
+    r.stddevNs = n > 1 ? std::sqrt(var / static_cast<double>(n - 1)) : 0.0;
+    r.itemsPerSecond = r.medianNs > 0.0 ? itemsPerOp * 1e9 / r.medianNs : 0.0;
+    return r;
+}
+
+void writeBenchmarkJson(std::ostream &out, const std::vector<BenchmarkResult> &results,
+                        const BenchmarkThresholds &thresholds)
+{
+    out << std::setprecision(6) << std::defaultfloat;
+    out << "{\n  \"schema\": 1,\n  \"threads\": " << std::thread::hardware_concurrency() << ",\n";
+    if (!thresholds.empty())
+    {
+        out << "  \"thresholds\": {";
+        for (std::size_t i = 0; i < thresholds.size(); ++i)
+            out << (i ? ", " : " ") << jsonString(thresholds[i].first) << ": " << thresholds[i].second;
+        out << " },\n";
+    }
+    out << "  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchmarkResult &r = results[i];
+        out << (i ? "," : "") << "\n    { \"name\": " << jsonString(r.name) << ", \"unit\": " << jsonString(r.unit)
+            << ", \"ops\": " << r.ops << ", \"samples\": " << r.samples << ",\n      \"ns_per_op\": { \"median\": "
+            << r.medianNs << ", \"min\": " << r.minNs << ", \"mean\": " << r.meanNs << ", \"max\": " << r.maxNs
+            << ", \"p95\": " << r.p95Ns << ", \"p99\": " << r.p99Ns << ", \"stddev\": " << r.stddevNs
+            << " },\n      \"items_per_second\": " << r.itemsPerSecond << " }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+std::vector<BenchmarkResult> readBenchmarkJson(std::istream &in, BenchmarkThresholds *thresholds)
+{
+    const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    const JsonValue doc = JsonParser(text).parseDocument();
+    if (doc.type != JsonValue::Type::Object || doc.numberAt("schema") != 1.0)
+        throw std::runtime_error("Not a benchmark results file (schema 1)");
+
+    if (thresholds)
+    {
+        thresholds->clear();
+        if (const JsonValue *t = doc.get("thresholds"))
+            for (const auto &member : t->object)
+                thresholds->emplace_back(member.first, member.second.number);
+    }
+
+    std::vector<BenchmarkResult> results;
+    if (const JsonValue *list = doc.get("results"))
+    {
+        for (const auto &item : list->array)
+        {
+            BenchmarkResult r;
+            r.name = item.stringAt("name");
+            r.unit = item.stringAt("unit");
+            r.ops = static_cast<std::uint64_t>(item.numberAt("ops"));
+            r.samples = static_cast<std::size_t>(item.numberAt("samples"));
+            if (const JsonValue *ns = item.get("ns_per_op"))
+            {
+                r.medianNs = ns->numberAt("median");
+                r.minNs = ns->numberAt("min");
+                r.meanNs = ns->numberAt("mean");
+                r.maxNs = ns->numberAt("max");
+                r.p95Ns = ns->numberAt("p95");
+                r.p99Ns = ns->numberAt("p99");
+                r.stddevNs = ns->numberAt("stddev");
+            }
+            r.itemsPerSecond = item.numberAt("items_per_second");
+            results.push_back(r);
+        }
+    }
+    return results;
+}
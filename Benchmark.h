@@ -0,0 +1,112 @@
+//=============================================================================
+// Benchmark.h
+//=============================================================================
+// PURPOSE:
+//   Minimal microbenchmark harness for the ComicBenchmarks executable
+//   (BenchmarkMain.cpp). Times editor hot paths and writes the results as
+//   JSON so runs can be compared before and after a change.
+//
+// HOW A CASE IS TIMED:
+//   1. setup() builds the fixture (untimed) and returns the operation
+//   2. One warm-up call, then the batch size is doubled until one batch
+//      takes at least `minSampleSeconds`
+//   3. `samples` batches are timed; each gives one ns-per-op sample
+//   4. Reported: median / min / mean / max / p95 / p99 / stddev of the
+//      samples and the throughput at the median (itemsPerOp items per op)
+//
+// JSON OUTPUT:
+//   { "schema": 1, "threads": N, "results": [ { "name": "...",
+//     "unit": "...", "ops": N, "samples": N, "ns_per_op": { "median": ..,
+//     "min": .., "mean": .., "max": .., "p95": .., "p99": .., "stddev": .. },
+//     "items_per_second": .. }, ... ] }
+//   Baselines of the performance gate add "thresholds": { "prefix": ratio }.
+//
+// WHERE TO MODIFY:
+//   - New benchmarks: Register them in BenchmarkMain.cpp
+//   - Statistics: Modify summarizeSamples() in Benchmark.cpp
+//=============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct BenchmarkCase {
+    std::string name;                         // "suite/case", used by --filter
+    double itemsPerOp{1.0};                   // Work items done by one op
+    std::string unit{"ops"};                  // What an item is ("points", "bytes", ...)
+    std::function<std::function<void()>()> setup;  // Untimed; returns the timed op
+};
+
+struct BenchmarkResult {
+    std::string name;
+    std::string unit;
+    std::uint64_t ops{0};                     // Ops per sample
+    std::size_t samples{0};
+    double medianNs{0.0};                     // Per op
+    double minNs{0.0};
+    double meanNs{0.0};
+    double maxNs{0.0};
+    double p95Ns{0.0};
+    double p99Ns{0.0};
+    double stddevNs{0.0};
+    double itemsPerSecond{0.0};               // At the median
+};
+
+struct BenchmarkOptions {
+    std::size_t samples{10};
+    double minSampleSeconds{0.02};
+    std::string filter;                       // Substring of the case name ("" = all)
+};
+
+class BenchmarkRunner {
+public:
+    explicit BenchmarkRunner(const BenchmarkOptions& options = BenchmarkOptions());
+
+    void add(BenchmarkCase benchmark);
+
+    // Names of the registered cases that match the filter
+    std::vector<std::string> list() const;
+
+    // Run every matching case; prints one progress line per case to `log`
+    std::vector<BenchmarkResult> run(std::ostream& log) const;
+
+    static BenchmarkResult measure(const BenchmarkCase& benchmark, const BenchmarkOptions& options);
+
+private:
+    bool matches(const std::string& name) const;
+
+    BenchmarkOptions m_options;
+    std::vector<BenchmarkCase> m_cases;
+};
+
+// Statistics of raw per-op samples (also used for replay latencies)
+BenchmarkResult summarizeSamples(const std::string& name, const std::string& unit, double itemsPerOp,
+                                 std::uint64_t ops, std::vector<double> nsPerOp);
+
+// Per-metric regression limits of a baseline file (see PerfGate.h):
+// name prefix -> allowed slowdown ratio, "default" for everything else
+using BenchmarkThresholds = std::vector<std::pair<std::string, double>>;
+
+void writeBenchmarkJson(std::ostream& out, const std::vector<BenchmarkResult>& results,
+                        const BenchmarkThresholds& thresholds = {});
+
+// Parse a file written by writeBenchmarkJson(). Throws runtime_error.
+std::vector<BenchmarkResult> readBenchmarkJson(std::istream& in, BenchmarkThresholds* thresholds = nullptr);
+
+// Keeps the optimizer from deleting work whose result is unused
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
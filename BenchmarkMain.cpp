@@ -0,0 +1,489 @@
+//=============================================================================
+// BenchmarkMain.cpp
+//=============================================================================
+// PURPOSE:
+//   Entry point of the ComicBenchmarks executable: microbenchmarks for the
+//   editor's hot paths, results as JSON (see Benchmark.h for the method).
+//   Built separately from the editor (README: "Benchmarks").
+//
+// SUITES:
+//   text/      SpeechBubble::setText -> wrapText at several text lengths
+//   stroke/    BrushStroke::addPoint, BrushStroke::draw (--window only)
+//   hit/       Topmost-first isClicked scans over 1k..100k-object scenes
+//   commands/  CommandManager execute / undo / redo
+//   assets/    AssetManager texture and font loading
+//   render/    SoftwareRenderer over a stroke-heavy page
+//   encode/    Every export encoder on one rendered page
+//   downscale/ Supersampling filters (Downscaler.h)
+//
+// COMMAND LINE:
+//   --out FILE        Write the JSON there (default: stdout)
+//   --filter TEXT     Only cases whose name contains TEXT
+//   --samples N       Timed samples per case (default 10)
+//   --min-time SEC    Minimum duration of one sample (default 0.02)
+//   --window          Open a hidden window: GPU text measuring and the
+//                     BrushStroke::draw case (default: headless, CPU only)
+//   --list            Print the case names and exit
+//   --gate FILE       Regression gate against a baseline (PerfGate.h):
+//                     prints a report, exit code 1 on a regression
+//   --runs N          Gate repetitions (default 5)
+//   --scenario F.rec  Also replay a recorded session (repeatable)
+//   --app PATH        Editor used for scenarios (default: ComicStripMaker
+//                     next to this executable)
+//   --update-baseline Write the gate's results as the new baseline
+//
+// NOTES:
+//   - Progress lines go to stderr so stdout stays valid JSON
+//   - Scenes come from SceneGenerator with a fixed seed: runs are comparable
+//=============================================================================
+
+#include <SFML/Graphics.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "AssetManager.h"
+#include "Benchmark.h"
+#include "Command.h"
+#include "Downscaler.h"
+#include "Logger.h"
+#include "ImageEncoder.h"
+#include "PerfGate.h"
+#include "Process.h"
+#include "Scene.h"
+#include "SceneGenerator.h"
+#include "SoftwareRenderer.h"
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    std::string assetRoot()
+    {
+        return fs::exists("assets") ? "assets" : "Assets";
+    }
+
+    std::vector<std::string> filesIn(const std::string &dir)
+    {
+        std::vector<std::string> files;
+        if (fs::exists(dir))
+            for (const auto &entry : fs::directory_iterator(dir))
+                if (entry.is_regular_file())
+                    files.push_back(entry.path().string());
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+    // Deterministic dialogue-like text of `length` characters
+    std::string sampleText(std::size_t length)
+    {
+        static const char *words[] = {"Wait", "what", "is", "that", "thing", "over", "there", "?!", "We",
+                                      "have", "to", "go", "now", "before", "the", "villain", "escapes"};
+        std::string text;
+        for (std::size_t i = 0; text.size() < length; ++i)
+        {
+            if (!text.empty())
+                text += ' ';
+            text += words[(i * 7) % (sizeof(words) / sizeof(words[0]))];
+        }
+        text.resize(length);
+        return text;
+    }
+
+    // Wavy hand-drawn-like path: `points` samples, a few pixels apart
+    std::vector<sf::Vector2f> strokePath(std::mt19937 &rng, std::size_t points, sf::Vector2f area)
+    {
+        std::uniform_real_distribution<float> ux(0.f, area.x), uy(0.f, area.y), angle(0.f, 6.2831853f);
+        std::vector<sf::Vector2f> path;
+        sf::Vector2f p(ux(rng), uy(rng));
+        float heading = angle(rng);
+        for (std::size_t i = 0; i < points; ++i)
+        {
+            heading += std::sin(static_cast<float>(i) * 0.15f) * 0.2f;
+            p += sf::Vector2f(std::cos(heading), std::sin(heading)) * 3.f;
+            path.push_back(p);
+        }
+        return path;
+    }
+
+    // Synthetic page (SceneGenerator.h): 70% strokes, 20% characters,
+    // 10% bubbles, same objects on every run
+    std::shared_ptr<Scene> makeScene(std::size_t objects, sf::Vector2u area, unsigned strokeSamples)
+    {
+        auto options = SceneGeneratorOptions::forObjectCount(objects, 1234);
+        options.area = area;
+        options.minStrokeSamples = strokeSamples / 2;
+        options.maxStrokeSamples = strokeSamples * 3 / 2;
+        return std::make_shared<Scene>(SceneGenerator(options).generate());
+    }
+
+    // Same order as the editor's picking: bubbles, characters, strokes,
+    // topmost (last) first
+    const CanvasObject *pick(const Scene &scene, sf::Vector2f p)
+    {
+        for (auto it = scene.bubbles.rbegin(); it != scene.bubbles.rend(); ++it)
+            if ((*it)->isClicked(p.x, p.y))
+                return it->get();
+        for (auto it = scene.characters.rbegin(); it != scene.characters.rend(); ++it)
+            if ((*it)->isClicked(p.x, p.y))
+                return it->get();
+        for (auto it = scene.strokes.rbegin(); it != scene.strokes.rend(); ++it)
+            if ((*it)->isClicked(p.x, p.y))
+                return it->get();
+        return nullptr;
+    }
+
+    RgbaBuffer renderPage(const Scene &scene, sf::Vector2u size)
+    {
+        RasterSettings settings;
+        settings.size = size;
+        return SoftwareRenderer(settings).render(scene);
+    }
+
+    void registerText(BenchmarkRunner &runner)
+    {
+        for (std::size_t length : {16u, 128u, 1024u, 8192u})
+        {
+            runner.add({"text/wrap_" + std::to_string(length), static_cast<double>(length), "chars", [length]()
+                        {
+                            auto bubble = std::make_shared<SpeechBubble>("b", "", 0.f, 0.f, 320.f, 200.f);
+                            auto texts = std::make_shared<std::vector<std::string>>();
+                            texts->push_back(sampleText(length));
+                            texts->push_back(sampleText(length - 1)); // setText must really rewrap
+                            auto flip = std::make_shared<std::size_t>(0);
+                            return [bubble, texts, flip]() { bubble->setText((*texts)[++*flip & 1]); };
+                        }});
+        }
+    }
+
+    void registerStroke(BenchmarkRunner &runner, sf::RenderWindow *window)
+    {
+        constexpr std::size_t Points = 256;
+        runner.add({"stroke/add_point", double(Points), "points", []()
+                    {
+                        std::mt19937 rng(7);
+                        auto path = std::make_shared<std::vector<sf::Vector2f>>(
+                            strokePath(rng, Points, {1600.f, 1200.f}));
+                        auto stroke = std::make_shared<BrushStroke>("s", sf::Color::Black, 2.f);
+                        return [path, stroke]()
+                        {
+                            stroke->beginAt(path->front());
+                            for (const auto &p : *path)
+                                stroke->addPoint(p);
+                        };
+                    }});
+
+        if (!window)
+            return;
+        constexpr std::size_t DrawPoints = 4096;
+        runner.add({"stroke/draw", double(DrawPoints), "points", [window]()
+                    {
+                        std::mt19937 rng(8);
+                        auto stroke = std::make_shared<BrushStroke>("s", sf::Color::Black, 2.f);
+                        stroke->setPoints(strokePath(rng, DrawPoints, {1600.f, 1200.f}));
+                        return [stroke, window]()
+                        {
+                            stroke->draw(*window);
+                            window->display();
+                        };
+                    }});
+    }
+
+    void registerHitTest(BenchmarkRunner &runner)
+    {
+        constexpr std::size_t Queries = 64;
+        for (std::size_t objects : {1000u, 10000u, 100000u})
+        {
+            runner.add({"hit/pick_" + std::to_string(objects), double(Queries), "queries", [objects]()
+                        {
+                            const sf::Vector2u area(4000, 3000);
+                            auto scene = makeScene(objects, area, 16);
+                            auto queries = std::make_shared<std::vector<sf::Vector2f>>();
+                            std::mt19937 rng(99);
+                            std::uniform_real_distribution<float> ux(0.f, float(area.x)), uy(0.f, float(area.y));
+                            for (std::size_t i = 0; i < Queries; ++i)
+                                queries->emplace_back(ux(rng), uy(rng));
+                            return [scene, queries]()
+                            {
+                                for (const auto &q : *queries)
+                                    doNotOptimize(pick(*scene, q));
+                            };
+                        }});
+        }
+    }
+
+    void registerCommands(BenchmarkRunner &runner)
+    {
+        // Add + undo: the scene stays the same size however many ops run
+        runner.add({"commands/execute_undo", 1.0, "commands", []()
+                    {
+                        auto scene = std::make_shared<Scene>();
+                        auto manager = std::make_shared<CommandManager>();
+                        return [scene, manager]()
+                        {
+                            auto stroke = std::make_unique<BrushStroke>("s", sf::Color::Black, 2.f);
+                            manager->executeCommand(std::make_unique<AddStrokeCommand>(scene->strokes, std::move(stroke)));
+                            manager->undo();
+                        };
+                    }});
+
+        // Full history: undo everything, redo everything
+        runner.add({"commands/undo_redo_100", 200.0, "commands", []()
+                    {
+                        auto scene = std::make_shared<Scene>();
+                        auto manager = std::make_shared<CommandManager>();
+                        for (int i = 0; i < 100; ++i)
+                        {
+                            auto stroke = std::make_unique<BrushStroke>("s" + std::to_string(i), sf::Color::Black, 2.f);
+                            manager->executeCommand(std::make_unique<AddStrokeCommand>(scene->strokes, std::move(stroke)));
+                        }
+                        return [scene, manager]()
+                        {
+                            while (manager->canUndo())
+                                manager->undo();
+                            while (manager->canRedo())
+                                manager->redo();
+                        };
+                    }});
+    }
+
+    void registerAssets(BenchmarkRunner &runner)
+    {
+        // Through AssetManager under private keys: decode (headless) or
+        // decode + GPU upload (--window), as the editor's startup does
+        const std::string root = assetRoot();
+        auto images = filesIn(root + "/Characters");
+        for (const auto &file : filesIn(root + "/SpeechBubbles"))
+            images.push_back(file);
+        if (!images.empty())
+        {
+            runner.add({"assets/load_textures", double(images.size()), "images", [images]()
+                        {
+                            return [images]()
+                            {
+                                auto &AM = AssetManager::getInstance();
+                                for (std::size_t i = 0; i < images.size(); ++i)
+                                    AM.loadTexture("bench_texture_" + std::to_string(i), images[i]);
+                            };
+                        }});
+        }
+
+        auto fonts = filesIn(root + "/Font");
+        if (!fonts.empty())
+        {
+            runner.add({"assets/load_fonts", double(fonts.size()), "fonts", [fonts]()
+                        {
+                            return [fonts]()
+                            {
+                                auto &AM = AssetManager::getInstance();
+                                for (std::size_t i = 0; i < fonts.size(); ++i)
+                                    AM.loadFont("bench_font_" + std::to_string(i), fonts[i]);
+                            };
+                        }});
+        }
+    }
+
+    void registerRender(BenchmarkRunner &runner)
+    {
+        const sf::Vector2u size(1600, 1200);
+        runner.add({"render/software_page", double(size.x) * size.y, "pixels", [size]()
+                    {
+                        auto scene = makeScene(300, {1600, 1200}, 40);
+                        RasterSettings settings;
+                        settings.size = size;
+                        auto renderer = std::make_shared<SoftwareRenderer>(settings);
+                        auto target = std::make_shared<RgbaBuffer>();
+                        return [scene, renderer, target]() { renderer->render(*scene, *target); };
+                    }});
+    }
+
+    void registerEncode(BenchmarkRunner &runner)
+    {
+        const sf::Vector2u size(1600, 1200);
+        for (const char *name : {"png", "png8", "qoi", "jpeg", "raw"})
+        {
+            ImageFormat format;
+            parseImageFormat(name, format);
+            runner.add({std::string("encode/") + name, double(size.x) * size.y * 4, "bytes", [format, size]()
+                        {
+                            auto page = std::make_shared<RgbaBuffer>(
+                                renderPage(*makeScene(300, {1600, 1200}, 40), size));
+                            std::shared_ptr<ImageEncoder> encoder = createImageEncoder(format, EncoderSettings());
+                            return [page, encoder, size]()
+                            {
+                                std::ostringstream out;
+                                if (!encoder->encode(page->getPixelsPtr(), size, out))
+                                    throw std::runtime_error("Encode failed");
+                                doNotOptimize(out);
+                            };
+                        }});
+        }
+    }
+
+    void registerDownscale(BenchmarkRunner &runner)
+    {
+        const sf::Vector2u size(1024, 1024);
+        for (DownscaleFilter filter : {DownscaleFilter::Box, DownscaleFilter::Lanczos})
+        {
+            for (unsigned factor : {2u, 4u})
+            {
+                std::string name = std::string("downscale/") + (filter == DownscaleFilter::Box ? "box_" : "lanczos_") +
+                                   std::to_string(factor) + "x";
+                runner.add({name, double(size.x) * size.y, "pixels", [filter, factor, size]()
+                            {
+                                const sf::Vector2u src(size.x * factor, size.y * factor);
+                                auto page = std::make_shared<RgbaBuffer>(
+                                    renderPage(*makeScene(300, {1600, 1200}, 40), src));
+                                auto ds = std::make_shared<Downscaler>(factor, filter);
+                                auto dst = std::make_shared<std::vector<std::uint8_t>>(std::size_t(size.x) * size.y * 4);
+                                return [page, ds, dst, src, size]()
+                                {
+                                    ds->downscale(page->getPixelsPtr(), src.x, src.y, 0, 0, size.y, dst->data(),
+                                                  std::size_t(size.x) * 4);
+                                };
+                            }});
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    BenchmarkOptions options;
+    std::string outPath;
+    bool useWindow = false;
+    bool listOnly = false;
+    PerfGateOptions gate;
+    bool gateRun = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--out" && hasValue)
+            outPath = argv[++i];
+        else if (arg == "--filter" && hasValue)
+            options.filter = argv[++i];
+        else if (arg == "--samples" && hasValue)
+            options.samples = static_cast<std::size_t>(std::stoul(argv[++i]));
+        else if (arg == "--min-time" && hasValue)
+            options.minSampleSeconds = std::stod(argv[++i]);
+        else if (arg == "--window")
+            useWindow = true;
+        else if (arg == "--list")
+            listOnly = true;
+        else if (arg == "--gate" && hasValue)
+        {
+            gate.baselinePath = argv[++i];
+            gateRun = true;
+        }
+        else if (arg == "--runs" && hasValue)
+            gate.runs = static_cast<unsigned>(std::stoul(argv[++i]));
+        else if (arg == "--scenario" && hasValue)
+            gate.scenarios.push_back(argv[++i]);
+        else if (arg == "--app" && hasValue)
+            gate.app = argv[++i];
+        else if (arg == "--update-baseline")
+            gate.updateBaseline = true;
+        else
+        {
+            std::cerr << "Usage: ComicBenchmarks [--out FILE] [--filter TEXT] [--samples N] [--min-time SEC]"
+                         " [--window] [--list]\n"
+                         "       ComicBenchmarks --gate BASELINE [--runs N] [--scenario FILE.rec]... [--app PATH]"
+                         " [--update-baseline]\n";
+            return 1;
+        }
+    }
+    if (gate.updateBaseline)
+        gateRun = true;
+    if (gate.app.empty())
+    {
+#ifdef _WIN32
+        const char *appName = "ComicStripMaker.exe";
+#else
+        const char *appName = "ComicStripMaker";
+#endif
+        gate.app = (fs::path(selfExecutable(argv[0])).parent_path() / appName).string();
+    }
+
+    // Asset and encoder logging goes to stderr with the progress lines
+    Logger::getInstance().setStreams(std::cerr, std::cerr);
+    std::streambuf *stdoutBuffer = std::cout.rdbuf(std::cerr.rdbuf());
+    try
+    {
+        std::optional<sf::RenderWindow> window;
+        if (useWindow)
+        {
+            window.emplace(sf::VideoMode({1600, 1200}), "ComicBenchmarks");
+            window->setVisible(false);
+        }
+
+        auto &AM = AssetManager::getInstance();
+        AM.setHeadless(!useWindow);
+        const std::string root = assetRoot();
+        AM.autoLoadCharacters(root + "/Characters");
+        AM.autoLoadFonts(root + "/Font");
+        AM.autoLoadBubbles(root + "/SpeechBubbles");
+
+        BenchmarkRunner runner(options);
+        registerText(runner);
+        registerStroke(runner, window ? &*window : nullptr);
+        registerHitTest(runner);
+        registerCommands(runner);
+        registerAssets(runner);
+        registerRender(runner);
+        registerEncode(runner);
+        registerDownscale(runner);
+
+        std::cout.rdbuf(stdoutBuffer);
+        if (listOnly)
+        {
+            for (const auto &name : runner.list())
+                std::cout << name << "\n";
+            return 0;
+        }
+
+        if (gateRun)
+        {
+            // Progress on stderr, the report on stdout
+            std::ostream report(stdoutBuffer);
+            std::cout.rdbuf(std::cerr.rdbuf());
+            const int code = PerfGate(gate, runner).run(std::cerr, report);
+            std::cout.rdbuf(stdoutBuffer);
+            return code;
+        }
+
+        std::cout.rdbuf(std::cerr.rdbuf());
+        const auto results = runner.run(std::cerr);
+        std::cout.rdbuf(stdoutBuffer);
+        if (outPath.empty())
+        {
+            writeBenchmarkJson(std::cout, results);
+        }
+        else
+        {
+            std::ofstream out(outPath);
+            writeBenchmarkJson(out, results);
+            if (!out)
+                throw std::runtime_error("Write failed: " + outPath);
+            std::cerr << "[Bench] Results written to " << outPath << "\n";
+        }
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cout.rdbuf(stdoutBuffer);
+        std::cerr << "[Bench] " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -6,7 +6,8 @@
 //   points and provides drawing utilities used by the canvas.
 //
 // KEY NOTES:
-//   - Points are stored as absolute world coordinates.
+//   - Points are stored in a shared StrokeGeometry in the coordinates they
+//     were drawn at; getTransform() maps them to the stroke's current rect.
 //   - `addPoint` interpolates between samples to avoid gaps when the mouse
 //     moves quickly.
 //   - Drawing renders filled circles for each sample to approximate stroke
@@ -14,30 +15,44 @@
 //=============================================================================
 
 #include "BrushStroke.h"
+#include "ContentHash.h"
+#include "MemoryStats.h"
 
 #include <algorithm>
 #include <cmath>
 
+namespace
+{
+    // Compute min/max using current bounds and the new point
+    void appendBounds(sf::FloatRect& bounds, const sf::Vector2f& p)
+    {
+        float minX = std::min(bounds.position.x, p.x);
+        float minY = std::min(bounds.position.y, p.y);
+        float maxX = std::max(bounds.position.x + bounds.size.x, p.x);
+        float maxY = std::max(bounds.position.y + bounds.size.y, p.y);
+        bounds = sf::FloatRect({minX, minY}, {maxX - minX, maxY - minY});
+    }
+}
+
 BrushStroke::BrushStroke(const std::string& id,
                          const sf::Color& color,
                          float thickness)
     : CanvasObject(id, 0.f, 0.f, 0.f, 0.f, 0.f),
-      m_vertices(sf::PrimitiveType::LineStrip),
+      m_geometry(std::make_shared<StrokeGeometry>()),
       color_(color),
-      thickness_(thickness) // currently not used (SFML lines are 1px)
+      thickness_(thickness)
 {
 }
 
 void BrushStroke::beginAt(const sf::Vector2f& pos)
 {
-    m_vertices.clear();
+    // Fresh geometry: copies of the old points keep theirs
+    m_geometry = std::make_shared<StrokeGeometry>();
+    m_isFlipped = false;
+    m_geometry->points.push_back(pos);
 
     // First point defines initial bounds
-    sf::Vertex v;
-    v.position = pos;
-    v.color    = color_;
-    m_vertices.append(v);
-
+    m_geometry->bounds = sf::FloatRect(pos, {0.f, 0.f});
     x_ = pos.x;
     y_ = pos.y;
     width_  = 0.f;
@@ -46,25 +61,24 @@ void BrushStroke::beginAt(const sf::Vector2f& pos)
     // Keep SFML-side state consistent with logical state
     m_position = {x_, y_};
     m_size     = {width_, height_};
+    touch();
 }
 
 void BrushStroke::addPoint(const sf::Vector2f& pos)
 {
+    touch();
+    StrokeGeometry& geometry = editableGeometry();
+
     // If there's no previous point, just add this one
-    if (m_vertices.getVertexCount() == 0)
+    if (geometry.points.empty())
     {
-        sf::Vertex v;
-        v.position = pos;
-        v.color    = color_;
-        m_vertices.append(v);
-        updateBoundsForPoint(pos);
+        beginAt(pos);
         return;
     }
 
     // Interpolate between last point and this point so fast mouse moves
     // don't produce gaps. Use spacing guided by stroke thickness.
-    auto &lastV = m_vertices[m_vertices.getVertexCount() - 1];
-    sf::Vector2f lastPos = lastV.position;
+    sf::Vector2f lastPos = geometry.points.back();
 
     float dx = pos.x - lastPos.x;
     float dy = pos.y - lastPos.y;
@@ -76,11 +90,7 @@ void BrushStroke::addPoint(const sf::Vector2f& pos)
 
     if (dist <= spacing)
     {
-        sf::Vertex v;
-        v.position = pos;
-        v.color    = color_;
-        m_vertices.append(v);
-        updateBoundsForPoint(pos);
+        appendPoint(geometry, pos);
         return;
     }
 
@@ -88,22 +98,38 @@ void BrushStroke::addPoint(const sf::Vector2f& pos)
     for (int i = 1; i <= steps; ++i)
     {
         float t = static_cast<float>(i) / static_cast<float>(steps);
-        sf::Vertex v;
-        v.position = sf::Vector2f(lastPos.x + t * dx, lastPos.y + t * dy);
-        v.color = color_;
-        m_vertices.append(v);
-        updateBoundsForPoint(v.position);
+        appendPoint(geometry, sf::Vector2f(lastPos.x + t * dx, lastPos.y + t * dy));
     }
 }
 
-void BrushStroke::setColor(const sf::Color& c)
+void BrushStroke::setPoints(const std::vector<sf::Vector2f>& points)
 {
-    color_ = c;
-    // Update existing vertices to new color
-    for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
+    touch();
+    if (points.empty())
     {
-        m_vertices[i].color = color_;
+        m_geometry = std::make_shared<StrokeGeometry>();
+        return;
     }
+
+    beginAt(points.front());
+    m_geometry->points.reserve(points.size());
+    for (std::size_t i = 1; i < points.size(); ++i)
+        appendPoint(*m_geometry, points[i]);
+}
+
+std::unique_ptr<BrushStroke> BrushStroke::clone(const std::string& id) const
+{
+    auto copy = std::make_unique<BrushStroke>(*this);
+    copy->id_ = id;
+    copy->m_id = id;
+    copy->touch();
+    return copy;
+}
+
+void BrushStroke::setColor(const sf::Color& c)
+{
+    color_ = c;
+    touch();
 }
 
 sf::Color BrushStroke::getColor() const
@@ -111,8 +137,57 @@ sf::Color BrushStroke::getColor() const
     return color_;
 }
 
-void BrushStroke::draw(sf::RenderWindow& window) {
-    if (m_vertices.getVertexCount() == 0)
+const std::vector<sf::Vector2f>& BrushStroke::getPoints() const
+{
+    return m_geometry->points;
+}
+
+std::size_t BrushStroke::getPointCount() const
+{
+    return m_geometry->points.size();
+}
+
+sf::Transform BrushStroke::getTransform() const
+{
+    const sf::FloatRect& b = m_geometry->bounds;
+    // A straight horizontal/vertical stroke has no extent to scale
+    const float sx = b.size.x > 0.f ? width_ / b.size.x : 1.f;
+    const float sy = b.size.y > 0.f ? height_ / b.size.y : 1.f;
+
+    sf::Transform t;
+    t.translate({x_, y_});
+    if (m_isFlipped)
+    {
+        t.translate({width_, 0.f});
+        t.scale({-1.f, 1.f});
+    }
+    t.scale({sx, sy});
+    t.translate(-b.position);
+    return t;
+}
+
+std::vector<sf::Vector2f> BrushStroke::getWorldPoints() const
+{
+    const sf::Transform t = getTransform();
+    std::vector<sf::Vector2f> world;
+    world.reserve(m_geometry->points.size());
+    for (const auto& p : m_geometry->points)
+        world.push_back(t.transformPoint(p));
+    return world;
+}
+
+float BrushStroke::getThickness() const
+{
+    return thickness_;
+}
+
+bool BrushStroke::sharesGeometry() const
+{
+    return m_geometry.use_count() > 1;
+}
+
+void BrushStroke::draw(sf::RenderTarget& target) {
+    if (m_geometry->points.empty())
         return;
 
     // Use the stored thickness_ member
@@ -121,14 +196,33 @@ void BrushStroke::draw(sf::RenderWindow& window) {
 
     // SFML 3: setOrigin(Vector2f origin)
     dot.setOrigin(sf::Vector2f(radius, radius));
+    dot.setFillColor(color_);
 
-    for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i) {
-        dot.setPosition(m_vertices[i].position);
-        dot.setFillColor(color_);
-        window.draw(dot);
+    const sf::Transform t = getTransform();
+    for (const auto& p : m_geometry->points) {
+        dot.setPosition(t.transformPoint(p));
+        target.draw(dot);
     }
 }
 
+std::uint64_t BrushStroke::computeContentHash() const
+{
+    std::uint64_t h = CanvasObject::computeContentHash();
+    h = hashValue(color_, h);
+    h = hashValue(thickness_, h);
+
+    // Points are hashed once per geometry, not once per copy
+    const StrokeGeometry& g = *m_geometry;
+    if (!g.hashValid)
+    {
+        std::uint64_t gh = hashValue(static_cast<std::uint64_t>(g.points.size()));
+        for (const auto& p : g.points)
+            gh = hashValue(p, gh);
+        g.hash = gh;
+        g.hashValid = true;
+    }
+    return hashValue(g.hash, h);
+}
 
 bool BrushStroke::isClicked(float mouseX, float mouseY) const
 {
@@ -139,18 +233,51 @@ bool BrushStroke::isClicked(float mouseX, float mouseY) const
     return inX && inY;
 }
 
-void BrushStroke::updateBoundsForPoint(const sf::Vector2f& p)
+std::size_t BrushStroke::memoryBytes() const
 {
-    // Compute min/max using current bounds and the new point
-    float minX = std::min(x_, p.x);
-    float minY = std::min(y_, p.y);
-    float maxX = std::max(x_ + width_,  p.x);
-    float maxY = std::max(y_ + height_, p.y);
-
-    x_      = minX;
-    y_      = minY;
-    width_  = maxX - minX;
-    height_ = maxY - minY;
+    const std::size_t geometryBytes = sizeof(StrokeGeometry) + heapBytes(m_geometry->points);
+    return CanvasObject::memoryBytes() + sizeof(BrushStroke) - sizeof(CanvasObject) +
+           geometryBytes / static_cast<std::size_t>(std::max<long>(m_geometry.use_count(), 1));
+}
+
+StrokeGeometry& BrushStroke::editableGeometry()
+{
+    const sf::FloatRect& b = m_geometry->bounds;
+    const bool identity = !m_isFlipped && b.position == sf::Vector2f(x_, y_) &&
+                          b.size == sf::Vector2f(width_, height_);
+    if (!identity)
+    {
+        // Moved, resized or flipped: continue in world coordinates
+        auto baked = std::make_shared<StrokeGeometry>();
+        baked->points = getWorldPoints();
+        m_geometry = std::move(baked);
+        m_isFlipped = false;
+        if (!m_geometry->points.empty())
+        {
+            m_geometry->bounds = sf::FloatRect(m_geometry->points.front(), {0.f, 0.f});
+            for (const auto& p : m_geometry->points)
+                appendBounds(m_geometry->bounds, p);
+        }
+    }
+    else if (m_geometry.use_count() > 1)
+    {
+        m_geometry = std::make_shared<StrokeGeometry>(*m_geometry);
+    }
+    m_geometry->hashValid = false;
+    return *m_geometry;
+}
+
+void BrushStroke::appendPoint(StrokeGeometry& geometry, const sf::Vector2f& p)
+{
+    geometry.points.push_back(p);
+    geometry.hashValid = false;
+    appendBounds(geometry.bounds, p);
+
+    // Identity transform: the object rect is the geometry bounds
+    x_      = geometry.bounds.position.x;
+    y_      = geometry.bounds.position.y;
+    width_  = geometry.bounds.size.x;
+    height_ = geometry.bounds.size.y;
 
     // Sync SFML view
     m_position = {x_, y_};
@@ -10,6 +10,12 @@
 //   - Variable thickness: Circles drawn at each point to simulate brush width
 //   - Color management: Each stroke stores and can change its color
 //   - Bounds tracking: Maintains logical bounding box for selection
+//   - Shared geometry: points live in an immutable StrokeGeometry shared by
+//     every copy of the stroke (duplicates, clipboard, undo history); each
+//     stroke places it with its own transform (position, size and flip of
+//     the CanvasObject rect). Moving, resizing or flipping never touches
+//     the points, clone() is O(1), and editing a shared stroke copies the
+//     points first (copy-on-write)
 //
 // USAGE:
 //   1. Create stroke with color and thickness
@@ -17,6 +23,12 @@
 //   3. Call addPoint(position) for each mouse position during drag
 //   4. Call draw(window) to render
 //
+// TRANSFORM:
+//   getTransform() maps the geometry bounds onto the object rect (x, y,
+//   width, height), mirrored inside the rect when flipped. A freshly drawn
+//   stroke has the identity transform; renderers draw
+//   getTransform().transformPoint(p) for every getPoints() entry.
+//
 // WHERE TO MODIFY:
 //   - Change rendering: Switch from circles to line segments
 //   - Add texture: Apply pattern or gradient to strokes
@@ -28,7 +40,17 @@
 #include "CanvasObject.h"
 
 #include <SFML/Graphics.hpp>
+#include <memory>
 #include <string>
+#include <vector>
+
+// Stroke points in local space. Never changed once a second stroke shares it
+struct StrokeGeometry {
+    std::vector<sf::Vector2f> points;
+    sf::FloatRect bounds;                        // Of `points`
+    mutable std::uint64_t hash{0};               // Content hash, cached
+    mutable bool hashValid{false};
+};
 
 class BrushStroke : public CanvasObject {
 public:
@@ -42,18 +64,46 @@ public:
     // Append a new point to the stroke (world position)
     void addPoint(const sf::Vector2f& pos);
 
+    // Replace all points verbatim (no interpolation), e.g. when loading a project
+    void setPoints(const std::vector<sf::Vector2f>& points);
+
+    // Copy with a new id sharing this stroke's geometry (no points copied)
+    std::unique_ptr<BrushStroke> clone(const std::string& id) const;
+
     void setColor(const sf::Color& c);
     sf::Color getColor() const;
 
+    // Read-only access for offscreen renderers (software rasterizer, export):
+    // local points and the transform placing them in the world
+    const std::vector<sf::Vector2f>& getPoints() const;
+    std::size_t getPointCount() const;
+    sf::Transform getTransform() const;
+    std::vector<sf::Vector2f> getWorldPoints() const;
+    float getThickness() const;
+
+    // True when another stroke uses the same geometry
+    bool sharesGeometry() const;
+
     // CanvasObject interface
-    void draw(sf::RenderWindow& window) override;
+    void draw(sf::RenderTarget& target) override;
     bool isClicked(float mouseX, float mouseY) const override;
+    // Shared geometry is split evenly among the strokes using it, so
+    // duplicates add almost nothing to the totals
+    std::size_t memoryBytes() const override;
+
+protected:
+    std::uint64_t computeContentHash() const override;
 
 private:
-    sf::VertexArray m_vertices;  // Line strip representing the stroke
+    std::shared_ptr<StrokeGeometry> m_geometry;  // Never null; see sharesGeometry()
     sf::Color color_;
-    float thickness_;            // Reserved for future use (fixed 1px for now)
+    float thickness_;            // Dot diameter in world units (not scaled by the transform)
+
+    // Geometry addPoint() may append to: unshared, with the transform baked
+    // into the points if the stroke was moved/resized/flipped
+    StrokeGeometry& editableGeometry();
 
-    // Keep CanvasObject's logical bounds (x_, y_, width_, height_) in sync
-    void updateBoundsForPoint(const sf::Vector2f& p);
+    // Grow the geometry bounds and keep CanvasObject's logical bounds
+    // (x_, y_, width_, height_) equal to them (identity transform)
+    void appendPoint(StrokeGeometry& geometry, const sf::Vector2f& p);
 };
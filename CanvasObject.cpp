@@ -3,6 +3,8 @@
 //=============================================================================
 #include "CanvasObject.h"
 #include "VectorUtils.h"
+#include "ContentHash.h"
+#include "MemoryStats.h"
 #include <tuple>
 
 CanvasObject::CanvasObject(const std::string& id, float x, float y, float w, float h, float rot)
@@ -14,6 +16,7 @@ void CanvasObject::move(const sf::Vector2f& offset) {
     m_position += offset;
     x_ = m_position.x;
     y_ = m_position.y;
+    touch();
 }
 
 sf::Vector2f CanvasObject::getPosition() const { return m_position; }
@@ -22,12 +25,14 @@ void CanvasObject::move(float dx, float dy) {
     x_ += dx; 
     y_ += dy;
     m_position = {x_, y_};
+    touch();
 }
 
 void CanvasObject::setPosition(float x, float y) {
     x_ = x; 
     y_ = y;
     m_position = {x, y};
+    touch();
 }
 
 std::pair<float, float> CanvasObject::getPosition_floats() const { return {x_, y_}; }
@@ -36,18 +41,21 @@ void CanvasObject::setPosition(const sf::Vector2f& pos) {
     m_position = pos; 
     x_ = pos.x; 
     y_ = pos.y;
+    touch();
 }
 
 void CanvasObject::setSize(float w, float h) {
     width_ = w; 
     height_ = h;
     m_size = {w, h};
+    touch();
 }
 
 void CanvasObject::setSize(const sf::Vector2f& size) {
     m_size = size; 
     width_ = size.x; 
     height_ = size.y;
+    touch();
 }
 
 std::pair<float, float> CanvasObject::getSize_floats() const { return {width_, height_}; }
@@ -57,6 +65,7 @@ sf::Vector2f CanvasObject::getSize() const { return m_size; }
 void CanvasObject::setRotation(float degrees) {
     rotationDegrees_ = degrees;
     m_rotationDegrees_sfml = degrees;
+    touch();
 }
 
 float CanvasObject::getRotation() const { return rotationDegrees_; }
@@ -64,6 +73,7 @@ float CanvasObject::getRotation() const { return rotationDegrees_; }
 // [NEW] Flip Implementation
 void CanvasObject::setFlipped(bool flipped) {
     m_isFlipped = flipped;
+    touch();
 }
 
 bool CanvasObject::isFlipped() const {
@@ -74,4 +84,43 @@ std::tuple<float, float, float, float> CanvasObject::getBoundingBox() const {
     return std::make_tuple(x_, y_, width_, height_);
 }
 
-const std::string& CanvasObject::getId() const { return id_; }
\ No newline at end of file
+const std::string& CanvasObject::getId() const { return id_; }
+
+std::atomic<std::uint64_t> CanvasObject::s_revision{0};
+
+void CanvasObject::touch() {
+    m_contentHashValid = false;
+    ++s_revision;
+}
+
+std::uint64_t CanvasObject::computeContentHash() const {
+    std::uint64_t h = hashValue(m_position);
+    h = hashValue(m_size, h);
+    h = hashValue(rotationDegrees_, h);
+    return hashValue(m_isFlipped, h);
+}
+
+std::uint64_t CanvasObject::getContentHash() const {
+    if (!m_contentHashValid) {
+        m_contentHash = computeContentHash();
+        m_contentHashValid = true;
+    }
+    return m_contentHash;
+}
+
+std::uint64_t CanvasObject::getRevision() { return s_revision; }
+
+std::size_t CanvasObject::memoryBytes() const {
+    return sizeof(CanvasObject) + heapBytes(id_) + heapBytes(m_id);
+}
+
+Placement Placement::of(CanvasObject* o) {
+    return {o, o->getPosition(), o->getSize(), o->isFlipped()};
+}
+
+void Placement::apply() const {
+    // Size first: bubbles rebuild their shape around the current position
+    object->setSize(size.x, size.y);
+    object->setPosition(position.x, position.y);
+    object->setFlipped(flipped);
+}
@@ -3,6 +3,8 @@
 //=============================================================================
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -25,6 +27,17 @@ protected:
     float m_rotationDegrees_sfml{0.f};   
     bool m_isFlipped{false};             // [NEW] Horizontal flip state
 
+    // Call after every change that affects how the object renders
+    void touch();
+
+    // Hash of the rendered state; subclasses extend the base hash
+    virtual std::uint64_t computeContentHash() const;
+
+private:
+    mutable std::uint64_t m_contentHash{0};
+    mutable bool m_contentHashValid{false};
+    static std::atomic<std::uint64_t> s_revision;
+
 public:
     CanvasObject(const std::string& id = "",
                  float x = 0.f, float y = 0.f,
@@ -34,7 +47,7 @@ public:
     virtual ~CanvasObject() = default;
 
     // Pure virtual methods
-    virtual void draw(sf::RenderWindow& window) = 0;
+    virtual void draw(sf::RenderTarget& target) = 0;
     virtual bool isClicked(float mouseX, float mouseY) const = 0;
 
     // Position
@@ -62,4 +75,26 @@ public:
     // Utility
     virtual std::tuple<float, float, float, float> getBoundingBox() const;
     const std::string& getId() const;
+
+    // Export cache support (see SceneHash.h): content hash, recomputed only
+    // after the object changed, and a counter bumped by every change to
+    // any object
+    std::uint64_t getContentHash() const;
+    static std::uint64_t getRevision();
+
+    // Memory accounting (see MemoryStats.h): bytes of the object and the
+    // heap data it owns; shared textures/fonts are counted by AssetManager
+    virtual std::size_t memoryBytes() const;
+};
+
+// What a group transform changes on one object: its rect and flip. For
+// strokes this is the per-instance transform, so no points are touched
+struct Placement {
+    CanvasObject* object;
+    sf::Vector2f position;
+    sf::Vector2f size;
+    bool flipped;
+
+    static Placement of(CanvasObject* o);
+    void apply() const;
 };
\ No newline at end of file
@@ -3,6 +3,8 @@
 //=============================================================================
 #include "Character.h"
 #include "AssetManager.h"
+#include "ContentHash.h"
+#include "MemoryStats.h"
 #include <iostream> 
 
 Character::Character(const std::string& id,
@@ -15,7 +17,16 @@ Character::Character(const std::string& id,
 {
 }
 
-void Character::draw(sf::RenderWindow& window)
+std::unique_ptr<Character> Character::clone(const std::string& id) const
+{
+    auto copy = std::make_unique<Character>(*this);
+    copy->id_ = id;
+    copy->m_id = id;
+    copy->touch();
+    return copy;
+}
+
+void Character::draw(sf::RenderTarget& target)
 {
     auto tex = AssetManager::getInstance().getTexture(imagePath_);
     if (!tex) return;
@@ -42,7 +53,7 @@ void Character::draw(sf::RenderWindow& window)
     sprite.setPosition({x_, y_});
     sprite.setRotation(sf::degrees(rotationDegrees_));
 
-    window.draw(sprite);
+    target.draw(sprite);
 }
 
 bool Character::isClicked(float mouseX, float mouseY) const
@@ -55,5 +66,18 @@ bool Character::isClicked(float mouseX, float mouseY) const
 void Character::setExpression(const std::string& expr) { expression_ = expr; }
 const std::string& Character::getExpression() const { return expression_; }
 
-void Character::setImagePath(const std::string& path) { imagePath_ = path; }
-const std::string& Character::getImagePath() const { return imagePath_; }
\ No newline at end of file
+void Character::setImagePath(const std::string& path) { imagePath_ = path; touch(); }
+const std::string& Character::getImagePath() const { return imagePath_; }
+
+std::size_t Character::memoryBytes() const {
+    // The texture is shared through AssetManager
+    return CanvasObject::memoryBytes() + sizeof(Character) - sizeof(CanvasObject) +
+           heapBytes(imagePath_) + heapBytes(expression_);
+}
+
+std::uint64_t Character::computeContentHash() const
+{
+    // Key and file contents: a replaced image file changes the hash too
+    std::uint64_t h = fnv1a64(imagePath_, CanvasObject::computeContentHash());
+    return hashValue(AssetManager::getInstance().getTextureHash(imagePath_), h);
+}
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "CanvasObject.h"
+#include <memory>
 #include <string>
 #include <SFML/Graphics.hpp> 
 
@@ -20,12 +21,19 @@ public:
 
     ~Character() override = default;
 
-    void draw(sf::RenderWindow& window) override;
+    // Copy with a new id (copy/paste, duplicate); the texture stays shared
+    std::unique_ptr<Character> clone(const std::string& id) const;
+
+    void draw(sf::RenderTarget& target) override;
     bool isClicked(float mouseX, float mouseY) const override;
+    std::size_t memoryBytes() const override;
 
     void setExpression(const std::string& expr);
     const std::string& getExpression() const;
 
     void setImagePath(const std::string& path);
     const std::string& getImagePath() const;
+
+protected:
+    std::uint64_t computeContentHash() const override;
 };
\ No newline at end of file
@@ -12,7 +12,12 @@
 //=============================================================================
 
 #include "Command.h"
-#include <iostream>
+#include "FrameWatchdog.h"
+#include "Logger.h"
+#include "MemoryStats.h"
+#include "Telemetry.h"
+#include <algorithm>
+#include <utility>
 
 // ============== AddCharacterCommand ==============
 
@@ -37,6 +42,11 @@ std::string AddCharacterCommand::getName() const {
     return "Add Character";
 }
 
+std::size_t AddCharacterCommand::memoryBytes() const {
+    // Null while the object is in the scene
+    return sizeof(*this) + (character ? character->memoryBytes() : 0);
+}
+
 // ============== AddBubbleCommand ==============
 
 AddBubbleCommand::AddBubbleCommand(std::vector<std::unique_ptr<SpeechBubble>>& bubs,
@@ -60,6 +70,11 @@ std::string AddBubbleCommand::getName() const {
     return "Add Bubble";
 }
 
+std::size_t AddBubbleCommand::memoryBytes() const {
+    // Null while the object is in the scene
+    return sizeof(*this) + (bubble ? bubble->memoryBytes() : 0);
+}
+
 // ============== AddStrokeCommand ==============
 
 AddStrokeCommand::AddStrokeCommand(std::vector<std::unique_ptr<BrushStroke>>& stks,
@@ -83,6 +98,11 @@ std::string AddStrokeCommand::getName() const {
     return "Add Stroke";
 }
 
+std::size_t AddStrokeCommand::memoryBytes() const {
+    // Null while the object is in the scene
+    return sizeof(*this) + (stroke ? stroke->memoryBytes() : 0);
+}
+
 // ============== DeleteCharacterCommand ==============
 
 DeleteCharacterCommand::DeleteCharacterCommand(std::vector<std::unique_ptr<Character>>& chars, int idx)
@@ -107,6 +127,11 @@ std::string DeleteCharacterCommand::getName() const {
     return "Delete Character";
 }
 
+std::size_t DeleteCharacterCommand::memoryBytes() const {
+    // Null while the object is in the scene
+    return sizeof(*this) + (character ? character->memoryBytes() : 0);
+}
+
 // ============== DeleteBubbleCommand ==============
 
 DeleteBubbleCommand::DeleteBubbleCommand(std::vector<std::unique_ptr<SpeechBubble>>& bubs, int idx)
@@ -131,6 +156,40 @@ std::string DeleteBubbleCommand::getName() const {
     return "Delete Bubble";
 }
 
+std::size_t DeleteBubbleCommand::memoryBytes() const {
+    // Null while the object is in the scene
+    return sizeof(*this) + (bubble ? bubble->memoryBytes() : 0);
+}
+
+// ============== DeleteGroupCommand ==============
+
+DeleteGroupCommand::DeleteGroupCommand(std::vector<std::unique_ptr<ObjectGroup>>& grps, int idx)
+    : groups(grps), index(idx), isExecuted(false) {}
+
+void DeleteGroupCommand::execute() {
+    if (index >= 0 && index < static_cast<int>(groups.size())) {
+        group = std::move(groups[index]);
+        groups.erase(groups.begin() + index);
+        isExecuted = true;
+    }
+}
+
+void DeleteGroupCommand::undo() {
+    if (isExecuted && group) {
+        groups.insert(groups.begin() + index, std::move(group));
+        isExecuted = false;
+    }
+}
+
+std::string DeleteGroupCommand::getName() const {
+    return "Delete Group";
+}
+
+std::size_t DeleteGroupCommand::memoryBytes() const {
+    // Null while the group is in the scene
+    return sizeof(*this) + (group ? group->memoryBytes() : 0);
+}
+
 // ============== ChangeBubbleFontSizeCommand ==============
 
 ChangeBubbleFontSizeCommand::ChangeBubbleFontSizeCommand(SpeechBubble* b, int oldSize, int newSize)
@@ -154,7 +213,263 @@ std::string ChangeBubbleFontSizeCommand::getName() const {
     return "Change Font Size";
 }
 
+std::size_t ChangeBubbleFontSizeCommand::memoryBytes() const {
+    return sizeof(*this);
+}
+
+// ============== PaintCommand ==============
+
+PaintCommand::PaintCommand(PaintLayer* l, PaintLayer::Snapshot beforeStroke, PaintLayer::Snapshot afterStroke,
+                           std::string commandName)
+    : layer(l), before(std::move(beforeStroke)), after(std::move(afterStroke)), name(std::move(commandName)),
+      isExecuted(false) {}
+
+void PaintCommand::execute() {
+    if (layer) {
+        layer->restore(after);
+        isExecuted = true;
+    }
+}
+
+void PaintCommand::undo() {
+    if (isExecuted && layer) {
+        layer->restore(before);
+        isExecuted = false;
+    }
+}
+
+std::string PaintCommand::getName() const {
+    return name;
+}
+
+std::size_t PaintCommand::memoryBytes() const {
+    // Tiles of the snapshot not in the layer are held by the history only
+    const auto& held = isExecuted ? before : after;
+    const auto& live = isExecuted ? after : before;
+    return sizeof(*this) + PaintLayer::changedTiles(live, held) * (sizeof(PaintLayer::Tile) + PaintLayer::TileBytes);
+}
+
+// ============== PasteCommand ==============
+
+namespace {
+    template <typename T>
+    void moveAll(std::vector<std::unique_ptr<T>>& from, std::vector<std::unique_ptr<T>>& to, std::size_t count) {
+        for (auto it = from.end() - static_cast<std::ptrdiff_t>(count); it != from.end(); ++it)
+            to.push_back(std::move(*it));
+        from.resize(from.size() - count);
+    }
+}
+
+PasteCommand::PasteCommand(Scene& target, Scene pasted, std::string commandName)
+    : scene(target), objects(std::move(pasted)), strokeCount(objects.strokes.size()),
+      characterCount(objects.characters.size()), bubbleCount(objects.bubbles.size()),
+      groupCount(objects.groups.size()), name(std::move(commandName)), isExecuted(false) {}
+
+void PasteCommand::execute() {
+    if (isExecuted)
+        return;
+    moveAll(objects.strokes, scene.strokes, strokeCount);
+    moveAll(objects.characters, scene.characters, characterCount);
+    moveAll(objects.bubbles, scene.bubbles, bubbleCount);
+    moveAll(objects.groups, scene.groups, groupCount);
+    isExecuted = true;
+}
+
+void PasteCommand::undo() {
+    if (!isExecuted || scene.strokes.size() < strokeCount || scene.characters.size() < characterCount ||
+        scene.bubbles.size() < bubbleCount || scene.groups.size() < groupCount)
+        return;
+    moveAll(scene.strokes, objects.strokes, strokeCount);
+    moveAll(scene.characters, objects.characters, characterCount);
+    moveAll(scene.bubbles, objects.bubbles, bubbleCount);
+    moveAll(scene.groups, objects.groups, groupCount);
+    isExecuted = false;
+}
+
+std::string PasteCommand::getName() const {
+    return name;
+}
+
+std::size_t PasteCommand::memoryBytes() const {
+    // Empty while the objects are in the scene
+    std::size_t bytes = sizeof(*this);
+    for (const auto& s : objects.strokes) bytes += s->memoryBytes();
+    for (const auto& c : objects.characters) bytes += c->memoryBytes();
+    for (const auto& b : objects.bubbles) bytes += b->memoryBytes();
+    for (const auto& g : objects.groups) bytes += g->memoryBytes();
+    return bytes;
+}
+
+// ============== TransformCommand ==============
+
+TransformCommand::TransformCommand(std::vector<Placement> beforeChange, std::vector<Placement> afterChange,
+                                   std::string commandName)
+    : before(std::move(beforeChange)), after(std::move(afterChange)), name(std::move(commandName)),
+      isExecuted(false) {}
+
+void TransformCommand::execute() {
+    for (const auto& p : after)
+        p.apply();
+    isExecuted = true;
+}
+
+void TransformCommand::undo() {
+    if (isExecuted) {
+        for (const auto& p : before)
+            p.apply();
+        isExecuted = false;
+    }
+}
+
+std::string TransformCommand::getName() const {
+    return name;
+}
+
+std::size_t TransformCommand::memoryBytes() const {
+    return sizeof(*this) + heapBytes(before) + heapBytes(after) + heapBytes(name);
+}
+
+// ============== GroupCommand ==============
+
+namespace {
+    // Remove the objects at ascending `indices`, keeping their order
+    template <typename T>
+    std::vector<std::unique_ptr<T>> extractAt(std::vector<std::unique_ptr<T>>& from,
+                                              const std::vector<std::size_t>& indices) {
+        std::vector<std::unique_ptr<T>> taken;
+        taken.reserve(indices.size());
+        for (std::size_t i : indices)
+            taken.push_back(std::move(from[i]));
+        for (auto it = indices.rbegin(); it != indices.rend(); ++it)
+            from.erase(from.begin() + static_cast<std::ptrdiff_t>(*it));
+        return taken;
+    }
+
+    // Inverse of extractAt()
+    template <typename T>
+    void insertAt(std::vector<std::unique_ptr<T>>& to, const std::vector<std::size_t>& indices,
+                  std::vector<std::unique_ptr<T>>& items) {
+        for (std::size_t k = 0; k < indices.size() && k < items.size(); ++k)
+            to.insert(to.begin() + static_cast<std::ptrdiff_t>(std::min(indices[k], to.size())), std::move(items[k]));
+        items.clear();
+    }
+}
+
+GroupCommand::GroupCommand(Scene& target, std::vector<std::size_t> strokes, std::vector<std::size_t> characters,
+                           std::vector<std::size_t> bubbles, const std::string& groupId)
+    : scene(target), strokeIndices(std::move(strokes)), characterIndices(std::move(characters)),
+      bubbleIndices(std::move(bubbles)), isExecuted(false) {
+    group = std::make_unique<ObjectGroup>(groupId, Scene{});
+    groupPtr = group.get();
+}
+
+void GroupCommand::execute() {
+    if (isExecuted)
+        return;
+    Scene members;
+    members.strokes = extractAt(scene.strokes, strokeIndices);
+    members.characters = extractAt(scene.characters, characterIndices);
+    members.bubbles = extractAt(scene.bubbles, bubbleIndices);
+    group->setMembers(std::move(members));
+    scene.groups.push_back(std::move(group));
+    isExecuted = true;
+}
+
+void GroupCommand::undo() {
+    if (!isExecuted || scene.groups.empty() || scene.groups.back().get() != groupPtr)
+        return;
+    group = std::move(scene.groups.back());
+    scene.groups.pop_back();
+    Scene members = group->takeMembers();
+    insertAt(scene.strokes, strokeIndices, members.strokes);
+    insertAt(scene.characters, characterIndices, members.characters);
+    insertAt(scene.bubbles, bubbleIndices, members.bubbles);
+    isExecuted = false;
+}
+
+std::string GroupCommand::getName() const {
+    return "Group";
+}
+
+std::size_t GroupCommand::memoryBytes() const {
+    std::size_t bytes = sizeof(*this) + heapBytes(strokeIndices) + heapBytes(characterIndices) +
+                        heapBytes(bubbleIndices);
+    if (group) bytes += group->memoryBytes();
+    return bytes;
+}
+
+// ============== UngroupCommand ==============
+
+UngroupCommand::UngroupCommand(Scene& target, ObjectGroup* g)
+    : scene(target), groupPtr(g), index(0), groupPlacement(Placement::of(g)), strokeCount(0),
+      characterCount(0), bubbleCount(0), isExecuted(false) {}
+
+void UngroupCommand::execute() {
+    if (isExecuted)
+        return;
+    auto it = std::find_if(scene.groups.begin(), scene.groups.end(),
+                           [&](const std::unique_ptr<ObjectGroup>& g) { return g.get() == groupPtr; });
+    if (it == scene.groups.end())
+        return;
+    index = static_cast<std::size_t>(it - scene.groups.begin());
+    group = std::move(*it);
+    scene.groups.erase(it);
+    groupPlacement = Placement::of(groupPtr);
+
+    // Place every member where the group shows it, then hand them over
+    const Scene& members = group->members();
+    std::vector<Placement> world;
+    localPlacements.clear();
+    auto place = [&](CanvasObject* o) {
+        localPlacements.push_back(Placement::of(o));
+        world.push_back(group->worldPlacement(*o));
+    };
+    for (const auto& s : members.strokes) place(s.get());
+    for (const auto& c : members.characters) place(c.get());
+    for (const auto& b : members.bubbles) place(b.get());
+    for (const auto& p : world)
+        p.apply();
+
+    Scene taken = group->takeMembers();
+    strokeCount = taken.strokes.size();
+    characterCount = taken.characters.size();
+    bubbleCount = taken.bubbles.size();
+    moveAll(taken.strokes, scene.strokes, strokeCount);
+    moveAll(taken.characters, scene.characters, characterCount);
+    moveAll(taken.bubbles, scene.bubbles, bubbleCount);
+    isExecuted = true;
+}
+
+void UngroupCommand::undo() {
+    if (!isExecuted || scene.strokes.size() < strokeCount || scene.characters.size() < characterCount ||
+        scene.bubbles.size() < bubbleCount)
+        return;
+    Scene members;
+    moveAll(scene.strokes, members.strokes, strokeCount);
+    moveAll(scene.characters, members.characters, characterCount);
+    moveAll(scene.bubbles, members.bubbles, bubbleCount);
+    for (const auto& p : localPlacements)
+        p.apply();
+    group->setMembers(std::move(members));
+    groupPlacement.apply();
+    scene.groups.insert(scene.groups.begin() + static_cast<std::ptrdiff_t>(std::min(index, scene.groups.size())),
+                        std::move(group));
+    isExecuted = false;
+}
+
+std::string UngroupCommand::getName() const {
+    return "Ungroup";
+}
+
+std::size_t UngroupCommand::memoryBytes() const {
+    std::size_t bytes = sizeof(*this) + heapBytes(localPlacements);
+    if (group) bytes += group->memoryBytes();
+    return bytes;
+}
+
 void CommandManager::executeCommand(std::unique_ptr<Command> cmd) {
+    TimedScope timed("command/execute");
+    Telemetry::getInstance().count(Counter::CommandsExecuted);
     cmd->execute();
     undoStack.push_back(std::move(cmd));
     
@@ -166,7 +481,8 @@ void CommandManager::executeCommand(std::unique_ptr<Command> cmd) {
         undoStack.erase(undoStack.begin());
     }
     
-    std::cout << "[Undo] Command executed: " << undoStack.back()->getName() << "\n";
+    LOG_INFO("Undo") << "Command executed: " << undoStack.back()->getName();
+    notifyChange();
 }
 
 bool CommandManager::canUndo() const {
@@ -178,28 +494,35 @@ bool CommandManager::canRedo() const {
 }
 
 void CommandManager::undo() {
+    TimedScope timed("command/undo");
     if (canUndo()) {
         auto cmd = std::move(undoStack.back());
         undoStack.pop_back();
         cmd->undo();
         redoStack.push_back(std::move(cmd));
-        std::cout << "[Undo] Undid: " << redoStack.back()->getName() << "\n";
+        LOG_INFO("Undo") << "Undid: " << redoStack.back()->getName();
+        Telemetry::getInstance().count(Counter::Undos);
+        notifyChange();
     }
 }
 
 void CommandManager::redo() {
+    TimedScope timed("command/redo");
     if (canRedo()) {
         auto cmd = std::move(redoStack.back());
         redoStack.pop_back();
         cmd->execute();
         undoStack.push_back(std::move(cmd));
-        std::cout << "[Redo] Redid: " << undoStack.back()->getName() << "\n";
+        LOG_INFO("Redo") << "Redid: " << undoStack.back()->getName();
+        Telemetry::getInstance().count(Counter::Redos);
+        notifyChange();
     }
 }
 
 void CommandManager::clear() {
     undoStack.clear();
     redoStack.clear();
+    notifyChange();
 }
 
 size_t CommandManager::getUndoCount() const {
@@ -209,3 +532,18 @@ size_t CommandManager::getUndoCount() const {
 size_t CommandManager::getRedoCount() const {
     return redoStack.size();
 }
+
+std::size_t CommandManager::memoryBytes() const {
+    std::size_t bytes = (undoStack.capacity() + redoStack.capacity()) * sizeof(std::unique_ptr<Command>);
+    for (const auto& cmd : undoStack) bytes += cmd->memoryBytes();
+    for (const auto& cmd : redoStack) bytes += cmd->memoryBytes();
+    return bytes;
+}
+
+void CommandManager::setChangeListener(std::function<void()> listener) {
+    onChange = std::move(listener);
+}
+
+void CommandManager::notifyChange() {
+    if (onChange) onChange();
+}
@@ -16,6 +16,12 @@
 //   - AddBubbleCommand: Adds a speech bubble to scene
 //   - AddStrokeCommand: Adds a brush stroke to scene
 //   - DeleteObjectCommand: Removes an object from scene
+//   - DeleteGroupCommand: Removes a group (with its members) from scene
+//   - PaintCommand: One stroke on the raster paint layer (tile snapshots)
+//   - PasteCommand: Adds pasted/duplicated objects of any kind in one step
+//   - TransformCommand: Moves/resizes/flips a set of objects in one step
+//   - GroupCommand / UngroupCommand: Combine objects into an ObjectGroup and
+//     split it again, keeping where everything appears on the canvas
 //
 // WHERE TO MODIFY:
 //   - Add new commands: Create new class inheriting from Command
@@ -26,12 +32,15 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <vector>
 #include <string>
 #include "Character.h"
 #include "SpeechBubble.h"
 #include "BrushStroke.h"
+#include "PaintLayer.h"
+#include "Scene.h"
 
 //-----------------------------------------------------------------------------
 // BASE COMMAND INTERFACE
@@ -49,6 +58,10 @@ public:
 
     // Get human-readable command name for UI display
     virtual std::string getName() const = 0;
+
+    // Bytes held by the command, including objects only it keeps alive
+    // (see MemoryStats.h)
+    virtual std::size_t memoryBytes() const = 0;
 };
 
 //-----------------------------------------------------------------------------
@@ -69,6 +82,7 @@ public:
     void execute() override;   // Adds character to scene
     void undo() override;      // Removes character from scene
     std::string getName() const override;
+    std::size_t memoryBytes() const override;
 };
 
 //-----------------------------------------------------------------------------
@@ -88,6 +102,7 @@ public:
     void execute() override;
     void undo() override;
     std::string getName() const override;
+    std::size_t memoryBytes() const override;
 };
 
 //-----------------------------------------------------------------------------
@@ -107,6 +122,7 @@ public:
     void execute() override;
     void undo() override;
     std::string getName() const override;
+    std::size_t memoryBytes() const override;
 };
 
 //-----------------------------------------------------------------------------
@@ -126,6 +142,7 @@ public:
     void execute() override;
     void undo() override;
     std::string getName() const override;
+    std::size_t memoryBytes() const override;
 };
 
 //-----------------------------------------------------------------------------
@@ -145,6 +162,27 @@ public:
     void execute() override;
     void undo() override;
     std::string getName() const override;
+    std::size_t memoryBytes() const override;
+};
+
+//-----------------------------------------------------------------------------
+// DELETE GROUP COMMAND
+//-----------------------------------------------------------------------------
+
+class DeleteGroupCommand : public Command {
+private:
+    std::vector<std::unique_ptr<ObjectGroup>>& groups;
+    std::unique_ptr<ObjectGroup> group;                   // Members stay inside it
+    int index;
+    bool isExecuted;
+
+public:
+    DeleteGroupCommand(std::vector<std::unique_ptr<ObjectGroup>>& grps, int idx);
+
+    void execute() override;
+    void undo() override;
+    std::string getName() const override;
+    std::size_t memoryBytes() const override;
 };
 
 //-----------------------------------------------------------------------------
@@ -164,6 +202,126 @@ public:
     void execute() override;
     void undo() override;
     std::string getName() const override;
+    std::size_t memoryBytes() const override;
+};
+
+//-----------------------------------------------------------------------------
+// PAINT COMMAND
+//-----------------------------------------------------------------------------
+
+class PaintCommand : public Command {
+private:
+    PaintLayer* layer;
+    PaintLayer::Snapshot before;                          // Copy-on-write: only the
+    PaintLayer::Snapshot after;                           // touched tiles differ
+    std::string name;                                     // "Paint" or "Fill"
+    bool isExecuted;
+
+public:
+    // Created after the stroke was painted: execute() keeps `after` in place
+    PaintCommand(PaintLayer* l, PaintLayer::Snapshot beforeStroke, PaintLayer::Snapshot afterStroke,
+                 std::string commandName = "Paint");
+
+    void execute() override;
+    void undo() override;
+    std::string getName() const override;
+    std::size_t memoryBytes() const override;
+};
+
+//-----------------------------------------------------------------------------
+// PASTE COMMAND
+//-----------------------------------------------------------------------------
+
+class PasteCommand : public Command {
+private:
+    Scene& scene;                                         // Target lists
+    Scene objects;                                        // Held while not in the scene
+    std::size_t strokeCount, characterCount, bubbleCount, groupCount;
+    std::string name;                                     // "Paste" or "Duplicate"
+    bool isExecuted;
+
+public:
+    // Appends every object of `pasted` (its paint layer is ignored) to the
+    // end of the matching scene list
+    PasteCommand(Scene& target, Scene pasted, std::string commandName = "Paste");
+
+    void execute() override;
+    void undo() override;
+    std::string getName() const override;
+    std::size_t memoryBytes() const override;
+};
+
+//-----------------------------------------------------------------------------
+// TRANSFORM COMMAND
+//-----------------------------------------------------------------------------
+
+class TransformCommand : public Command {
+private:
+    std::vector<Placement> before;
+    std::vector<Placement> after;                         // Same objects, same order
+    std::string name;                                     // "Move", "Resize" or "Flip"
+    bool isExecuted;
+
+public:
+    TransformCommand(std::vector<Placement> beforeChange, std::vector<Placement> afterChange,
+                     std::string commandName);
+
+    void execute() override;
+    void undo() override;
+    std::string getName() const override;
+    std::size_t memoryBytes() const override;
+};
+
+//-----------------------------------------------------------------------------
+// GROUP COMMAND
+//-----------------------------------------------------------------------------
+
+class GroupCommand : public Command {
+private:
+    Scene& scene;
+    std::vector<std::size_t> strokeIndices;               // Ascending positions in
+    std::vector<std::size_t> characterIndices;            // the scene lists before
+    std::vector<std::size_t> bubbleIndices;               // grouping
+    std::unique_ptr<ObjectGroup> group;                   // Held while not in the scene
+    ObjectGroup* groupPtr;                                // Same object across redo
+    bool isExecuted;
+
+public:
+    // Groups the listed objects into a new group appended to scene.groups
+    GroupCommand(Scene& target, std::vector<std::size_t> strokes, std::vector<std::size_t> characters,
+                 std::vector<std::size_t> bubbles, const std::string& groupId);
+
+    ObjectGroup* getGroup() const { return groupPtr; }
+
+    void execute() override;
+    void undo() override;
+    std::string getName() const override;
+    std::size_t memoryBytes() const override;
+};
+
+//-----------------------------------------------------------------------------
+// UNGROUP COMMAND
+//-----------------------------------------------------------------------------
+
+class UngroupCommand : public Command {
+private:
+    Scene& scene;
+    ObjectGroup* groupPtr;
+    std::unique_ptr<ObjectGroup> group;                   // Held while ungrouped
+    std::size_t index;                                    // Position in scene.groups
+    Placement groupPlacement;                             // Group transform to restore
+    std::vector<Placement> localPlacements;               // Members inside the group
+    std::size_t strokeCount, characterCount, bubbleCount;
+    bool isExecuted;
+
+public:
+    // Members are appended to the scene lists, placed where the group showed them
+    UngroupCommand(Scene& target, ObjectGroup* g);
+
+    void execute() override;
+    void undo() override;
+    std::string getName() const override;
+    std::size_t memoryBytes() const override;
 };
 
 //-----------------------------------------------------------------------------
@@ -175,6 +333,9 @@ private:
     std::vector<std::unique_ptr<Command>> undoStack;
     std::vector<std::unique_ptr<Command>> redoStack;
     static constexpr size_t maxHistorySize = 100;
+    std::function<void()> onChange;
+
+    void notifyChange();
 
 public:
     void executeCommand(std::unique_ptr<Command> cmd);
@@ -185,4 +346,11 @@ public:
     void clear();
     size_t getUndoCount() const;
     size_t getRedoCount() const;
+
+    // Both stacks and everything the commands own (see MemoryStats.h)
+    std::size_t memoryBytes() const;
+
+    // Called after every execute/undo/redo/clear (e.g. to invalidate the
+    // export scene hash, see SceneHash.h)
+    void setChangeListener(std::function<void()> listener);
 };
\ No newline at end of file
@@ -0,0 +1,71 @@
+//=============================================================================
+// ContentHash.h
+//=============================================================================
+// PURPOSE:
+//   Small, dependency-free 64-bit content hashing (FNV-1a) used to detect
+//   changed project files and assets.
+//
+// KEY FEATURES:
+//   - fnv1a64(): hash a byte range, optionally continuing a previous hash
+//   - hashValue(): fold a plain value (number, vector, color) into a hash
+//   - hashFile(): hash a file's bytes (0 if the file cannot be read)
+//   - toHex()/fromHex(): fixed-width text form used in project/journal files
+//
+// NOTES:
+//   - Not cryptographic; only meant for change detection.
+//=============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <type_traits>
+
+constexpr std::uint64_t FnvOffsetBasis = 14695981039346656037ull;
+constexpr std::uint64_t FnvPrime = 1099511628211ull;
+
+inline std::uint64_t fnv1a64(const void* data, std::size_t size, std::uint64_t hash = FnvOffsetBasis) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FnvPrime;
+    }
+    return hash;
+}
+
+inline std::uint64_t fnv1a64(const std::string& text, std::uint64_t hash = FnvOffsetBasis) {
+    return fnv1a64(text.data(), text.size(), hash);
+}
+
+// Continue `hash` with the bytes of a trivially copyable value
+template <typename T>
+inline std::uint64_t hashValue(const T& value, std::uint64_t hash = FnvOffsetBasis) {
+    static_assert(std::is_trivially_copyable<T>::value, "hashValue needs a plain value");
+    return fnv1a64(&value, sizeof(value), hash);
+}
+
+// Hash the contents of a file (returns 0 if it cannot be opened)
+inline std::uint64_t hashFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return 0;
+
+    std::uint64_t hash = FnvOffsetBasis;
+    char buffer[64 * 1024];
+    while (in) {
+        in.read(buffer, sizeof(buffer));
+        hash = fnv1a64(buffer, static_cast<std::size_t>(in.gcount()), hash);
+    }
+    return hash;
+}
+
+inline std::string toHex(std::uint64_t hash) {
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(hash));
+    return buffer;
+}
+
+inline std::uint64_t fromHex(const std::string& text) {
+    return static_cast<std::uint64_t>(std::stoull(text, nullptr, 16));
+}
@@ -0,0 +1,111 @@
+//=============================================================================
+// ExportCache.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the export cache (see ExportCache.h).
+//=============================================================================
+
+#include "ExportCache.h"
+#include "ContentHash.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+ExportCache::ExportCache(const std::string &dir, std::uintmax_t maxBytes)
+    : m_dir(dir), m_maxBytes(maxBytes)
+{
+}
+
+const std::string &ExportCache::getDirectory() const { return m_dir; }
+
+std::string ExportCache::entryPath(std::uint64_t key, const std::string &path) const
+{
+    return m_dir + "/" + toHex(key) + fs::path(path).extension().string();
+}
+
+bool ExportCache::fetch(std::uint64_t key, const std::string &path) const
+{
+    std::error_code ec;
+    const std::string entry = entryPath(key, path);
+    if (!fs::is_regular_file(entry, ec))
+        return false;
+
+    if (!fs::copy_file(entry, path, fs::copy_options::overwrite_existing, ec))
+    {
+        LOG_WARN("Cache") << "Copy failed: " << entry << " -> " << path << " (" << ec.message() << ")";
+        return false;
+    }
+    fs::last_write_time(entry, fs::file_time_type::clock::now(), ec); // LRU
+    return true;
+}
+
+void ExportCache::store(std::uint64_t key, const std::string &path)
+{
+    std::error_code ec;
+    fs::create_directories(m_dir, ec);
+
+    // Unique temporary name per thread/process, then an atomic rename
+    const std::string entry = entryPath(key, path);
+    const std::string temp = entry + ".part" +
+        toHex(std::hash<std::thread::id>()(std::this_thread::get_id()) ^
+              static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()));
+
+    if (!fs::copy_file(path, temp, fs::copy_options::overwrite_existing, ec))
+    {
+        LOG_WARN("Cache") << "Store failed: " << path << " (" << ec.message() << ")";
+        return;
+    }
+    fs::rename(temp, entry, ec);
+    if (ec)
+    {
+        fs::remove(temp, ec);
+        return;
+    }
+    evict();
+}
+
+void ExportCache::evict()
+{
+    struct Entry
+    {
+        fs::path path;
+        std::uintmax_t size;
+        fs::file_time_type time;
+    };
+
+    std::error_code ec;
+    std::vector<Entry> entries;
+    std::uintmax_t total = 0;
+    for (const auto &file : fs::directory_iterator(m_dir, ec))
+    {
+        if (!file.is_regular_file(ec) || file.path().string().find(".part") != std::string::npos)
+            continue;
+        Entry e{file.path(), file.file_size(ec), file.last_write_time(ec)};
+        total += e.size;
+        entries.push_back(std::move(e));
+    }
+    if (total <= m_maxBytes)
+        return;
+
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry &a, const Entry &b) { return a.time < b.time; });
+    std::size_t removed = 0;
+    for (const auto &e : entries)
+    {
+        if (total <= m_maxBytes)
+            break;
+        if (fs::remove(e.path, ec))
+        {
+            total -= e.size;
+            ++removed;
+        }
+    }
+    LOG_INFO("Cache") << "Evicted " << removed << " old exports from " << m_dir;
+}
@@ -0,0 +1,51 @@
+//=============================================================================
+// ExportCache.h
+//=============================================================================
+// PURPOSE:
+//   Content-addressed store of finished exports. The key combines the scene
+//   hash (SceneHash.h) with the output settings (Exporter::cacheKey()), so
+//   exporting an unchanged scene again is a file copy instead of a render
+//   plus encode.
+//
+// LAYOUT:
+//   <dir>/<16 hex digit key><extension>, e.g. SavedComics/.cache/
+//   0123456789abcdef.png. Entries are written to a temporary name and
+//   renamed, so concurrent batch workers never see partial files.
+//
+// EVICTION:
+//   Least recently used first (hits refresh the file time) once the total
+//   size exceeds the limit; checked after every store.
+//
+// WHERE TO MODIFY:
+//   - Cache location/size: Change the constructor arguments at the call site
+//   - Bump ExportCache::FormatVersion when encoder output changes
+//=============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+class ExportCache {
+public:
+    // Folded into every key: old entries stop matching when this changes
+    static constexpr std::uint32_t FormatVersion = 1;
+
+    explicit ExportCache(const std::string& dir = "SavedComics/.cache",
+                         std::uintmax_t maxBytes = 512ull * 1024 * 1024);
+
+    // Copy the entry for `key` to `path`. Returns false on a miss.
+    bool fetch(std::uint64_t key, const std::string& path) const;
+
+    // Add the finished export at `path` under `key`
+    void store(std::uint64_t key, const std::string& path);
+
+    const std::string& getDirectory() const;
+
+private:
+    std::string entryPath(std::uint64_t key, const std::string& path) const;
+    void evict();
+
+    std::string m_dir;
+    std::uintmax_t m_maxBytes;
+};
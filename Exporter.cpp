@@ -0,0 +1,299 @@
+//=============================================================================
+// Exporter.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the shared export pipeline (see Exporter.h).
+//=============================================================================
+
+#include "Exporter.h"
+#include "ContentHash.h"
+#include "FrameWatchdog.h"
+#include "Logger.h"
+#include "Scene.h"
+#include "SoftwareRenderer.h"
+#include "Telemetry.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+bool parseRenderBackend(const std::string &name, RenderBackend &out)
+{
+    if (name == "gl")           { out = RenderBackend::OpenGL;   return true; }
+    if (name == "cpu")          { out = RenderBackend::Software; return true; }
+    if (name == "compare")      { out = RenderBackend::Compare;  return true; }
+    return false;
+}
+
+Exporter::Exporter(RenderBackend backend, unsigned threads)
+    : m_backend(backend), m_threads(threads)
+{
+    m_encoder.threads = threads;
+}
+
+RenderBackend Exporter::getBackend() const { return m_backend; }
+
+void Exporter::setCompressionLevel(int level) { m_encoder.pngLevel = level; }
+
+void Exporter::setJpegQuality(int quality) { m_encoder.jpegQuality = quality; }
+
+void Exporter::setPaletteColors(unsigned colors) { m_encoder.paletteColors = colors; }
+
+void Exporter::setFormat(ImageFormat format)
+{
+    m_format = format;
+    m_hasFormat = true;
+}
+
+void Exporter::setVectorOutput(bool enabled, const SvgOptions &options)
+{
+    m_vector = enabled;
+    m_svgOptions = options;
+}
+
+bool Exporter::isVectorOutput() const { return m_vector; }
+
+std::string Exporter::getExtension() const { return m_vector ? ".svg" : imageFormatExtension(m_format); }
+
+void Exporter::setSupersample(unsigned factor, DownscaleFilter filter)
+{
+    m_supersample = std::max(1u, factor);
+    m_downscaleFilter = filter;
+}
+
+unsigned Exporter::getSupersample() const { return m_supersample; }
+
+void Exporter::setCache(ExportCache *cache) { m_cache = cache; }
+
+ExportCache *Exporter::getCache() const { return m_cache; }
+
+bool Exporter::writesVector(const std::string &path) const
+{
+    std::string ext = std::filesystem::path(path).extension().string();
+    return m_vector || ext == ".svg" || ext == ".SVG";
+}
+
+std::uint64_t Exporter::renderKey(std::uint64_t sceneHash, const ProjectCanvas &canvas,
+                                  const sf::RenderWindow *window) const
+{
+    std::uint64_t h = hashValue(canvas.origin, sceneHash);
+    h = hashValue(canvas.size, h);
+
+    // The framebuffer and the CPU rasterizer differ slightly (anti-aliasing)
+    const bool gpu = window && m_backend != RenderBackend::Software && m_supersample == 1;
+    h = hashValue(gpu, h);
+    h = hashValue(m_supersample, h);
+    if (m_supersample > 1)
+        h = hashValue(m_downscaleFilter, h);
+    return h;
+}
+
+std::uint64_t Exporter::cacheKey(std::uint64_t sceneHash, const ProjectCanvas &canvas,
+                                 const sf::RenderWindow *window, const std::string &path) const
+{
+    std::uint64_t h = hashValue(ExportCache::FormatVersion, sceneHash);
+    if (writesVector(path))
+    {
+        // Linked images/fonts are relative to the SVG's directory
+        h = hashValue(canvas.origin, h);
+        h = hashValue(canvas.size, h);
+        h = fnv1a64("svg", h);
+        h = hashValue(m_svgOptions.embedImages, h);
+        if (!m_svgOptions.embedImages)
+            h = fnv1a64(std::filesystem::absolute(path).parent_path().generic_string(), h);
+        return h;
+    }
+
+    h = renderKey(h, canvas, window);
+
+    ImageFormat format = m_format;
+    if (!m_hasFormat && !imageFormatFromPath(path, format))
+        return fnv1a64(std::filesystem::path(path).extension().string(), h); // saveToFile
+
+    h = hashValue(format, h);
+    if (format == ImageFormat::Png)
+        h = hashValue(m_encoder.pngLevel, h);
+    else if (format == ImageFormat::PngPalette)
+        h = hashValue(m_encoder.paletteColors, hashValue(m_encoder.pngLevel, h));
+    else if (format == ImageFormat::Jpeg)
+        h = hashValue(m_encoder.jpegQuality, h);
+    return h;
+}
+
+bool Exporter::render(const Scene &scene, const ProjectCanvas &canvas,
+                      const sf::RenderWindow *window, sf::Image &out) const
+{
+    TimedScope timed("export/render");
+    if (canvas.size.x == 0 || canvas.size.y == 0)
+        return false;
+
+    // CPU render of the canvas region (no GPU involved)
+    auto renderSoftware = [&]()
+    {
+        RasterSettings rs;
+        rs.size = canvas.size;
+        rs.origin = canvas.origin;
+        rs.threads = m_threads;
+        return SoftwareRenderer(rs).render(scene);
+    };
+
+    if (m_supersample > 1)
+    {
+        out = renderSupersampled(scene, canvas);
+        return true;
+    }
+
+    if (m_backend == RenderBackend::Software || !window)
+    {
+        out = renderSoftware().toImage();
+        return true;
+    }
+
+    sf::Texture texture;
+    if (!texture.resize(window->getSize())) // Check return for nodiscard
+        return false;
+    texture.update(*window);
+    sf::Image screenshot = texture.copyToImage();
+
+    // SFML 3: resize takes Vector2u, returns void
+    out.resize(canvas.size);
+
+    // SFML 3: copy takes Vector2u for dest, IntRect for source
+    bool copied = out.copy(
+        screenshot,
+        sf::Vector2u(0, 0),
+        sf::IntRect(sf::Vector2i(static_cast<int>(canvas.origin.x), static_cast<int>(canvas.origin.y)),
+                    sf::Vector2i(static_cast<int>(canvas.size.x), static_cast<int>(canvas.size.y))));
+    if (!copied)
+        return false;
+
+    if (m_backend == RenderBackend::Compare)
+    {
+        RgbaBuffer cpu = renderSoftware();
+        RasterDiff diff = SoftwareRenderer::compare(out.getPixelsPtr(), cpu.getPixelsPtr(), cpu.getSize(), 8);
+        LOG_INFO("Export") << "CPU vs OpenGL: max delta " << diff.maxChannelDelta
+                           << ", mean " << diff.meanChannelDelta
+                           << ", pixels over tolerance " << diff.pixelsOverTolerance;
+    }
+    return true;
+}
+
+sf::Image Exporter::renderSupersampled(const Scene &scene, const ProjectCanvas &canvas) const
+{
+    const unsigned f = m_supersample;
+    const Downscaler downscaler(f, m_downscaleFilter);
+    const unsigned srcWidth = canvas.size.x * f;
+    const unsigned srcHeight = canvas.size.y * f;
+
+    RgbaBuffer result(canvas.size);
+    RgbaBuffer band;
+    for (unsigned y0 = 0; y0 < canvas.size.y; y0 += SupersampleBandRows)
+    {
+        const unsigned y1 = std::min(y0 + SupersampleBandRows, canvas.size.y);
+        unsigned first, last;
+        downscaler.sourceRows(y0, y1, srcHeight, first, last);
+
+        // Only the supersampled rows this band (and its filter taps) covers
+        RasterSettings rs;
+        rs.size = {srcWidth, last - first};
+        rs.origin = canvas.origin + sf::Vector2f(0.f, static_cast<float>(first) / static_cast<float>(f));
+        rs.scale = static_cast<float>(f);
+        rs.threads = m_threads;
+        SoftwareRenderer(rs).render(scene, band);
+
+        downscaler.downscale(band.getPixelsPtr(), srcWidth, srcHeight, first, y0, y1,
+                             result.row(y0), static_cast<std::size_t>(canvas.size.x) * 4);
+    }
+    return result.toImage();
+}
+
+bool Exporter::save(const sf::Image &image, const std::string &path) const
+{
+    ImageFormat format = m_format;
+    if (!m_hasFormat && path != "-" && !imageFormatFromPath(path, format))
+        return image.saveToFile(path); // e.g. .bmp / .tga
+    return save(image.getPixelsPtr(), image.getSize(), path);
+}
+
+bool Exporter::save(const std::uint8_t *rgba, sf::Vector2u size, const std::string &path) const
+{
+    TimedScope timed("export/encode");
+    ImageFormat format = m_format;
+    if (!m_hasFormat && path != "-" && !imageFormatFromPath(path, format))
+    {
+        sf::Image image(size, rgba);
+        return image.saveToFile(path);
+    }
+
+    auto encoder = createImageEncoder(format, m_encoder);
+
+    if (path == "-")
+    {
+#ifdef _WIN32
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        std::ostringstream buffer(std::ios::binary);
+        if (!encoder->encode(rgba, size, buffer))
+            return false;
+        const std::string bytes = buffer.str();
+        bool ok = std::fwrite(bytes.data(), 1, bytes.size(), stdout) == bytes.size();
+        return std::fflush(stdout) == 0 && ok;
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    return out && encoder->encode(rgba, size, out);
+}
+
+bool Exporter::exportScene(const Scene &scene, const ProjectCanvas &canvas,
+                           const sf::RenderWindow *window, const std::string &path,
+                           std::uint64_t sceneHash) const
+{
+    TimedScope timed("export/scene");
+    TelemetryTimer telemetry(Metric::Export);
+    Telemetry::getInstance().count(Counter::Exports);
+    std::uint64_t key = 0;
+    if (m_cache && sceneHash != 0 && path != "-")
+    {
+        key = cacheKey(sceneHash, canvas, window, path);
+        if (m_cache->fetch(key, path))
+        {
+            LOG_INFO("Export") << "Unchanged scene, served from cache (" << toHex(key) << ")";
+            return true;
+        }
+    }
+
+    bool ok;
+    if (writesVector(path))
+    {
+        ok = SvgExporter(m_svgOptions).write(scene, canvas, path);
+    }
+    else
+    {
+        sf::Image image;
+        ok = render(scene, canvas, window, image) && save(image, path);
+    }
+
+    if (ok && key != 0)
+        m_cache->store(key, path);
+    return ok;
+}
+
+std::string Exporter::nextExportPath(const std::string &dir, const std::string &extension)
+{
+    namespace fs = std::filesystem;
+
+    // Create directory if it doesn't exist
+    if (!fs::exists(dir))
+    {
+        fs::create_directories(dir);
+    }
+    return dir + "/Comic_" + std::to_string(std::time(nullptr)) + extension;
+}
@@ -0,0 +1,141 @@
+//=============================================================================
+// Exporter.h
+//=============================================================================
+// PURPOSE:
+//   Shared export pipeline used by the editor's Export button and by the
+//   batch renderer: produce the canvas image, then encode it to a file.
+//
+// RENDER BACKENDS:
+//   OpenGL   - Copy the canvas region out of the window's framebuffer
+//   Software - Render the Scene with the CPU SoftwareRenderer (no GPU)
+//   Compare  - OpenGL, plus log the per-pixel difference to the CPU render
+//
+// ENCODING (see ImageEncoder.h):
+//   The format is taken from setFormat() or else the file extension:
+//   png / png8 (indexed) / qoi / jpg / raw. Unknown extensions fall back to
+//   sf::Image::saveToFile. The path "-" writes to stdout (for pipes).
+//   Vector output (.svg or setVectorOutput) skips rendering: exportScene()
+//   writes the Scene through SvgExporter.
+//
+// SUPERSAMPLING:
+//   setSupersample(2..4) renders the canvas at that scale with the CPU
+//   renderer (any backend; objects only draw to the window) in bands of
+//   SupersampleBandRows output rows, each filtered down by Downscaler as
+//   soon as it is rendered, so only one supersampled band is in memory.
+//
+// EXPORT CACHE:
+//   With setCache() and a scene hash (SceneHash.h), exportScene() first
+//   looks up cacheKey() in the ExportCache and copies a hit to the
+//   destination; misses are exported and then stored.
+//
+// WHERE TO MODIFY:
+//   - New backends: Extend RenderBackend and Exporter::render()
+//   - Output naming/location: Modify nextExportPath()
+//=============================================================================
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <string>
+
+#include "Downscaler.h"
+#include "ExportCache.h"
+#include "ImageEncoder.h"
+#include "ProjectFile.h"
+#include "SvgExporter.h"
+
+struct Scene;
+
+enum class RenderBackend
+{
+    OpenGL,
+    Software,
+    Compare
+};
+
+// Parse "gl", "cpu" or "compare" (returns false for anything else)
+bool parseRenderBackend(const std::string& name, RenderBackend& out);
+
+class Exporter {
+public:
+    static constexpr unsigned SupersampleBandRows = 64;
+
+    explicit Exporter(RenderBackend backend = RenderBackend::OpenGL, unsigned threads = 0);
+
+    RenderBackend getBackend() const;
+
+    // PNG zlib level: 0 = store, 1 = fastest ... 9 = smallest (default 6)
+    void setCompressionLevel(int level);
+
+    // JPEG quality 1..100 (default 90)
+    void setJpegQuality(int quality);
+
+    // png8 palette size limit 2..256 (default 256)
+    void setPaletteColors(unsigned colors);
+
+    // Force a format regardless of the file extension
+    void setFormat(ImageFormat format);
+
+    // Write SVG instead of a raster image
+    void setVectorOutput(bool enabled, const SvgOptions& options = SvgOptions());
+    bool isVectorOutput() const;
+
+    // Extension of the forced format (".png" if none was set)
+    std::string getExtension() const;
+
+    // Antialiasing: render at `factor`x and filter down (1 = off)
+    void setSupersample(unsigned factor, DownscaleFilter filter = DownscaleFilter::Box);
+    unsigned getSupersample() const;
+
+    // Cache used by exportScene() (not owned; nullptr disables caching)
+    void setCache(ExportCache* cache);
+    ExportCache* getCache() const;
+
+    // Hash of a render of the scene: `sceneHash` plus canvas region, backend
+    // and supersampling (what render() depends on besides the scene)
+    std::uint64_t renderKey(std::uint64_t sceneHash, const ProjectCanvas& canvas,
+                            const sf::RenderWindow* window) const;
+
+    // Cache key of exporting a scene with hash `sceneHash` to `path`: adds
+    // everything else that changes the output bytes (backend, format and
+    // its settings, canvas region)
+    std::uint64_t cacheKey(std::uint64_t sceneHash, const ProjectCanvas& canvas,
+                           const sf::RenderWindow* window, const std::string& path) const;
+
+    // Produce the image of the canvas region. `window` is only used by the
+    // OpenGL/Compare backends and must show the current frame (before UI).
+    // Returns false if nothing could be captured.
+    bool render(const Scene& scene, const ProjectCanvas& canvas,
+                const sf::RenderWindow* window, sf::Image& out) const;
+
+    // Encode `image` to `path` ("-" = stdout)
+    bool save(const sf::Image& image, const std::string& path) const;
+
+    // Same for tightly packed RGBA8 pixels (no sf::Image copy needed)
+    bool save(const std::uint8_t* rgba, sf::Vector2u size, const std::string& path) const;
+
+    // render() + save() in one step; SVG output (forced or by the .svg
+    // extension) is written straight from the scene without rendering.
+    // A non-zero `sceneHash` enables the export cache (if set).
+    bool exportScene(const Scene& scene, const ProjectCanvas& canvas,
+                     const sf::RenderWindow* window, const std::string& path,
+                     std::uint64_t sceneHash = 0) const;
+
+    // Timestamped file name inside `dir` (directory is created if missing)
+    static std::string nextExportPath(const std::string& dir, const std::string& extension = ".png");
+
+private:
+    RenderBackend m_backend;
+    unsigned m_threads;           // Renderer/encoder threads (0 = all cores)
+    EncoderSettings m_encoder;
+    bool m_hasFormat{false};
+    ImageFormat m_format{ImageFormat::Png};
+    bool m_vector{false};
+    SvgOptions m_svgOptions;
+    ExportCache* m_cache{nullptr};
+    unsigned m_supersample{1};
+    DownscaleFilter m_downscaleFilter{DownscaleFilter::Box};
+
+    bool writesVector(const std::string& path) const;
+    sf::Image renderSupersampled(const Scene& scene, const ProjectCanvas& canvas) const;
+};
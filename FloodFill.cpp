@@ -0,0 +1,132 @@
+//=============================================================================
+// FloodFill.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the scanline bucket fill (see FloodFill.h).
+//=============================================================================
+
+#include "FloodFill.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+    struct Seed
+    {
+        unsigned x, y;
+    };
+
+    bool matches(const std::uint8_t *pixel, const std::uint8_t *target, int tolerance)
+    {
+        // Most pixels of a region are exactly the seed color
+        if (std::memcmp(pixel, target, 4) == 0)
+            return true;
+        for (int c = 0; c < 4; ++c)
+        {
+            if (std::abs(static_cast<int>(pixel[c]) - static_cast<int>(target[c])) > tolerance)
+                return false;
+        }
+        return true;
+    }
+
+    // Square dilation of the mask inside `bounds` (grown by one pixel per
+    // pass); rows are read from a copy so a pass grows exactly one pixel
+    void grow(FillRegion &region, unsigned passes)
+    {
+        const int w = static_cast<int>(region.size.x), h = static_cast<int>(region.size.y);
+        std::vector<std::uint8_t> source;
+        for (unsigned pass = 0; pass < passes; ++pass)
+        {
+            sf::IntRect &b = region.bounds;
+            const int x0 = std::max(b.position.x - 1, 0), x1 = std::min(b.position.x + b.size.x + 1, w);
+            const int y0 = std::max(b.position.y - 1, 0), y1 = std::min(b.position.y + b.size.y + 1, h);
+            if (x0 >= x1 || y0 >= y1)
+                return;
+
+            source = region.mask;
+            for (int y = y0; y < y1; ++y)
+            {
+                const std::uint8_t *above = source.data() + static_cast<std::size_t>(std::max(y - 1, 0)) * w;
+                const std::uint8_t *row = source.data() + static_cast<std::size_t>(y) * w;
+                const std::uint8_t *below = source.data() + static_cast<std::size_t>(std::min(y + 1, h - 1)) * w;
+                std::uint8_t *out = region.mask.data() + static_cast<std::size_t>(y) * w;
+                for (int x = x0; x < x1; ++x)
+                {
+                    if (row[x])
+                        continue;
+                    const int l = std::max(x - 1, 0), r = std::min(x + 1, w - 1);
+                    if (above[l] | above[x] | above[r] | row[l] | row[r] | below[l] | below[x] | below[r])
+                    {
+                        out[x] = 1;
+                        ++region.pixels;
+                    }
+                }
+            }
+            b = sf::IntRect({x0, y0}, {x1 - x0, y1 - y0});
+        }
+    }
+}
+
+FillRegion floodFill(const std::uint8_t *rgba, sf::Vector2u size, sf::Vector2u seed, const FillOptions &options)
+{
+    FillRegion region;
+    region.size = size;
+    if (seed.x >= size.x || seed.y >= size.y)
+        return region;
+    region.mask.assign(static_cast<std::size_t>(size.x) * size.y, 0);
+
+    const int tolerance = static_cast<int>(std::min(options.tolerance, 255u));
+    std::uint8_t target[4];
+    std::copy_n(rgba + (static_cast<std::size_t>(seed.y) * size.x + seed.x) * 4, 4, target);
+
+    auto fillable = [&](unsigned x, unsigned y) {
+        const std::size_t i = static_cast<std::size_t>(y) * size.x + x;
+        return !region.mask[i] && matches(rgba + i * 4, target, tolerance);
+    };
+
+    unsigned minX = seed.x, maxX = seed.x, minY = seed.y, maxY = seed.y;
+    std::vector<Seed> stack{{seed.x, seed.y}};
+    while (!stack.empty())
+    {
+        const Seed s = stack.back();
+        stack.pop_back();
+        if (!fillable(s.x, s.y))
+            continue;
+
+        // Extend to the full span of this row
+        unsigned left = s.x, right = s.x;
+        while (left > 0 && fillable(left - 1, s.y))
+            --left;
+        while (right + 1 < size.x && fillable(right + 1, s.y))
+            ++right;
+        std::fill_n(region.mask.data() + static_cast<std::size_t>(s.y) * size.x + left, right - left + 1, 1);
+        region.pixels += right - left + 1;
+        minX = std::min(minX, left);
+        maxX = std::max(maxX, right);
+        minY = std::min(minY, s.y);
+        maxY = std::max(maxY, s.y);
+
+        // One seed per run of fillable pixels in the neighbouring rows
+        for (int dy : {-1, 1})
+        {
+            if ((dy < 0 && s.y == 0) || (dy > 0 && s.y + 1 >= size.y))
+                continue;
+            const unsigned y = dy < 0 ? s.y - 1 : s.y + 1;
+            bool inRun = false;
+            for (unsigned x = left; x <= right; ++x)
+            {
+                const bool open = fillable(x, y);
+                if (open && !inRun)
+                    stack.push_back({x, y});
+                inRun = open;
+            }
+        }
+    }
+
+    region.bounds = sf::IntRect({static_cast<int>(minX), static_cast<int>(minY)},
+                                {static_cast<int>(maxX - minX + 1), static_cast<int>(maxY - minY + 1)});
+    grow(region, options.grow);
+    return region;
+}
@@ -0,0 +1,49 @@
+//=============================================================================
+// FloodFill.h
+//=============================================================================
+// PURPOSE:
+//   Bucket fill for the paint layer: finds the region around a seed pixel
+//   in a render of the canvas, so large areas are colored with one fill
+//   instead of thousands of brush strokes.
+//
+// ALGORITHM:
+//   Span-based scanline fill: each popped seed is extended left and right
+//   to a full span, and the rows above and below are scanned once over
+//   that span, pushing one seed per run of matching pixels. Every pixel is
+//   tested a small constant number of times and the stack stays small;
+//   a full-page region takes a few milliseconds.
+//
+// MATCHING:
+//   A pixel belongs to the region when no channel (RGBA) differs from the
+//   seed pixel by more than `tolerance`. The mask is then grown by `grow`
+//   pixels, so the fill reaches under antialiased line art instead of
+//   leaving a light fringe (the paint layer is drawn below the strokes).
+//
+// WHERE TO MODIFY:
+//   - Matching rule (e.g. perceptual distance): Modify matches() in
+//     FloodFill.cpp
+//=============================================================================
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <vector>
+
+struct FillOptions {
+    unsigned tolerance{32};                   // Per channel, 0..255
+    unsigned grow{1};                         // Pixels added around the region
+};
+
+struct FillRegion {
+    sf::Vector2u size{0, 0};                  // Same as the source image
+    std::vector<std::uint8_t> mask;           // 1 = filled, row-major
+    sf::IntRect bounds;                       // Of the filled pixels
+    std::size_t pixels{0};
+};
+
+// Region of `rgba` (size.x * size.y pixels) connected to `seed`; empty
+// when the seed is outside the image
+FillRegion floodFill(const std::uint8_t* rgba, sf::Vector2u size, sf::Vector2u seed,
+                     const FillOptions& options = {});
@@ -0,0 +1,263 @@
+//=============================================================================
+// FrameWatchdog.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the flight recorder, TimedScope and the frame stall
+//   watchdog (see FrameWatchdog.h).
+//=============================================================================
+
+#include "FrameWatchdog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    thread_local bool t_editorThread = false;
+
+    std::string formatMs(std::int64_t ns)
+    {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3) << static_cast<double>(ns) / 1e6 << " ms";
+        return out.str();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// FlightRecorder
+//-----------------------------------------------------------------------------
+
+FlightRecorder &FlightRecorder::getInstance()
+{
+    static FlightRecorder instance;
+    return instance;
+}
+
+void FlightRecorder::setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+
+void FlightRecorder::setEditorThread() { t_editorThread = true; }
+
+std::int64_t FlightRecorder::now()
+{
+    static const auto epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+unsigned FlightRecorder::enter(const char *name, std::int64_t startNs)
+{
+    if (!t_editorThread)
+        return 0;
+    // Only the editor thread touches the stack; the watchdog just reads it
+    const unsigned depth = m_depth.load(std::memory_order_relaxed);
+    if (depth < MaxDepth)
+    {
+        m_stack[depth].name.store(name, std::memory_order_relaxed);
+        m_stack[depth].startNs.store(startNs, std::memory_order_relaxed);
+    }
+    m_depth.store(depth + 1, std::memory_order_release);
+    return depth + 1;
+}
+
+void FlightRecorder::leave(const char *name, std::int64_t startNs, unsigned depth)
+{
+    const std::int64_t end = now();
+    if (depth > 0)
+        m_depth.store(depth - 1, std::memory_order_release);
+
+    const std::uint64_t index = m_next.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = m_slots[index & (Capacity - 1)];
+    slot.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.startNs.store(startNs, std::memory_order_relaxed);
+    slot.durationNs.store(end - startNs, std::memory_order_relaxed);
+    slot.depth.store(depth > 0 ? depth - 1 : 0, std::memory_order_relaxed);
+    slot.editorThread.store(depth > 0, std::memory_order_relaxed);
+    slot.seq.store(index + 1, std::memory_order_release);
+}
+
+std::vector<FlightRecorder::Event> FlightRecorder::recent() const
+{
+    std::vector<std::pair<std::uint64_t, Event>> events;
+    events.reserve(Capacity);
+    for (const Slot &slot : m_slots)
+    {
+        const std::uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        Event e{slot.name.load(std::memory_order_relaxed), slot.startNs.load(std::memory_order_relaxed),
+                slot.durationNs.load(std::memory_order_relaxed), slot.depth.load(std::memory_order_relaxed),
+                slot.editorThread.load(std::memory_order_relaxed)};
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq != 0 && seq == slot.seq.load(std::memory_order_relaxed) && e.name)
+            events.emplace_back(seq, e);
+    }
+    std::sort(events.begin(), events.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    std::vector<Event> result;
+    result.reserve(events.size());
+    for (const auto &e : events)
+        result.push_back(e.second);
+    return result;
+}
+
+std::vector<FlightRecorder::OpenScope> FlightRecorder::openScopes() const
+{
+    std::vector<OpenScope> scopes;
+    const unsigned depth = std::min<unsigned>(m_depth.load(std::memory_order_acquire), MaxDepth);
+    for (unsigned i = 0; i < depth; ++i)
+        scopes.push_back({m_stack[i].name.load(std::memory_order_relaxed),
+                          m_stack[i].startNs.load(std::memory_order_relaxed)});
+    return scopes;
+}
+
+//-----------------------------------------------------------------------------
+// TimedScope
+//-----------------------------------------------------------------------------
+
+TimedScope::TimedScope(const char *name) : m_name(name)
+{
+    FlightRecorder &recorder = FlightRecorder::getInstance();
+    if (!recorder.isEnabled())
+        return;
+    m_start = FlightRecorder::now();
+    m_depth = recorder.enter(name, m_start);
+}
+
+void TimedScope::end()
+{
+    if (m_start < 0)
+        return;
+    FlightRecorder::getInstance().leave(m_name, m_start, m_depth);
+    m_start = -1;
+}
+
+//-----------------------------------------------------------------------------
+// FrameWatchdog
+//-----------------------------------------------------------------------------
+
+FrameWatchdog::FrameWatchdog(const WatchdogOptions &options) : m_options(options)
+{
+    if (m_options.stallMs <= 0.0)
+        return;
+
+    FlightRecorder &recorder = FlightRecorder::getInstance();
+    recorder.setEditorThread();
+    recorder.setEnabled(true);
+    m_lastFrameNs.store(FlightRecorder::now(), std::memory_order_relaxed);
+    m_thread = std::thread([this]() { watch(); });
+}
+
+FrameWatchdog::~FrameWatchdog()
+{
+    if (!m_thread.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    m_thread.join();
+    FlightRecorder::getInstance().setEnabled(false);
+}
+
+void FrameWatchdog::frameCompleted()
+{
+    if (!m_thread.joinable())
+        return;
+
+    const std::int64_t now = FlightRecorder::now();
+    const std::int64_t start = m_lastFrameNs.exchange(now, std::memory_order_relaxed);
+    const std::uint64_t frame = m_frame.fetch_add(1, std::memory_order_release);
+
+    // The watchdog dumped this frame: record how long the stall lasted
+    if (m_dumpedFrame.load(std::memory_order_acquire) != frame + 1)
+        return;
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        path = m_dumpPath;
+    }
+    std::ofstream out(path, std::ios::app);
+    out << "\nFrame completed after " << formatMs(now - start) << "\n";
+    std::cerr << "[Watchdog] Frame " << frame << " took " << formatMs(now - start) << " (see " << path << ")"
+              << std::endl;
+}
+
+void FrameWatchdog::watch()
+{
+    const auto period = std::chrono::duration<double, std::milli>(m_options.stallMs / 4.0);
+    const auto threshold = static_cast<std::int64_t>(m_options.stallMs * 1e6);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stop)
+    {
+        m_wake.wait_for(lock, period);
+        if (m_stop)
+            break;
+
+        // Frame first: a frame counter that moved on guarantees a new start
+        const std::uint64_t frame = m_frame.load(std::memory_order_acquire);
+        const std::int64_t start = m_lastFrameNs.load(std::memory_order_relaxed);
+        const std::int64_t stalled = FlightRecorder::now() - start;
+        if (stalled < threshold || m_dumpedFrame.load(std::memory_order_relaxed) == frame + 1 ||
+            m_dumps >= m_options.maxDumps)
+            continue;
+
+        // Write without the lock: frameCompleted() takes it on the editor
+        // thread, and a slow disk must not extend the stall it reports
+        lock.unlock();
+        const std::string path = dump(frame, start, stalled);
+        lock.lock();
+        m_dumpPath = path;
+        ++m_dumps;
+        m_dumpedFrame.store(frame + 1, std::memory_order_release);
+    }
+}
+
+std::string FrameWatchdog::dump(std::uint64_t frame, std::int64_t frameStartNs, std::int64_t stalledNs)
+{
+    // Copy the ring and the scope stack first; formatting works on the copy
+    const FlightRecorder &recorder = FlightRecorder::getInstance();
+    const auto scopes = recorder.openScopes();
+    const auto events = recorder.recent();
+    const std::int64_t now = FlightRecorder::now();
+
+    std::time_t t = std::time(nullptr);
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", std::localtime(&t));
+    std::error_code ec;
+    fs::create_directories(m_options.dumpDir, ec);
+    const std::string path =
+        (fs::path(m_options.dumpDir) / ("stall_" + std::string(stamp) + "_" + std::to_string(frame) + ".txt")).string();
+
+    std::ofstream out(path);
+    out << "STALL frame " << frame << ": no frame completed for " << formatMs(stalledNs) << " (threshold "
+        << m_options.stallMs << " ms)\n";
+    out << "Detected " << stamp << "\n\n";
+
+    out << "Current operation (outermost first):\n";
+    if (scopes.empty())
+        out << "  (no scope open: uninstrumented code, or the window is being moved/resized)\n";
+    for (std::size_t i = 0; i < scopes.size(); ++i)
+        out << "  " << std::string(i * 2, ' ') << std::left << std::setw(32) << scopes[i].name << std::right
+            << " running for " << formatMs(now - scopes[i].startNs) << "\n";
+
+    out << "\nRecent timings (oldest first; start relative to the last completed frame, duration):\n";
+    for (const auto &e : events)
+        out << (e.editorThread ? "  " : "* ") << std::setw(14) << formatMs(e.startNs - frameStartNs)
+            << std::setw(14) << formatMs(e.durationNs) << "  " << std::string(e.depth * 2, ' ') << e.name << "\n";
+
+    if (!out)
+        std::cerr << "[Watchdog] Cannot write " << path << std::endl;
+    else
+        std::cerr << "[Watchdog] Frame " << frame << " stalled for " << formatMs(stalledNs)
+                  << ", flight recorder written to " << path << std::endl;
+    return path;
+}
@@ -0,0 +1,168 @@
+//=============================================================================
+// FrameWatchdog.h
+//=============================================================================
+// PURPOSE:
+//   Finds out what the editor was doing when it froze. Hot paths are wrapped
+//   in TimedScope objects that record their timings into a small lock-free
+//   ring buffer (the flight recorder); a watchdog thread notices when the
+//   main loop has not completed a frame for `stallMs` and writes the ring
+//   and the operation in progress to a text file.
+//
+// KEY FEATURES:
+//   - TimedScope("export/render"): records name, start and duration on exit
+//   - Scopes opened on the editor thread also form the "current operation"
+//     stack, so a dump shows e.g. frame/draw > export/scene > export/render
+//     even while export/render is still running
+//   - One dump per stalled frame in <dumpDir>/stall_<time>_<frame>.txt;
+//     the main thread appends the total stall time once the frame ends
+//
+// OVERHEAD:
+//   Without a running watchdog a scope is one relaxed atomic load. With it,
+//   two steady_clock reads and a handful of relaxed atomic stores; nothing
+//   locks or allocates. The watchdog thread wakes every stallMs / 4.
+//
+// DUMP FORMAT:
+//   Header (frame, stall time, threshold), the open scopes outermost first
+//   with their running time, then the last FlightRecorder::Capacity timings
+//   oldest first, relative to the end of the last completed frame
+//   ('*' marks timings from other threads).
+//
+// WHERE TO MODIFY:
+//   - New instrumentation: Add a TimedScope at the top of the function
+//   - Dump contents: Modify FrameWatchdog::dump()
+//
+// NOTES:
+//   - Scope names must be string literals (only the pointer is stored)
+//   - Ring slots use a per-slot sequence number: a slot being overwritten
+//     while the dump reads it is skipped instead of printed torn
+//=============================================================================
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class FlightRecorder {
+public:
+    static constexpr std::size_t Capacity = 1024;     // Power of two
+    static constexpr std::size_t MaxDepth = 16;       // Deeper scopes are timed only
+
+    struct Event {
+        const char* name;
+        std::int64_t startNs;
+        std::int64_t durationNs;
+        unsigned depth;                               // Nesting on the editor thread
+        bool editorThread;
+    };
+
+    struct OpenScope {
+        const char* name;
+        std::int64_t startNs;
+    };
+
+    static FlightRecorder& getInstance();
+
+    // Recording is off until a watchdog runs
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    // Scopes of the calling thread make up the current operation
+    void setEditorThread();
+
+    // Nanoseconds since the recorder was created
+    static std::int64_t now();
+
+    // Recorded timings, oldest first
+    std::vector<Event> recent() const;
+
+    // Scopes still running on the editor thread, outermost first
+    std::vector<OpenScope> openScopes() const;
+
+private:
+    friend class TimedScope;
+
+    struct Slot {
+        std::atomic<std::uint64_t> seq{0};            // 0 = being written
+        std::atomic<const char*> name{nullptr};
+        std::atomic<std::int64_t> startNs{0};
+        std::atomic<std::int64_t> durationNs{0};
+        std::atomic<unsigned> depth{0};
+        std::atomic<bool> editorThread{false};
+    };
+
+    struct StackEntry {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<std::int64_t> startNs{0};
+    };
+
+    FlightRecorder() = default;
+
+    unsigned enter(const char* name, std::int64_t startNs);
+    void leave(const char* name, std::int64_t startNs, unsigned depth);
+
+    std::atomic<bool> m_enabled{false};
+    std::atomic<std::uint64_t> m_next{0};
+    std::array<Slot, Capacity> m_slots;
+    std::atomic<unsigned> m_depth{0};
+    std::array<StackEntry, MaxDepth> m_stack;
+};
+
+class TimedScope {
+public:
+    explicit TimedScope(const char* name);
+    ~TimedScope() { end(); }
+
+    TimedScope(const TimedScope&) = delete;
+    TimedScope& operator=(const TimedScope&) = delete;
+
+    // Close the scope before the end of the block (idempotent)
+    void end();
+
+private:
+    const char* m_name;
+    std::int64_t m_start{-1};                         // -1 = not recording
+    unsigned m_depth{0};
+};
+
+struct WatchdogOptions {
+    double stallMs{250.0};                            // <= 0 disables the watchdog
+    std::string dumpDir{"SavedComics/stalls"};
+    unsigned maxDumps{20};                            // Per session
+};
+
+class FrameWatchdog {
+public:
+    // Call on the editor thread; starts the watchdog thread
+    explicit FrameWatchdog(const WatchdogOptions& options);
+    ~FrameWatchdog();
+
+    FrameWatchdog(const FrameWatchdog&) = delete;
+    FrameWatchdog& operator=(const FrameWatchdog&) = delete;
+
+    // Call once at the end of every main loop iteration
+    void frameCompleted();
+
+private:
+    void watch();
+    // Called without m_mutex held; returns the file written
+    std::string dump(std::uint64_t frame, std::int64_t frameStartNs, std::int64_t stalledNs);
+
+    WatchdogOptions m_options;
+    std::atomic<std::int64_t> m_lastFrameNs{0};
+    std::atomic<std::uint64_t> m_frame{0};
+    std::atomic<std::uint64_t> m_dumpedFrame{0};      // Frame + 1 of the last dump
+
+    std::mutex m_mutex;                               // Guards the fields below
+    std::condition_variable m_wake;
+    bool m_stop{false};
+    std::string m_dumpPath;
+    unsigned m_dumps{0};
+
+    std::thread m_thread;
+};
@@ -0,0 +1,239 @@
+//=============================================================================
+// GlyphCache.cpp
+//=============================================================================
+// PURPOSE:
+//   FreeType-backed implementation of the CPU glyph cache.
+//
+// NOTES:
+//   - Load flags, advance rounding and kerning math mirror SFML 3's
+//     sf::Font so software-rendered text lines up with the OpenGL path.
+//   - Faces are opened on first use and kept open; FreeType faces are not
+//     thread-safe, which is why every public call takes the mutex.
+//=============================================================================
+
+#include "GlyphCache.h"
+#include "Logger.h"
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_GLYPH_H
+
+#include <algorithm>
+#include <cmath>
+
+struct GlyphCache::FaceHandle {
+    FT_Face face{nullptr};
+    unsigned currentSize{0};
+};
+
+GlyphCache& GlyphCache::getInstance() {
+    static GlyphCache instance;
+    return instance;
+}
+
+GlyphCache::GlyphCache() {
+    FT_Library library = nullptr;
+    if (FT_Init_FreeType(&library) != 0) {
+        LOG_ERROR("GlyphCache") << "Failed to initialize FreeType";
+        return;
+    }
+    m_library = library;
+}
+
+GlyphCache::~GlyphCache() {
+    for (auto& entry : m_faces) {
+        if (entry.second && entry.second->face) FT_Done_Face(entry.second->face);
+    }
+    if (m_library) FT_Done_FreeType(static_cast<FT_Library>(m_library));
+}
+
+GlyphCache::FaceHandle* GlyphCache::openFace(const std::string& fontPath) {
+    auto it = m_faces.find(fontPath);
+    if (it != m_faces.end()) return it->second.get();
+    if (!m_library || fontPath.empty()) return nullptr;
+
+    FT_Face face = nullptr;
+    if (FT_New_Face(static_cast<FT_Library>(m_library), fontPath.c_str(), 0, &face) != 0) {
+        LOG_WARN("GlyphCache") << "Failed to open font: " << fontPath;
+        return nullptr;
+    }
+    FT_Select_Charmap(face, FT_ENCODING_UNICODE);
+
+    auto handle = std::make_unique<FaceHandle>();
+    handle->face = face;
+    FaceHandle* raw = handle.get();
+    m_faces[fontPath] = std::move(handle);
+    return raw;
+}
+
+bool GlyphCache::setSize(FaceHandle& handle, unsigned characterSize) {
+    if (handle.currentSize == characterSize) return true;
+    if (FT_Set_Pixel_Sizes(handle.face, 0, characterSize) != 0) return false;
+    handle.currentSize = characterSize;
+    return true;
+}
+
+const GlyphBitmap* GlyphCache::getGlyph(const std::string& fontPath,
+                                        unsigned characterSize,
+                                        char32_t codePoint) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return getGlyphLocked(fontPath, characterSize, codePoint);
+}
+
+const GlyphBitmap* GlyphCache::getGlyphLocked(const std::string& fontPath,
+                                              unsigned characterSize,
+                                              char32_t codePoint) {
+    GlyphKey key{fontPath, characterSize, codePoint};
+    auto cached = m_glyphs.find(key);
+    if (cached != m_glyphs.end()) return cached->second.get();
+
+    FaceHandle* handle = openFace(fontPath);
+    if (!handle || !setSize(*handle, characterSize)) return nullptr;
+
+    auto glyph = std::make_unique<GlyphBitmap>();
+
+    // Same flags as sf::Font::loadGlyph (regular weight, no outline)
+    FT_Face face = handle->face;
+    if (FT_Load_Char(face, codePoint, FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT) == 0) {
+        FT_Glyph desc = nullptr;
+        if (FT_Get_Glyph(face->glyph, &desc) == 0) {
+            if (FT_Glyph_To_Bitmap(&desc, FT_RENDER_MODE_NORMAL, nullptr, 1) == 0) {
+                auto* bitmapGlyph = reinterpret_cast<FT_BitmapGlyph>(desc);
+                const FT_Bitmap& bitmap = bitmapGlyph->bitmap;
+
+                glyph->advance  = static_cast<float>(bitmapGlyph->root.advance.x >> 16);
+                glyph->lsbDelta = static_cast<int>(face->glyph->lsb_delta);
+                glyph->rsbDelta = static_cast<int>(face->glyph->rsb_delta);
+                glyph->left     = bitmapGlyph->left;
+                glyph->top      = -bitmapGlyph->top;
+                glyph->width    = bitmap.width;
+                glyph->height   = bitmap.rows;
+                glyph->coverage.resize(static_cast<std::size_t>(bitmap.width) * bitmap.rows);
+
+                const unsigned char* row = bitmap.buffer;
+                for (unsigned y = 0; y < bitmap.rows; ++y) {
+                    std::uint8_t* dst = glyph->coverage.data() + static_cast<std::size_t>(y) * bitmap.width;
+                    for (unsigned x = 0; x < bitmap.width; ++x) {
+                        if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+                            dst[x] = ((row[x / 8] >> (7 - (x % 8))) & 1) ? 255 : 0;
+                        else
+                            dst[x] = row[x];
+                    }
+                    row += bitmap.pitch;
+                }
+            }
+            FT_Done_Glyph(desc);
+        }
+    }
+
+    const GlyphBitmap* raw = glyph.get();
+    m_glyphs[key] = std::move(glyph);
+    return raw;
+}
+
+float GlyphCache::getKerning(const std::string& fontPath, unsigned characterSize,
+                             char32_t first, char32_t second) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return getKerningLocked(fontPath, characterSize, first, second);
+}
+
+float GlyphCache::getKerningLocked(const std::string& fontPath, unsigned characterSize,
+                                   char32_t first, char32_t second) {
+    if (first == 0 || second == 0) return 0.f;
+
+    FaceHandle* handle = openFace(fontPath);
+    if (!handle || !setSize(*handle, characterSize)) return 0.f;
+
+    const GlyphBitmap* firstGlyph  = getGlyphLocked(fontPath, characterSize, first);
+    const GlyphBitmap* secondGlyph = getGlyphLocked(fontPath, characterSize, second);
+
+    FT_Face face = handle->face;
+    FT_Vector kerning{0, 0};
+    if (FT_HAS_KERNING(face)) {
+        FT_Get_Kerning(face, FT_Get_Char_Index(face, first), FT_Get_Char_Index(face, second),
+                       FT_KERNING_UNFITTED, &kerning);
+    }
+    if (!FT_IS_SCALABLE(face)) return static_cast<float>(kerning.x);
+
+    float firstRsb  = firstGlyph ? static_cast<float>(firstGlyph->rsbDelta) : 0.f;
+    float secondLsb = secondGlyph ? static_cast<float>(secondGlyph->lsbDelta) : 0.f;
+    return std::floor((secondLsb - firstRsb + static_cast<float>(kerning.x) + 32.f) / 64.f);
+}
+
+float GlyphCache::getLineSpacing(const std::string& fontPath, unsigned characterSize) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FaceHandle* handle = openFace(fontPath);
+    if (!handle || !setSize(*handle, characterSize)) return 0.f;
+    return static_cast<float>(handle->face->size->metrics.height) / 64.f;
+}
+
+TextLayout GlyphCache::layoutText(const std::string& fontPath,
+                                  unsigned characterSize,
+                                  const std::string& text) {
+    TextLayout layout;
+    if (text.empty()) return layout;
+
+    float lineSpacing = getLineSpacing(fontPath, characterSize);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const GlyphBitmap* space = getGlyphLocked(fontPath, characterSize, U' ');
+    float whitespaceWidth = space ? space->advance : 0.f;
+
+    // Mirrors sf::Text::ensureGeometryUpdate()
+    float size = static_cast<float>(characterSize);
+    float x = 0.f, y = size;
+    float minX = size, minY = size, maxX = 0.f, maxY = 0.f;
+    char32_t prev = 0;
+
+    layout.glyphs.reserve(text.size());
+    for (unsigned char byte : text) {
+        char32_t c = byte;
+        if (c == U'\r') continue;
+
+        x += getKerningLocked(fontPath, characterSize, prev, c);
+        prev = c;
+
+        if (c == U' ' || c == U'\n' || c == U'\t') {
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+            if (c == U' ') x += whitespaceWidth;
+            else if (c == U'\t') x += whitespaceWidth * 4.f;
+            else { y += lineSpacing; x = 0.f; }
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+            continue;
+        }
+
+        const GlyphBitmap* glyph = getGlyphLocked(fontPath, characterSize, c);
+        if (!glyph) continue;
+        layout.glyphs.push_back({glyph, {x, y}});
+
+        float left = static_cast<float>(glyph->left);
+        float top = static_cast<float>(glyph->top);
+        minX = std::min(minX, x + left);
+        maxX = std::max(maxX, x + left + static_cast<float>(glyph->width));
+        minY = std::min(minY, y + top);
+        maxY = std::max(maxY, y + top + static_cast<float>(glyph->height));
+
+        x += glyph->advance;
+    }
+
+    layout.bounds = sf::FloatRect({minX, minY}, {maxX - minX, maxY - minY});
+    return layout;
+}
+
+float GlyphCache::measureWidth(const std::string& fontPath,
+                               unsigned characterSize,
+                               const std::string& text) {
+    return layoutText(fontPath, characterSize, text).bounds.size.x;
+}
+
+std::size_t GlyphCache::memoryBytes(std::size_t* glyphCount) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::size_t bytes = 0;
+    for (const auto& [key, glyph] : m_glyphs) {
+        bytes += sizeof(GlyphBitmap) + glyph->coverage.capacity() + std::get<0>(key).capacity();
+    }
+    if (glyphCount) *glyphCount = m_glyphs.size();
+    return bytes;
+}
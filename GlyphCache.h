@@ -0,0 +1,109 @@
+//=============================================================================
+// GlyphCache.h
+//=============================================================================
+// PURPOSE:
+//   CPU glyph rasterization and text layout using FreeType directly.
+//   sf::Font needs an OpenGL context to build its glyph pages, so the
+//   software renderer and headless text measurement use this cache instead.
+//
+// KEY FEATURES:
+//   - Singleton access via getInstance() (same pattern as AssetManager)
+//   - Glyph coverage bitmaps cached per (font file, pixel size, code point)
+//   - layoutText() reproduces sf::Text placement and local bounds
+//     (kerning, whitespace advance, line spacing) so both paths agree
+//   - Thread-safe: lookups are serialized by an internal mutex and returned
+//     glyph pointers stay valid for the cache lifetime
+//
+// WHERE TO MODIFY:
+//   - Change hinting: Adjust load flags in rasterize()
+//   - Add bold/outline styles: Extend the glyph key and rasterize()
+//=============================================================================
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// One rasterized glyph (8-bit coverage, row-major, width * height bytes)
+struct GlyphBitmap {
+    float advance{0.f};       // Horizontal pen advance in pixels
+    int lsbDelta{0};          // Auto-hinter side bearing deltas (26.6)
+    int rsbDelta{0};
+    int left{0};              // Bitmap offset from pen position
+    int top{0};               // (top is negative above the baseline)
+    unsigned width{0};
+    unsigned height{0};
+    std::vector<std::uint8_t> coverage;
+};
+
+// Glyph positioned by layoutText() (pen position on the baseline)
+struct PlacedGlyph {
+    const GlyphBitmap* glyph{nullptr};
+    sf::Vector2f pen;
+};
+
+// Result of laying out a string exactly like sf::Text would
+struct TextLayout {
+    std::vector<PlacedGlyph> glyphs;
+    sf::FloatRect bounds;     // Equivalent of sf::Text::getLocalBounds()
+};
+
+class GlyphCache {
+public:
+    static GlyphCache& getInstance();
+
+    GlyphCache(const GlyphCache&) = delete;
+    GlyphCache& operator=(const GlyphCache&) = delete;
+
+    // Get (and cache) the glyph for a code point.
+    // Returns nullptr if the font file cannot be opened.
+    const GlyphBitmap* getGlyph(const std::string& fontPath,
+                                unsigned characterSize,
+                                char32_t codePoint);
+
+    // Same semantics as sf::Font::getKerning / getLineSpacing
+    float getKerning(const std::string& fontPath, unsigned characterSize,
+                     char32_t first, char32_t second);
+    float getLineSpacing(const std::string& fontPath, unsigned characterSize);
+
+    // Place every glyph of `text` (bytes are treated as Latin-1 like
+    // sf::String does for std::string) and compute its local bounds
+    TextLayout layoutText(const std::string& fontPath,
+                          unsigned characterSize,
+                          const std::string& text);
+
+    // Width of the local bounds only (used by headless word wrapping)
+    float measureWidth(const std::string& fontPath,
+                       unsigned characterSize,
+                       const std::string& text);
+
+    // Bytes of the cached glyph bitmaps (see MemoryStats.h)
+    std::size_t memoryBytes(std::size_t* glyphCount = nullptr);
+
+private:
+    GlyphCache();
+    ~GlyphCache();
+
+    struct FaceHandle;
+    using GlyphKey = std::tuple<std::string, unsigned, char32_t>;
+
+    FaceHandle* openFace(const std::string& fontPath);
+    bool setSize(FaceHandle& face, unsigned characterSize);
+    const GlyphBitmap* getGlyphLocked(const std::string& fontPath,
+                                      unsigned characterSize,
+                                      char32_t codePoint);
+    float getKerningLocked(const std::string& fontPath, unsigned characterSize,
+                           char32_t first, char32_t second);
+
+    void* m_library{nullptr};                                 // FT_Library
+    std::map<std::string, std::unique_ptr<FaceHandle>> m_faces;
+    std::map<GlyphKey, std::unique_ptr<GlyphBitmap>> m_glyphs;
+    std::mutex m_mutex;
+};
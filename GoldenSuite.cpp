@@ -0,0 +1,451 @@
+//=============================================================================
+// GoldenSuite.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the golden-image render regression check (see
+//   GoldenSuite.h).
+//=============================================================================
+
+#include "GoldenSuite.h"
+#include "BatchRenderer.h"
+#include "Downscaler.h"
+#include "Exporter.h"
+#include "ProjectFile.h"
+#include "Scene.h"
+#include "SceneGenerator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    struct CorpusScene
+    {
+        std::string name;
+        Scene scene;
+        ProjectCanvas canvas;
+        unsigned supersample{1};
+    };
+
+    std::unique_ptr<CorpusScene> generated(const std::string &name, SceneGeneratorOptions options,
+                                           unsigned supersample = 1)
+    {
+        auto c = std::make_unique<CorpusScene>();
+        c->name = name;
+        SceneGenerator(options).generate(c->scene);
+        c->canvas.size = options.area;
+        c->supersample = supersample;
+        return c;
+    }
+
+    SceneGeneratorOptions only(std::size_t strokes, std::size_t characters, std::size_t bubbles,
+                               std::uint64_t seed, sf::Vector2u area)
+    {
+        SceneGeneratorOptions o;
+        o.strokes = strokes;
+        o.characters = characters;
+        o.bubbles = bubbles;
+        o.seed = seed;
+        o.area = area;
+        return o;
+    }
+
+    // Reference scenes: one per object kind, a mixed page, a dense page
+    // and the supersampled export path
+    std::vector<std::unique_ptr<CorpusScene>> corpus(const std::string &dir)
+    {
+        std::vector<std::unique_ptr<CorpusScene>> scenes;
+        scenes.push_back(generated("strokes_400", only(400, 0, 0, 11, {1024, 768})));
+        scenes.push_back(generated("characters_30", only(0, 30, 0, 12, {1024, 768})));
+        scenes.push_back(generated("bubbles_60", only(0, 0, 60, 13, {1024, 768})));
+        auto page = SceneGeneratorOptions::forObjectCount(60, 14);
+        page.area = {800, 600};
+        scenes.push_back(generated("page_60", page));
+        scenes.push_back(generated("page_60_ss4", page, 4));
+        auto dense = SceneGeneratorOptions::forObjectCount(5000, 15);
+        scenes.push_back(generated("dense_5000", dense));
+
+        const fs::path projects = fs::path(dir) / "scenes";
+        if (fs::exists(projects))
+        {
+            std::vector<fs::path> files;
+            for (const auto &entry : fs::directory_iterator(projects))
+                if (entry.is_regular_file() && entry.path().extension() == ".comic")
+                    files.push_back(entry.path());
+            std::sort(files.begin(), files.end());
+            for (const auto &file : files)
+            {
+                auto c = std::make_unique<CorpusScene>();
+                c->name = "scene_" + file.stem().string();
+                c->canvas = loadProject(file.string(), c->scene);
+                scenes.push_back(std::move(c));
+            }
+        }
+        return scenes;
+    }
+
+    // YIQ of an RGBA pixel blended on white (pixelmatch's color space)
+    void yiq(const std::uint8_t *p, double &y, double &i, double &q)
+    {
+        const double a = p[3] / 255.0;
+        const double r = 255.0 + (p[0] - 255.0) * a;
+        const double g = 255.0 + (p[1] - 255.0) * a;
+        const double b = 255.0 + (p[2] - 255.0) * a;
+        y = r * 0.29889531 + g * 0.58662247 + b * 0.11448223;
+        i = r * 0.59597799 - g * 0.27417610 - b * 0.32180189;
+        q = r * 0.21147017 - g * 0.52261711 + b * 0.31114694;
+    }
+
+    constexpr double MaxYiqDelta = 35215.0;   // Black vs white
+
+    // Id and placement of one object, for comparing a scene with its reload
+    struct Placed
+    {
+        std::string id;
+        sf::Vector2f position, size;
+        bool flipped;
+    };
+
+    template <typename Objects>
+    void addPlaced(std::vector<Placed> &out, const Objects &objects)
+    {
+        for (const auto &o : objects)
+            out.push_back({o->getId(), o->getPosition(), o->getSize(), o->isFlipped()});
+    }
+
+    // Top-level objects, then each group followed by its members (local space)
+    std::vector<Placed> placements(const Scene &scene)
+    {
+        std::vector<Placed> out;
+        addPlaced(out, scene.strokes);
+        addPlaced(out, scene.characters);
+        addPlaced(out, scene.bubbles);
+        for (const auto &g : scene.groups)
+        {
+            out.push_back({g->getId(), g->getPosition(), g->getSize(), g->isFlipped()});
+            addPlaced(out, g->members().strokes);
+            addPlaced(out, g->members().characters);
+            addPlaced(out, g->members().bubbles);
+        }
+        return out;
+    }
+
+    // Stroke rects are rebuilt from saved points, so allow float noise
+    bool samePlacement(const Placed &a, const Placed &b)
+    {
+        constexpr float Epsilon = 0.01f;
+        return a.id == b.id && a.flipped == b.flipped && std::abs(a.position.x - b.position.x) <= Epsilon &&
+               std::abs(a.position.y - b.position.y) <= Epsilon && std::abs(a.size.x - b.size.x) <= Epsilon &&
+               std::abs(a.size.y - b.size.y) <= Epsilon;
+    }
+
+    // Save -> load of a project with every record kind: paint tiles, loose
+    // strokes/characters/bubbles and a moved, resized, flipped group.
+    // Returns an empty string on success, else what differed
+    std::string checkProjectRoundTrip(const std::string &dir)
+    {
+        Scene scene;
+        auto options = SceneGeneratorOptions::forObjectCount(40, 16);
+        options.area = {800, 600};
+        SceneGenerator(options).generate(scene);
+        scene.paint = std::make_unique<PaintLayer>();
+        scene.paint->segment({20.f, 20.f}, {400.f, 300.f}, 8.f, sf::Color(200, 40, 40));
+
+        Scene members;
+        for (int i = 0; i < 4; ++i)
+        {
+            members.strokes.push_back(std::move(scene.strokes.back()));
+            scene.strokes.pop_back();
+        }
+        members.characters.push_back(std::move(scene.characters.back()));
+        scene.characters.pop_back();
+        members.bubbles.push_back(std::move(scene.bubbles.back()));
+        scene.bubbles.pop_back();
+        auto group = std::make_unique<ObjectGroup>("group_1", std::move(members));
+        group->setSize(group->getSize() * 1.5f);
+        group->setPosition(group->getPosition() + sf::Vector2f(40.f, 25.f));
+        group->setFlipped(true);
+        scene.groups.push_back(std::move(group));
+
+        ProjectCanvas canvas;
+        canvas.size = options.area;
+        const std::string path = (fs::path(dir) / "roundtrip.comic").string();
+        saveProject(path, scene, canvas);
+        Scene loaded;
+        const ProjectCanvas loadedCanvas = loadProject(path, loaded);
+        fs::remove(path);
+
+        if (loadedCanvas.size != canvas.size || loadedCanvas.origin != canvas.origin)
+            return "canvas differs";
+        if (!loaded.paint || loaded.paint->tiles().size() != scene.paint->tiles().size())
+            return "paint tile count differs";
+        if (loaded.strokes.size() != scene.strokes.size() || loaded.characters.size() != scene.characters.size() ||
+            loaded.bubbles.size() != scene.bubbles.size() || loaded.groups.size() != scene.groups.size())
+            return "object counts differ";
+        if (loaded.groups.front()->memberCount() != scene.groups.front()->memberCount())
+            return "group member count differs";
+
+        const std::vector<Placed> expected = placements(scene), actual = placements(loaded);
+        for (std::size_t i = 0; i < expected.size(); ++i)
+            if (!samePlacement(expected[i], actual[i]))
+                return "placement of " + expected[i].id + " differs";
+        return {};
+    }
+
+    // --export x.jpg without --format: the exporter is configured as main()
+    // does and must write JPEG bytes (SOI marker FF D8), not PNG.
+    // Returns an empty string on success, else what was written
+    std::string checkExportByExtension(const std::string &dir)
+    {
+        Scene scene;
+        auto options = SceneGeneratorOptions::forObjectCount(10, 3);
+        options.area = {64, 48};
+        SceneGenerator(options).generate(scene);
+        ProjectCanvas canvas;
+        canvas.size = options.area;
+
+        Exporter exporter(RenderBackend::Software, 1);
+        configureExporter(exporter, BatchOptions());
+        const std::string path = (fs::path(dir) / "extension_check.jpg").string();
+        if (!exporter.exportScene(scene, canvas, nullptr, path))
+            return "export failed";
+
+        unsigned char soi[2] = {0, 0};
+        {
+            std::ifstream in(path, std::ios::binary);
+            in.read(reinterpret_cast<char *>(soi), 2);
+        }
+        fs::remove(path);
+        if (soi[0] != 0xFF || soi[1] != 0xD8)
+        {
+            std::ostringstream got;
+            got << "no JPEG SOI marker (" << std::hex << std::setfill('0') << std::setw(2) << int(soi[0]) << " "
+                << std::setw(2) << int(soi[1]) << ")";
+            return got.str();
+        }
+        return {};
+    }
+}
+
+GoldenSuite::GoldenSuite(const GoldenOptions &options) : m_options(options)
+{
+    m_options.runs = std::max(1u, m_options.runs);
+}
+
+std::string GoldenSuite::goldenPath(const std::string &name) const
+{
+    return (fs::path(m_options.dir) / (name + ".png")).string();
+}
+
+std::string GoldenSuite::diffPath(const std::string &name) const
+{
+    return (fs::path(m_options.dir) / "diff" / (name + ".png")).string();
+}
+
+std::string GoldenSuite::manifestPath() const { return (fs::path(m_options.dir) / "golden.txt").string(); }
+
+GoldenDiff GoldenSuite::compare(const std::uint8_t *expected, const std::uint8_t *actual, sf::Vector2u size,
+                                double threshold)
+{
+    GoldenDiff diff;
+    diff.diffImage = sf::Image(size, sf::Color::White);
+    const double limit = MaxYiqDelta * threshold * threshold;
+
+    for (unsigned py = 0; py < size.y; ++py)
+    {
+        for (unsigned px = 0; px < size.x; ++px)
+        {
+            const std::size_t o = (static_cast<std::size_t>(py) * size.x + px) * 4;
+            double y1, i1, q1, y2, i2, q2;
+            yiq(expected + o, y1, i1, q1);
+            yiq(actual + o, y2, i2, q2);
+            const double dy = y1 - y2, di = i1 - i2, dq = q1 - q2;
+            const double delta = 0.5053 * dy * dy + 0.299 * di * di + 0.1957 * dq * dq;
+            diff.maxDelta = std::max(diff.maxDelta, std::sqrt(delta / MaxYiqDelta));
+
+            if (delta > limit)
+            {
+                ++diff.differingPixels;
+                diff.diffImage.setPixel({px, py}, sf::Color::Red);
+            }
+            else
+            {
+                // Faded golden for context
+                auto gray = static_cast<std::uint8_t>(255.0 - (255.0 - std::min(255.0, y1)) * 0.25);
+                diff.diffImage.setPixel({px, py}, sf::Color(gray, gray, gray));
+            }
+        }
+    }
+    return diff;
+}
+
+int GoldenSuite::run()
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Stored baselines
+    std::map<std::string, Baseline> baselines;
+    if (!m_options.update)
+    {
+        std::ifstream in(manifestPath());
+        std::string line;
+        if (!in || !std::getline(in, line) || line != "GOLDEN 1")
+        {
+            std::cerr << "[Golden] No golden set in " << m_options.dir << " (run with --update-golden)\n";
+            return 1;
+        }
+        while (std::getline(in, line))
+        {
+            if (line.empty())
+                continue;
+            std::istringstream ss(line);
+            std::string record, name;
+            Baseline b;
+            if (!(ss >> record >> std::quoted(name) >> b.size.x >> b.size.y) || record != "SCENE")
+            {
+                std::cerr << "[Golden] Malformed " << manifestPath() << "\n";
+                return 1;
+            }
+            // The render time is optional (only recorded on request)
+            b.timed = static_cast<bool>(ss >> b.renderMs);
+            baselines[name] = b;
+        }
+    }
+
+    fs::create_directories(m_options.dir);
+    fs::remove_all(fs::path(m_options.dir) / "diff");
+
+    std::ofstream manifest;
+    if (m_options.update)
+    {
+        manifest.open(manifestPath(), std::ios::trunc);
+        manifest << "GOLDEN 1\n";
+    }
+
+    std::size_t failures = 0, slow = 0, unrecorded = 0, total = 0;
+    for (auto &c : corpus(m_options.dir))
+    {
+        ++total;
+        Exporter exporter(RenderBackend::Software);
+        exporter.setSupersample(c->supersample);
+
+        // Median of `runs` renders
+        sf::Image image;
+        std::vector<double> times;
+        for (unsigned r = 0; r < m_options.runs; ++r)
+        {
+            auto t0 = Clock::now();
+            if (!exporter.render(c->scene, c->canvas, nullptr, image))
+                throw std::runtime_error("Render failed: " + c->name);
+            times.push_back(std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+        }
+        std::sort(times.begin(), times.end());
+        const double ms = times[times.size() / 2];
+
+        std::cout << "[Golden] " << std::left << std::setw(24) << c->name << std::right;
+        if (m_options.update)
+        {
+            if (!exporter.save(image, goldenPath(c->name)))
+                throw std::runtime_error("Cannot write " + goldenPath(c->name));
+            manifest << "SCENE " << std::quoted(c->name) << " " << image.getSize().x << " " << image.getSize().y;
+            if (m_options.recordTimes)
+                manifest << " " << std::fixed << std::setprecision(3) << ms;
+            manifest << "\n";
+            std::cout << " UPDATED  " << std::fixed << std::setprecision(2) << ms << " ms\n";
+            continue;
+        }
+
+        // Scenes golden.txt does not list are reported, not failed, so the
+        // corpus can grow before its goldens are recorded
+        auto base = baselines.find(c->name);
+        if (base == baselines.end())
+        {
+            ++unrecorded;
+            std::cout << " NEW      " << std::fixed << std::setprecision(2) << ms
+                      << " ms (not in golden.txt; record with --update-golden)\n";
+            continue;
+        }
+
+        sf::Image golden;
+        if (!golden.loadFromFile(goldenPath(c->name)))
+        {
+            ++failures;
+            std::cout << " MISSING  (no golden image; run with --update-golden)\n";
+            continue;
+        }
+
+        bool pass = golden.getSize() == image.getSize();
+        std::string detail = "size " + std::to_string(image.getSize().x) + "x" + std::to_string(image.getSize().y) +
+                             ", golden " + std::to_string(golden.getSize().x) + "x" +
+                             std::to_string(golden.getSize().y);
+        if (pass)
+        {
+            GoldenDiff diff = compare(golden.getPixelsPtr(), image.getPixelsPtr(), image.getSize(), m_options.threshold);
+            const double pixels = static_cast<double>(image.getSize().x) * image.getSize().y;
+            pass = static_cast<double>(diff.differingPixels) <= m_options.maxDiffRatio * pixels;
+            std::ostringstream d;
+            d << diff.differingPixels << " px differ (max delta " << std::fixed << std::setprecision(3)
+              << diff.maxDelta << ")";
+            detail = d.str();
+            if (!pass)
+            {
+                fs::create_directories(fs::path(diffPath(c->name)).parent_path());
+                if (!diff.diffImage.saveToFile(diffPath(c->name)))
+                    std::cerr << "[Golden] Cannot write " << diffPath(c->name) << "\n";
+                detail += ", see " + diffPath(c->name);
+            }
+        }
+
+        const double baseMs = base->second.renderMs;
+        const bool slower = base->second.timed && ms > baseMs * m_options.timeFactor && ms - baseMs > 2.0;
+        failures += pass ? 0 : 1;
+        slow += slower ? 1 : 0;
+
+        std::cout << (pass ? " PASS     " : " FAIL     ") << std::fixed << std::setprecision(2) << ms << " ms (";
+        if (base->second.timed)
+            std::cout << "golden " << baseMs << " ms, x" << (baseMs > 0.0 ? ms / baseMs : 0.0)
+                      << (slower ? ", SLOWER" : "");
+        else
+            std::cout << "no golden time";
+        std::cout << ")  " << detail << "\n";
+    }
+
+    if (m_options.update)
+    {
+        if (!manifest)
+        {
+            std::cerr << "[Golden] Cannot write " << manifestPath() << "\n";
+            return 1;
+        }
+        std::cout << "[Golden] Updated " << total << " golden images in " << m_options.dir << std::endl;
+        return 0;
+    }
+
+    std::cout << "[Golden] " << total - failures - unrecorded << "/" << total << " scenes match, " << unrecorded
+              << " without golden, " << slow << " render-time regressions" << std::endl;
+
+    const std::string roundTrip = checkProjectRoundTrip(m_options.dir);
+    std::cout << "[Golden] " << std::left << std::setw(24) << "project_roundtrip" << std::right
+              << (roundTrip.empty() ? " PASS" : " FAIL     " + roundTrip) << std::endl;
+
+    const std::size_t rounding = checkDownscaleRounding();
+    std::cout << "[Golden] " << std::left << std::setw(24) << "downscale_rounding" << std::right
+              << (rounding == 0 ? " PASS" : " FAIL     " + std::to_string(rounding) + " values round differently")
+              << std::endl;
+
+    const std::string extension = checkExportByExtension(m_options.dir);
+    std::cout << "[Golden] " << std::left << std::setw(24) << "export_extension" << std::right
+              << (extension.empty() ? " PASS" : " FAIL     " + extension) << std::endl;
+    return failures == 0 && slow == 0 && roundTrip.empty() && rounding == 0 && extension.empty() ? 0 : 1;
+}
@@ -0,0 +1,98 @@
+//=============================================================================
+// GoldenSuite.h
+//=============================================================================
+// PURPOSE:
+//   Render regression check: renders a corpus of reference scenes with the
+//   CPU renderer, compares each against a stored golden image with a
+//   perceptual tolerance and checks the render time against the time stored
+//   with the golden, so visual and speed regressions fail the same run.
+//
+// CORPUS:
+//   - Built-in SceneGenerator scenes (fixed seeds; see corpus() in the .cpp)
+//   - Every <dir>/scenes/*.comic project, rendered on its saved canvas
+//
+// GOLDEN DIRECTORY:
+//   <dir>/golden.txt      GOLDEN 1, then: SCENE "<name>" <width> <height> [<renderMs>]
+//   <dir>/<name>.png      Golden images
+//   golden/ in the repository holds the set for the built-in corpus. Corpus
+//   scenes golden.txt does not list are reported as NEW and do not fail the
+//   run; a listed scene whose image is missing does. Render images, which
+//   need the bundled fonts only, with --update-golden and commit them.
+//   <dir>/diff/<name>.png Written for failing scenes: the golden in faded
+//                         gray with differing pixels in red
+//
+// COMPARISON:
+//   Pixels differ when their YIQ color distance (alpha blended on white)
+//   exceeds `threshold` (0..1 of the maximum distance, as in pixelmatch);
+//   a scene fails when more than `maxDiffRatio` of its pixels differ or the
+//   size changed. Render time is the median of `runs` renders; it is a
+//   regression when slower than timeFactor x the golden time (and more
+//   than 2 ms slower, to ignore noise on tiny scenes). Times depend on the
+//   machine, so they are opt-in: --update-golden stores them only with
+//   --golden-record-times, and scenes without a stored time skip the check.
+//
+// USAGE:
+//   ComicStripMaker --golden DIR [--update-golden [--golden-record-times]]
+//                   [--golden-threshold T] [--golden-max-diff R]
+//                   [--golden-time-factor F]
+//   Exit code 0 = all listed scenes pass, 1 = any failure or a listed
+//   scene without golden image.
+//   The check run also saves and reloads a project with paint tiles, loose
+//   objects and a transformed group (project_roundtrip) and fails if any
+//   count or placement changed, and checks that the SSE and scalar Lanczos
+//   paths round exact .5 values alike (downscale_rounding), and that an
+//   export to *.jpg without --format writes JPEG bytes (export_extension).
+//
+// WHERE TO MODIFY:
+//   - Reference scenes: Modify corpus() in GoldenSuite.cpp
+//   - Perceptual metric: Modify GoldenSuite::compare()
+//=============================================================================
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct GoldenOptions {
+    std::string dir{"golden"};
+    bool update{false};                       // Rewrite goldens + times instead of checking
+    double threshold{0.1};                    // Per-pixel perceptual tolerance (0..1)
+    double maxDiffRatio{0.0005};              // Allowed fraction of differing pixels
+    double timeFactor{1.5};                   // Allowed slowdown vs the golden time
+    bool recordTimes{false};                  // --update-golden also stores render times
+    unsigned runs{3};                         // Renders per scene (median time)
+};
+
+struct GoldenDiff {
+    std::size_t differingPixels{0};
+    double maxDelta{0.0};                     // Largest perceptual distance (0..1)
+    sf::Image diffImage;
+};
+
+class GoldenSuite {
+public:
+    explicit GoldenSuite(const GoldenOptions& options);
+
+    // Requires assets to be loaded (headless). Returns the exit code.
+    int run();
+
+    // Perceptual comparison of equally sized RGBA8 images
+    static GoldenDiff compare(const std::uint8_t* expected, const std::uint8_t* actual,
+                              sf::Vector2u size, double threshold);
+
+private:
+    struct Baseline {
+        sf::Vector2u size{0, 0};
+        double renderMs{0.0};
+        bool timed{false};                    // renderMs was recorded
+    };
+
+    std::string goldenPath(const std::string& name) const;
+    std::string diffPath(const std::string& name) const;
+    std::string manifestPath() const;
+
+    GoldenOptions m_options;
+};
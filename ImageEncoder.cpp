@@ -0,0 +1,220 @@
+//=============================================================================
+// ImageEncoder.cpp
+//=============================================================================
+// PURPOSE:
+//   Format registry plus the small encoders (QOI, raw). PNG and JPEG live in
+//   PngEncoder.* and JpegEncoder.*.
+//=============================================================================
+
+#include "ImageEncoder.h"
+#include "JpegEncoder.h"
+#include "PngEncoder.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <vector>
+
+namespace
+{
+    class PngImageEncoder : public ImageEncoder
+    {
+    public:
+        explicit PngImageEncoder(const EncoderSettings &settings)
+        {
+            m_settings.compressionLevel = settings.pngLevel;
+            m_settings.threads = settings.threads;
+        }
+
+        bool encode(const std::uint8_t *rgba, sf::Vector2u size, std::ostream &out) const override
+        {
+            std::vector<std::uint8_t> png = PngEncoder(m_settings).encode(rgba, size);
+            if (png.empty())
+                return false;
+            out.write(reinterpret_cast<const char *>(png.data()), static_cast<std::streamsize>(png.size()));
+            return static_cast<bool>(out);
+        }
+
+    private:
+        PngSettings m_settings;
+    };
+
+    class PalettePngEncoder : public ImageEncoder
+    {
+    public:
+        explicit PalettePngEncoder(const EncoderSettings &settings)
+            : m_quantizer(settings.paletteColors, settings.threads)
+        {
+            m_settings.compressionLevel = settings.pngLevel;
+            m_settings.threads = settings.threads;
+        }
+
+        bool encode(const std::uint8_t *rgba, sf::Vector2u size, std::ostream &out) const override
+        {
+            IndexedImage indexed = m_quantizer.quantize(rgba, size);
+            std::vector<std::uint8_t> png = PngEncoder(m_settings).encodeIndexed(indexed);
+            if (png.empty())
+                return false;
+            out.write(reinterpret_cast<const char *>(png.data()), static_cast<std::streamsize>(png.size()));
+            return static_cast<bool>(out);
+        }
+
+    private:
+        PaletteQuantizer m_quantizer;
+        PngSettings m_settings;
+    };
+
+    // QOI (https://qoiformat.org), single pass
+    class QoiEncoder : public ImageEncoder
+    {
+    public:
+        bool encode(const std::uint8_t *rgba, sf::Vector2u size, std::ostream &out) const override
+        {
+            if (!rgba || size.x == 0 || size.y == 0)
+                return false;
+
+            const std::size_t pixels = static_cast<std::size_t>(size.x) * size.y;
+            std::vector<std::uint8_t> buf;
+            buf.reserve(14 + pixels * 2 + 8); // Typical comic pages compress well
+
+            auto putU32 = [&](std::uint32_t v)
+            {
+                buf.push_back(static_cast<std::uint8_t>(v >> 24));
+                buf.push_back(static_cast<std::uint8_t>(v >> 16));
+                buf.push_back(static_cast<std::uint8_t>(v >> 8));
+                buf.push_back(static_cast<std::uint8_t>(v));
+            };
+            buf.insert(buf.end(), {'q', 'o', 'i', 'f'});
+            putU32(size.x);
+            putU32(size.y);
+            buf.push_back(4); // Channels
+            buf.push_back(0); // sRGB with linear alpha
+
+            struct Px { std::uint8_t r, g, b, a; };
+            Px index[64] = {};
+            Px prev{0, 0, 0, 255};
+            int run = 0;
+
+            for (std::size_t i = 0; i < pixels; ++i)
+            {
+                const std::uint8_t *p = rgba + i * 4;
+                Px px{p[0], p[1], p[2], p[3]};
+
+                if (px.r == prev.r && px.g == prev.g && px.b == prev.b && px.a == prev.a)
+                {
+                    ++run;
+                    if (run == 62 || i + 1 == pixels)
+                    {
+                        buf.push_back(static_cast<std::uint8_t>(0xC0 | (run - 1))); // OP_RUN
+                        run = 0;
+                    }
+                    continue;
+                }
+
+                if (run > 0)
+                {
+                    buf.push_back(static_cast<std::uint8_t>(0xC0 | (run - 1)));
+                    run = 0;
+                }
+
+                int hash = (px.r * 3 + px.g * 5 + px.b * 7 + px.a * 11) % 64;
+                const Px &seen = index[hash];
+                if (seen.r == px.r && seen.g == px.g && seen.b == px.b && seen.a == px.a)
+                {
+                    buf.push_back(static_cast<std::uint8_t>(hash)); // OP_INDEX
+                }
+                else
+                {
+                    index[hash] = px;
+                    if (px.a == prev.a)
+                    {
+                        int vr = static_cast<std::int8_t>(px.r - prev.r);
+                        int vg = static_cast<std::int8_t>(px.g - prev.g);
+                        int vb = static_cast<std::int8_t>(px.b - prev.b);
+                        int vgr = vr - vg, vgb = vb - vg;
+
+                        if (vr >= -2 && vr <= 1 && vg >= -2 && vg <= 1 && vb >= -2 && vb <= 1)
+                        {
+                            buf.push_back(static_cast<std::uint8_t>(0x40 | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2)));
+                        }
+                        else if (vgr >= -8 && vgr <= 7 && vg >= -32 && vg <= 31 && vgb >= -8 && vgb <= 7)
+                        {
+                            buf.push_back(static_cast<std::uint8_t>(0x80 | (vg + 32)));
+                            buf.push_back(static_cast<std::uint8_t>((vgr + 8) << 4 | (vgb + 8)));
+                        }
+                        else
+                        {
+                            buf.insert(buf.end(), {0xFE, px.r, px.g, px.b});
+                        }
+                    }
+                    else
+                    {
+                        buf.insert(buf.end(), {0xFF, px.r, px.g, px.b, px.a});
+                    }
+                }
+                prev = px;
+            }
+
+            buf.insert(buf.end(), {0, 0, 0, 0, 0, 0, 0, 1}); // End marker
+            out.write(reinterpret_cast<const char *>(buf.data()), static_cast<std::streamsize>(buf.size()));
+            return static_cast<bool>(out);
+        }
+    };
+
+    // Headerless RGBA8 (size is known to the consumer / logged by the caller)
+    class RawEncoder : public ImageEncoder
+    {
+    public:
+        bool encode(const std::uint8_t *rgba, sf::Vector2u size, std::ostream &out) const override
+        {
+            if (!rgba)
+                return false;
+            out.write(reinterpret_cast<const char *>(rgba),
+                      static_cast<std::streamsize>(static_cast<std::size_t>(size.x) * size.y * 4));
+            return static_cast<bool>(out);
+        }
+    };
+}
+
+bool parseImageFormat(const std::string &name, ImageFormat &out)
+{
+    std::string n = name;
+    std::transform(n.begin(), n.end(), n.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (!n.empty() && n[0] == '.')
+        n.erase(0, 1);
+
+    if (n == "png")                     { out = ImageFormat::Png;  return true; }
+    if (n == "png8")                    { out = ImageFormat::PngPalette; return true; }
+    if (n == "qoi")                     { out = ImageFormat::Qoi;  return true; }
+    if (n == "jpg" || n == "jpeg")      { out = ImageFormat::Jpeg; return true; }
+    if (n == "raw" || n == "rgba")      { out = ImageFormat::Raw;  return true; }
+    return false;
+}
+
+bool imageFormatFromPath(const std::string &path, ImageFormat &out)
+{
+    return parseImageFormat(std::filesystem::path(path).extension().string(), out);
+}
+
+std::string imageFormatExtension(ImageFormat format)
+{
+    switch (format)
+    {
+    case ImageFormat::Qoi:  return ".qoi";
+    case ImageFormat::Jpeg: return ".jpg";
+    case ImageFormat::Raw:  return ".rgba";
+    default:                return ".png";
+    }
+}
+
+std::unique_ptr<ImageEncoder> createImageEncoder(ImageFormat format, const EncoderSettings &settings)
+{
+    switch (format)
+    {
+    case ImageFormat::PngPalette: return std::make_unique<PalettePngEncoder>(settings);
+    case ImageFormat::Qoi:  return std::make_unique<QoiEncoder>();
+    case ImageFormat::Jpeg: return std::make_unique<JpegEncoder>(settings.jpegQuality, settings.threads);
+    case ImageFormat::Raw:  return std::make_unique<RawEncoder>();
+    default:                return std::make_unique<PngImageEncoder>(settings);
+    }
+}
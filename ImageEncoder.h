@@ -0,0 +1,69 @@
+//=============================================================================
+// ImageEncoder.h
+//=============================================================================
+// PURPOSE:
+//   Pluggable export encoders used by the Exporter. Every encoder turns a
+//   tightly packed RGBA8 image into bytes on an output stream.
+//
+// FORMATS:
+//   png  - Lossless, multi-threaded deflate (PngEncoder)
+//   png8 - Indexed PNG (PaletteQuantizer): exact when the page has at most
+//          paletteColors colors, median cut otherwise; 1/2/4/8-bit
+//   qoi  - Lossless "Quite OK Image" format; one pass, very fast encode,
+//          meant for intermediates
+//   jpg  - Baseline JPEG, 4:2:0, quality 1..100 (JpegEncoder); for previews
+//   raw  - Headerless RGBA8 rows, top to bottom, for piping to other tools
+//
+// USAGE:
+//   ImageFormat format;
+//   if (parseImageFormat("qoi", format))
+//       createImageEncoder(format, settings)->encode(pixels, size, stream);
+//
+// WHERE TO MODIFY:
+//   - New formats: Extend ImageFormat, parseImageFormat() and
+//     createImageEncoder() in ImageEncoder.cpp
+//=============================================================================
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+
+enum class ImageFormat
+{
+    Png,
+    PngPalette,
+    Qoi,
+    Jpeg,
+    Raw
+};
+
+// Parse a format name: "png", "png8", "qoi", "jpg"/"jpeg" or "raw"
+bool parseImageFormat(const std::string& name, ImageFormat& out);
+
+// Format from a file name's extension (case-insensitive)
+bool imageFormatFromPath(const std::string& path, ImageFormat& out);
+
+// File extension including the dot (".png", ".qoi", ".jpg", ".rgba")
+std::string imageFormatExtension(ImageFormat format);
+
+struct EncoderSettings {
+    int pngLevel{6};                  // zlib level 0..9
+    int jpegQuality{90};              // 1..100
+    unsigned paletteColors{256};      // png8: palette size limit 2..256
+    unsigned threads{0};              // 0 = one per hardware thread
+};
+
+class ImageEncoder {
+public:
+    virtual ~ImageEncoder() = default;
+
+    // Write the encoded image to `out`. Returns false on failure.
+    virtual bool encode(const std::uint8_t* rgba, sf::Vector2u size, std::ostream& out) const = 0;
+};
+
+std::unique_ptr<ImageEncoder> createImageEncoder(ImageFormat format, const EncoderSettings& settings);
@@ -0,0 +1,516 @@
+//=============================================================================
+// InputRecorder.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of session recording and replay (see InputRecorder.h).
+//=============================================================================
+
+#include "InputRecorder.h"
+
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+namespace
+{
+    constexpr char Magic[6] = {'C', 'S', 'M', 'R', 'E', 'C'};
+    constexpr std::uint8_t FormatVersion = 1;
+
+    enum EventType : std::uint8_t
+    {
+        Closed,
+        Resized,
+        FocusLost,
+        FocusGained,
+        TextEntered,
+        KeyPressed,
+        KeyReleased,
+        MouseWheelScrolled,
+        MouseButtonPressed,
+        MouseButtonReleased,
+        MouseMoved,
+        MouseEntered,
+        MouseLeft
+    };
+
+    void putVarint(std::string &out, std::uint64_t v)
+    {
+        while (v >= 0x80)
+        {
+            out += static_cast<char>((v & 0x7F) | 0x80);
+            v >>= 7;
+        }
+        out += static_cast<char>(v);
+    }
+
+    void putSigned(std::string &out, std::int64_t v)
+    {
+        putVarint(out, (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63));
+    }
+
+    class Reader {
+    public:
+        explicit Reader(const std::string &data) : m_data(data) {}
+
+        bool atEnd() const { return m_pos >= m_data.size(); }
+
+        std::uint8_t byte()
+        {
+            if (atEnd())
+                throw std::runtime_error("Recording truncated");
+            return static_cast<std::uint8_t>(m_data[m_pos++]);
+        }
+
+        std::uint64_t varint()
+        {
+            std::uint64_t v = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                std::uint8_t b = byte();
+                v |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+                if (!(b & 0x80))
+                    return v;
+            }
+            throw std::runtime_error("Recording corrupt: varint too long");
+        }
+
+        std::int64_t signedVarint()
+        {
+            std::uint64_t v = varint();
+            return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+        }
+
+        float f32()
+        {
+            std::uint8_t b[4];
+            for (auto &x : b)
+                x = byte();
+            float f;
+            std::memcpy(&f, b, 4);
+            return f;
+        }
+
+    private:
+        const std::string &m_data;
+        std::size_t m_pos{0};
+    };
+
+    void putPosition(std::string &out, sf::Vector2i p)
+    {
+        putSigned(out, p.x);
+        putSigned(out, p.y);
+    }
+
+    sf::Vector2i readPosition(Reader &in)
+    {
+        int x = static_cast<int>(in.signedVarint());
+        int y = static_cast<int>(in.signedVarint());
+        return {x, y};
+    }
+
+    template <typename KeyEvent>
+    void putKey(std::string &out, EventType type, const KeyEvent &k)
+    {
+        out += static_cast<char>(type);
+        putSigned(out, static_cast<int>(k.code));
+        putSigned(out, static_cast<int>(k.scancode));
+        out += static_cast<char>((k.alt ? 1 : 0) | (k.control ? 2 : 0) | (k.shift ? 4 : 0) | (k.system ? 8 : 0));
+    }
+
+    template <typename KeyEvent>
+    KeyEvent readKey(Reader &in)
+    {
+        KeyEvent k;
+        k.code = static_cast<sf::Keyboard::Key>(in.signedVarint());
+        k.scancode = static_cast<sf::Keyboard::Scancode>(in.signedVarint());
+        std::uint8_t flags = in.byte();
+        k.alt = flags & 1;
+        k.control = flags & 2;
+        k.shift = flags & 4;
+        k.system = flags & 8;
+        return k;
+    }
+
+    // Appends type + payload; false for event kinds that are not recorded
+    bool encodeEvent(std::string &out, const sf::Event &e)
+    {
+        if (e.is<sf::Event::Closed>())
+            out += static_cast<char>(Closed);
+        else if (const auto *r = e.getIf<sf::Event::Resized>())
+        {
+            out += static_cast<char>(Resized);
+            putVarint(out, r->size.x);
+            putVarint(out, r->size.y);
+        }
+        else if (e.is<sf::Event::FocusLost>())
+            out += static_cast<char>(FocusLost);
+        else if (e.is<sf::Event::FocusGained>())
+            out += static_cast<char>(FocusGained);
+        else if (const auto *t = e.getIf<sf::Event::TextEntered>())
+        {
+            out += static_cast<char>(TextEntered);
+            putVarint(out, static_cast<std::uint64_t>(t->unicode));
+        }
+        else if (const auto *k = e.getIf<sf::Event::KeyPressed>())
+            putKey(out, KeyPressed, *k);
+        else if (const auto *k = e.getIf<sf::Event::KeyReleased>())
+            putKey(out, KeyReleased, *k);
+        else if (const auto *w = e.getIf<sf::Event::MouseWheelScrolled>())
+        {
+            out += static_cast<char>(MouseWheelScrolled);
+            putVarint(out, static_cast<std::uint64_t>(w->wheel));
+            char b[4];
+            std::memcpy(b, &w->delta, 4);
+            out.append(b, 4);
+            putPosition(out, w->position);
+        }
+        else if (const auto *b = e.getIf<sf::Event::MouseButtonPressed>())
+        {
+            out += static_cast<char>(MouseButtonPressed);
+            putVarint(out, static_cast<std::uint64_t>(b->button));
+            putPosition(out, b->position);
+        }
+        else if (const auto *b = e.getIf<sf::Event::MouseButtonReleased>())
+        {
+            out += static_cast<char>(MouseButtonReleased);
+            putVarint(out, static_cast<std::uint64_t>(b->button));
+            putPosition(out, b->position);
+        }
+        else if (const auto *m = e.getIf<sf::Event::MouseMoved>())
+        {
+            out += static_cast<char>(MouseMoved);
+            putPosition(out, m->position);
+        }
+        else if (e.is<sf::Event::MouseEntered>())
+            out += static_cast<char>(MouseEntered);
+        else if (e.is<sf::Event::MouseLeft>())
+            out += static_cast<char>(MouseLeft);
+        else
+            return false;
+        return true;
+    }
+
+    sf::Event decodeEvent(Reader &in)
+    {
+        switch (in.byte())
+        {
+        case Closed:
+            return sf::Event::Closed{};
+        case Resized:
+        {
+            unsigned w = static_cast<unsigned>(in.varint());
+            unsigned h = static_cast<unsigned>(in.varint());
+            return sf::Event::Resized{{w, h}};
+        }
+        case FocusLost:
+            return sf::Event::FocusLost{};
+        case FocusGained:
+            return sf::Event::FocusGained{};
+        case TextEntered:
+            return sf::Event::TextEntered{static_cast<char32_t>(in.varint())};
+        case KeyPressed:
+            return readKey<sf::Event::KeyPressed>(in);
+        case KeyReleased:
+            return readKey<sf::Event::KeyReleased>(in);
+        case MouseWheelScrolled:
+        {
+            sf::Event::MouseWheelScrolled w;
+            w.wheel = static_cast<sf::Mouse::Wheel>(in.varint());
+            w.delta = in.f32();
+            w.position = readPosition(in);
+            return w;
+        }
+        case MouseButtonPressed:
+        {
+            sf::Event::MouseButtonPressed b;
+            b.button = static_cast<sf::Mouse::Button>(in.varint());
+            b.position = readPosition(in);
+            return b;
+        }
+        case MouseButtonReleased:
+        {
+            sf::Event::MouseButtonReleased b;
+            b.button = static_cast<sf::Mouse::Button>(in.varint());
+            b.position = readPosition(in);
+            return b;
+        }
+        case MouseMoved:
+            return sf::Event::MouseMoved{readPosition(in)};
+        case MouseEntered:
+            return sf::Event::MouseEntered{};
+        case MouseLeft:
+            return sf::Event::MouseLeft{};
+        default:
+            throw std::runtime_error("Recording corrupt: unknown event type");
+        }
+    }
+
+    // Report bucket of an event
+    std::string eventKind(const sf::Event &e)
+    {
+        if (e.is<sf::Event::MouseMoved>())
+            return "mouse_moved";
+        if (e.is<sf::Event::MouseButtonPressed>() || e.is<sf::Event::MouseButtonReleased>())
+            return "mouse_button";
+        if (e.is<sf::Event::KeyPressed>() || e.is<sf::Event::KeyReleased>())
+            return "key";
+        if (e.is<sf::Event::TextEntered>())
+            return "text";
+        if (e.is<sf::Event::MouseWheelScrolled>())
+            return "wheel";
+        return "other";
+    }
+
+    double nanosBetween(std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b)
+    {
+        return std::chrono::duration<double, std::nano>(b - a).count();
+    }
+}
+
+InputRecorder::InputRecorder() = default;
+
+InputRecorder InputRecorder::record(const std::string &path, sf::Vector2u windowSize)
+{
+    InputRecorder rec;
+    rec.m_mode = Mode::Record;
+    rec.m_windowSize = windowSize;
+    rec.m_out.open(path, std::ios::binary | std::ios::trunc);
+    if (!rec.m_out)
+        throw std::runtime_error("Cannot create recording: " + path);
+
+    std::string header(Magic, sizeof(Magic));
+    header += static_cast<char>(FormatVersion);
+    header += '\0';
+    putVarint(header, windowSize.x);
+    putVarint(header, windowSize.y);
+    rec.m_out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    rec.m_start = Clock::now();
+    return rec;
+}
+
+InputRecorder InputRecorder::replay(const std::string &path, bool fast)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        throw std::runtime_error("Cannot open recording: " + path);
+    const std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    if (data.size() < sizeof(Magic) + 2 || std::memcmp(data.data(), Magic, sizeof(Magic)) != 0)
+        throw std::runtime_error("Not a recording: " + path);
+    if (static_cast<std::uint8_t>(data[sizeof(Magic)]) != FormatVersion)
+        throw std::runtime_error("Unsupported recording version: " + path);
+
+    InputRecorder rec;
+    rec.m_mode = Mode::Replay;
+    rec.m_fast = fast;
+
+    Reader reader(data);
+    for (std::size_t i = 0; i < sizeof(Magic) + 2; ++i)
+        reader.byte();
+    rec.m_windowSize.x = static_cast<unsigned>(reader.varint());
+    rec.m_windowSize.y = static_cast<unsigned>(reader.varint());
+
+    std::uint64_t micros = 0, frame = 0;
+    while (!reader.atEnd())
+    {
+        micros += reader.varint();
+        frame += reader.varint();
+        rec.m_events.push_back({frame, micros, decodeEvent(reader)});
+    }
+    std::cout << "[Replay] " << rec.m_events.size() << " events, " << (rec.m_events.empty() ? 0 : frame + 1)
+              << " frames, " << std::fixed << std::setprecision(1) << micros / 1e6 << " s recorded"
+              << (fast ? " (fast)" : "") << std::endl;
+    return rec;
+}
+
+InputRecorder::Mode InputRecorder::getMode() const { return m_mode; }
+
+bool InputRecorder::isFastReplay() const { return m_mode == Mode::Replay && m_fast; }
+
+sf::Vector2u InputRecorder::getRecordedWindowSize() const { return m_windowSize; }
+
+void InputRecorder::beginFrame()
+{
+    const Clock::time_point now = Clock::now();
+    closeEventTiming();
+
+    if (m_mode == Mode::Record)
+    {
+        ++m_frame;
+        return;
+    }
+    if (m_mode != Mode::Replay)
+        return;
+
+    if (m_frameStarted)
+        m_frameTimes.push_back(nanosBetween(m_frameStart, now));
+    else
+        m_start = now; // Recorded times are relative to the first frame
+    m_frameStarted = true;
+    m_frameStart = now;
+
+    // Open the next frame group once it is due
+    if (!m_groupOpen && m_next < m_events.size())
+    {
+        const Recorded &next = m_events[m_next];
+        const auto due = m_start + std::chrono::microseconds(next.micros);
+        if (m_fast || now >= due)
+        {
+            m_currentGroup = next.frame;
+            m_groupOpen = true;
+        }
+    }
+}
+
+std::optional<sf::Event> InputRecorder::poll(sf::RenderWindow &window)
+{
+    closeEventTiming();
+
+    if (m_mode == Mode::Live)
+        return window.pollEvent();
+
+    if (m_mode == Mode::Record)
+    {
+        auto event = window.pollEvent();
+        if (!event)
+            return event;
+
+        std::string bytes;
+        const auto micros = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - m_start).count());
+        putVarint(bytes, micros - m_lastMicros);
+        putVarint(bytes, m_frame - m_lastFrame);
+        if (encodeEvent(bytes, *event))
+        {
+            m_out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            m_lastMicros = micros;
+            m_lastFrame = m_frame;
+        }
+        track(*event);
+        return event;
+    }
+
+    // Replay: the real window only matters for closing it
+    while (auto real = window.pollEvent())
+    {
+        if (real->is<sf::Event::Closed>())
+        {
+            std::cout << "[Replay] Aborted after " << m_next << " of " << m_events.size() << " events"
+                      << std::endl;
+            m_next = m_events.size();
+            m_groupOpen = false;
+            return real;
+        }
+    }
+
+    if (!m_sentResize)
+    {
+        // Same layout as in the recorded session
+        m_sentResize = true;
+        window.setSize(m_windowSize);
+        return sf::Event(sf::Event::Resized{m_windowSize});
+    }
+
+    if (!m_groupOpen || m_next >= m_events.size() || m_events[m_next].frame != m_currentGroup)
+    {
+        m_groupOpen = false;
+        return std::nullopt;
+    }
+
+    const sf::Event &event = m_events[m_next++].event;
+    if (const auto *resized = event.getIf<sf::Event::Resized>())
+        window.setSize(resized->size);
+    track(event);
+    m_eventKind = eventKind(event);
+    m_eventStart = Clock::now();
+    return event;
+}
+
+void InputRecorder::closeEventTiming()
+{
+    if (m_eventKind.empty())
+        return;
+    m_eventTimes[m_eventKind].push_back(nanosBetween(m_eventStart, Clock::now()));
+    m_eventKind.clear();
+}
+
+void InputRecorder::track(const sf::Event &event)
+{
+    if (const auto *m = event.getIf<sf::Event::MouseMoved>())
+        m_mouse = m->position;
+    else if (const auto *b = event.getIf<sf::Event::MouseButtonPressed>())
+        m_mouse = b->position;
+    else if (const auto *b = event.getIf<sf::Event::MouseButtonReleased>())
+        m_mouse = b->position;
+    else if (const auto *w = event.getIf<sf::Event::MouseWheelScrolled>())
+        m_mouse = w->position;
+    else if (const auto *k = event.getIf<sf::Event::KeyPressed>())
+        m_keysDown.insert(k->code);
+    else if (const auto *k = event.getIf<sf::Event::KeyReleased>())
+        m_keysDown.erase(k->code);
+    else if (event.is<sf::Event::FocusLost>())
+        m_keysDown.clear();
+}
+
+sf::Vector2i InputRecorder::mousePosition(const sf::RenderWindow &window) const
+{
+    return m_mode == Mode::Live ? sf::Mouse::getPosition(window) : m_mouse;
+}
+
+bool InputRecorder::isKeyDown(sf::Keyboard::Key key) const
+{
+    return m_mode == Mode::Live ? sf::Keyboard::isKeyPressed(key) : m_keysDown.count(key) != 0;
+}
+
+bool InputRecorder::finished() const
+{
+    return m_mode == Mode::Replay && m_sentResize && m_next >= m_events.size();
+}
+
+std::vector<BenchmarkResult> InputRecorder::report() const
+{
+    std::vector<BenchmarkResult> results;
+    results.push_back(summarizeSamples("replay/frame", "frames", 1.0, 1, m_frameTimes));
+    for (const auto &[kind, times] : m_eventTimes)
+        results.push_back(summarizeSamples("replay/" + kind, "events", 1.0, 1, times));
+    return results;
+}
+
+bool InputRecorder::finish(const std::string &reportPath)
+{
+    closeEventTiming();
+
+    if (m_mode == Mode::Record)
+    {
+        m_out.flush();
+        bool ok = static_cast<bool>(m_out);
+        m_out.close();
+        std::cout << "[Record] Session written (" << m_frame << " frames)" << std::endl;
+        return ok;
+    }
+    if (m_mode != Mode::Replay)
+        return true;
+
+    const auto results = report();
+    for (const auto &r : results)
+    {
+        std::cout << "[Replay] " << std::left << std::setw(20) << r.name << std::right << std::setw(7) << r.samples
+                  << " x  median " << std::fixed << std::setprecision(3) << r.medianNs / 1e6 << " ms  p95 "
+                  << r.p95Ns / 1e6 << " ms  p99 " << r.p99Ns / 1e6 << " ms  max " << r.maxNs / 1e6 << " ms"
+                  << std::endl;
+    }
+
+    if (reportPath.empty())
+        return true;
+    std::ofstream out(reportPath);
+    writeBenchmarkJson(out, results);
+    if (!out)
+    {
+        std::cerr << "[Replay] Cannot write report: " << reportPath << std::endl;
+        return false;
+    }
+    std::cout << "[Replay] Report written to " << reportPath << std::endl;
+    return true;
+}
@@ -0,0 +1,135 @@
+//=============================================================================
+// InputRecorder.h
+//=============================================================================
+// PURPOSE:
+//   Event source of the editor loop. Live, it forwards window events;
+//   with --record it also writes them (with timestamps) to a file; with
+//   --replay it feeds a recorded session back instead of the window and
+//   measures how long every event and frame takes to process.
+//
+// DETERMINISM:
+//   - Events are replayed in the same frame groups they were recorded in
+//   - While recording or replaying, the mouse position and held keys are
+//     derived from the event stream (not sf::Mouse / sf::Keyboard), so the
+//     loop sees exactly the same input state both times
+//   - Replay starts by resizing the window to the recorded size
+//   --replay-fast delivers every frame group immediately (no frame limit);
+//   otherwise groups are held back until their recorded time.
+//
+// FILE FORMAT (*.rec, little-endian, integers are LEB128 varints):
+//   "CSMREC" u8 version(1) u8 reserved
+//   varint windowWidth, varint windowHeight
+//   per event: varint microseconds since the previous event,
+//              varint frames since the previous event, u8 type, payload
+//   Payloads use varints (signed values zigzag-encoded); the wheel delta
+//   is a raw 4-byte float. Joystick/touch/sensor events are not recorded.
+//
+// REPORT (end of replay):
+//   Per-event processing time by event type and whole-frame time, as
+//   median / p95 / p99 / max on stdout, and as Benchmark.h JSON results
+//   ("replay/frame", "replay/mouse_moved", ...) with --replay-report FILE.
+//
+// WHERE TO MODIFY:
+//   - New event types: Modify encodeEvent() / decodeEvent() in the .cpp
+//   - Report contents: Modify InputRecorder::report()
+//=============================================================================
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+
+class InputRecorder {
+public:
+    enum class Mode
+    {
+        Live,
+        Record,
+        Replay
+    };
+
+    // Live passthrough
+    InputRecorder();
+
+    // Throws runtime_error if the file cannot be created
+    static InputRecorder record(const std::string& path, sf::Vector2u windowSize);
+
+    // Loads the whole recording. Throws runtime_error on I/O / format errors.
+    static InputRecorder replay(const std::string& path, bool fast);
+
+    Mode getMode() const;
+    bool isFastReplay() const;
+    sf::Vector2u getRecordedWindowSize() const;
+
+    // Call once at the top of every loop iteration
+    void beginFrame();
+
+    // Next event of this frame (replaces window.pollEvent()). During replay
+    // the real window is drained too; only its Closed event is honored.
+    std::optional<sf::Event> poll(sf::RenderWindow& window);
+
+    // Replaces sf::Mouse::getPosition(window) / sf::Keyboard::isKeyPressed()
+    sf::Vector2i mousePosition(const sf::RenderWindow& window) const;
+    bool isKeyDown(sf::Keyboard::Key key) const;
+
+    // True once a replay has delivered its last event
+    bool finished() const;
+
+    // Flush the recording / print the replay report (and write it as JSON
+    // if `reportPath` is not empty). Returns false if writing failed.
+    bool finish(const std::string& reportPath = "");
+
+    std::vector<BenchmarkResult> report() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Recorded {
+        std::uint64_t frame;                  // Frame group
+        std::uint64_t micros;                 // Since recording start
+        sf::Event event;
+    };
+
+    void track(const sf::Event& event);
+    void closeEventTiming();
+
+    Mode m_mode{Mode::Live};
+    bool m_fast{false};
+    sf::Vector2u m_windowSize{0, 0};
+
+    // Tracked input state (Record / Replay)
+    sf::Vector2i m_mouse{0, 0};
+    std::set<sf::Keyboard::Key> m_keysDown;
+
+    // Recording
+    std::ofstream m_out;
+    std::uint64_t m_frame{0};
+    std::uint64_t m_lastFrame{0};
+    std::uint64_t m_lastMicros{0};
+    Clock::time_point m_start{Clock::now()};
+
+    // Replay
+    std::vector<Recorded> m_events;
+    std::size_t m_next{0};
+    std::uint64_t m_currentGroup{0};
+    bool m_groupOpen{false};
+    bool m_sentResize{false};
+
+    // Replay measurements (ns)
+    Clock::time_point m_frameStart{};
+    bool m_frameStarted{false};
+    Clock::time_point m_eventStart{};
+    std::string m_eventKind;                  // Kind of the event being processed
+    std::vector<double> m_frameTimes;
+    std::map<std::string, std::vector<double>> m_eventTimes;
+};
@@ -0,0 +1,422 @@
+//=============================================================================
+// JpegEncoder.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the baseline JPEG writer (see JpegEncoder.h).
+//
+// STREAM LAYOUT:
+//   SOI, APP0 (JFIF), DQT x2, SOF0, DHT x4, DRI (one MCU row), SOS,
+//   MCU row 0, RST0, MCU row 1, RST1, ..., EOI
+//=============================================================================
+
+#include "JpegEncoder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Natural (row-major) index of the i-th coefficient in zigzag order
+    const int ZigZag[64] = {
+        0, 1, 8, 16, 9, 2, 3, 10, 17, 24, 32, 25, 18, 11, 4, 5,
+        12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6, 7, 14, 21, 28,
+        35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+        58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63};
+
+    // ITU T.81 Annex K quantization tables (natural order)
+    const int LumaQuant[64] = {
+        16, 11, 10, 16, 24, 40, 51, 61,
+        12, 12, 14, 19, 26, 58, 60, 55,
+        14, 13, 16, 24, 40, 57, 69, 56,
+        14, 17, 22, 29, 51, 87, 80, 62,
+        18, 22, 37, 56, 68, 109, 103, 77,
+        24, 35, 55, 64, 81, 104, 113, 92,
+        49, 64, 78, 87, 103, 121, 120, 101,
+        72, 92, 95, 98, 112, 100, 103, 99};
+
+    const int ChromaQuant[64] = {
+        17, 18, 24, 47, 99, 99, 99, 99,
+        18, 21, 26, 66, 99, 99, 99, 99,
+        24, 26, 56, 99, 99, 99, 99, 99,
+        47, 66, 99, 99, 99, 99, 99, 99,
+        99, 99, 99, 99, 99, 99, 99, 99,
+        99, 99, 99, 99, 99, 99, 99, 99,
+        99, 99, 99, 99, 99, 99, 99, 99,
+        99, 99, 99, 99, 99, 99, 99, 99};
+
+    // ITU T.81 Annex K Huffman tables: code counts per length 1..16 + symbols
+    const std::uint8_t DcLumaBits[16] = {0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0};
+    const std::uint8_t DcChromaBits[16] = {0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0};
+    const std::uint8_t DcValues[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+
+    const std::uint8_t AcLumaBits[16] = {0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d};
+    const std::uint8_t AcLumaValues[162] = {
+        0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+        0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0,
+        0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28,
+        0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+        0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+        0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+        0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+        0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5,
+        0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+        0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+        0xf9, 0xfa};
+
+    const std::uint8_t AcChromaBits[16] = {0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77};
+    const std::uint8_t AcChromaValues[162] = {
+        0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+        0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0,
+        0x15, 0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26,
+        0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+        0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+        0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+        0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5,
+        0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3,
+        0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda,
+        0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+        0xf9, 0xfa};
+
+    struct HuffmanTable
+    {
+        std::uint16_t code[256]{};
+        std::uint8_t size[256]{};
+
+        HuffmanTable(const std::uint8_t *bits, const std::uint8_t *values)
+        {
+            std::uint16_t next = 0;
+            int k = 0;
+            for (int len = 1; len <= 16; ++len)
+            {
+                for (int i = 0; i < bits[len - 1]; ++i, ++k)
+                {
+                    code[values[k]] = next++;
+                    size[values[k]] = static_cast<std::uint8_t>(len);
+                }
+                next = static_cast<std::uint16_t>(next << 1);
+            }
+        }
+    };
+
+    const HuffmanTable &dcLuma()   { static const HuffmanTable t(DcLumaBits, DcValues);       return t; }
+    const HuffmanTable &dcChroma() { static const HuffmanTable t(DcChromaBits, DcValues);     return t; }
+    const HuffmanTable &acLuma()   { static const HuffmanTable t(AcLumaBits, AcLumaValues);   return t; }
+    const HuffmanTable &acChroma() { static const HuffmanTable t(AcChromaBits, AcChromaValues); return t; }
+
+    // Entropy-coded segment writer with 0xFF byte stuffing
+    class BitWriter
+    {
+    public:
+        explicit BitWriter(std::vector<std::uint8_t> &out) : m_out(out) {}
+
+        void put(std::uint32_t bits, int count)
+        {
+            m_acc = (m_acc << count) | (bits & ((1u << count) - 1u));
+            m_count += count;
+            while (m_count >= 8)
+            {
+                std::uint8_t byte = static_cast<std::uint8_t>(m_acc >> (m_count - 8));
+                m_out.push_back(byte);
+                if (byte == 0xFF)
+                    m_out.push_back(0);
+                m_count -= 8;
+            }
+        }
+
+        // Pad the last byte with 1-bits (required before markers)
+        void flush()
+        {
+            int pad = (8 - m_count % 8) % 8;
+            if (pad)
+                put((1u << pad) - 1u, pad);
+        }
+
+    private:
+        std::vector<std::uint8_t> &m_out;
+        std::uint32_t m_acc{0};
+        int m_count{0};
+    };
+
+    // Arai/Agui/Nakajima 8-point forward DCT (output scaled, see fdtbl)
+    void dct8(float *d, int stride)
+    {
+        float t0 = d[0] + d[7 * stride], t7 = d[0] - d[7 * stride];
+        float t1 = d[stride] + d[6 * stride], t6 = d[stride] - d[6 * stride];
+        float t2 = d[2 * stride] + d[5 * stride], t5 = d[2 * stride] - d[5 * stride];
+        float t3 = d[3 * stride] + d[4 * stride], t4 = d[3 * stride] - d[4 * stride];
+
+        float t10 = t0 + t3, t13 = t0 - t3, t11 = t1 + t2, t12 = t1 - t2;
+        d[0] = t10 + t11;
+        d[4 * stride] = t10 - t11;
+        float z1 = (t12 + t13) * 0.707106781f;
+        d[2 * stride] = t13 + z1;
+        d[6 * stride] = t13 - z1;
+
+        t10 = t4 + t5;
+        t11 = t5 + t6;
+        t12 = t6 + t7;
+        float z5 = (t10 - t12) * 0.382683433f;
+        float z2 = t10 * 0.541196100f + z5;
+        float z4 = t12 * 1.306562965f + z5;
+        float z3 = t11 * 0.707106781f;
+        float z11 = t7 + z3, z13 = t7 - z3;
+        d[5 * stride] = z13 + z2;
+        d[3 * stride] = z13 - z2;
+        d[stride] = z11 + z4;
+        d[7 * stride] = z11 - z4;
+    }
+
+    // Number of bits needed for |value| (JPEG "category")
+    int bitCategory(int value)
+    {
+        int mag = value < 0 ? -value : value;
+        int category = 0;
+        while (mag)
+        {
+            ++category;
+            mag >>= 1;
+        }
+        return category;
+    }
+
+    // DCT, quantize and Huffman code one 8x8 block (level-shifted samples)
+    void encodeBlock(BitWriter &bw, float *block, const float *fdtbl, int &prevDC,
+                     const HuffmanTable &dc, const HuffmanTable &ac)
+    {
+        for (int r = 0; r < 8; ++r)
+            dct8(block + r * 8, 1);
+        for (int c = 0; c < 8; ++c)
+            dct8(block + c, 8);
+
+        int q[64];
+        for (int i = 0; i < 64; ++i)
+        {
+            float v = block[ZigZag[i]] * fdtbl[ZigZag[i]];
+            q[i] = static_cast<int>(v < 0.f ? v - 0.5f : v + 0.5f);
+        }
+
+        // DC: difference to the previous block of this component
+        int diff = q[0] - prevDC;
+        prevDC = q[0];
+        int category = bitCategory(diff);
+        bw.put(dc.code[category], dc.size[category]);
+        if (category)
+            bw.put(static_cast<std::uint32_t>(diff < 0 ? diff - 1 : diff), category);
+
+        // AC: (run, size) symbols, ZRL for 16 zeros, EOB after the last nonzero
+        int last = 63;
+        while (last > 0 && q[last] == 0)
+            --last;
+        int run = 0;
+        for (int i = 1; i <= last; ++i)
+        {
+            if (q[i] == 0)
+            {
+                ++run;
+                continue;
+            }
+            while (run >= 16)
+            {
+                bw.put(ac.code[0xF0], ac.size[0xF0]);
+                run -= 16;
+            }
+            category = bitCategory(q[i]);
+            int symbol = (run << 4) | category;
+            bw.put(ac.code[symbol], ac.size[symbol]);
+            bw.put(static_cast<std::uint32_t>(q[i] < 0 ? q[i] - 1 : q[i]), category);
+            run = 0;
+        }
+        if (last < 63)
+            bw.put(ac.code[0x00], ac.size[0x00]);
+    }
+
+    void putMarker(std::vector<std::uint8_t> &out, std::uint8_t marker, std::size_t length)
+    {
+        out.push_back(0xFF);
+        out.push_back(marker);
+        if (length)
+        {
+            out.push_back(static_cast<std::uint8_t>(length >> 8));
+            out.push_back(static_cast<std::uint8_t>(length));
+        }
+    }
+
+    void putU16(std::vector<std::uint8_t> &out, unsigned v)
+    {
+        out.push_back(static_cast<std::uint8_t>(v >> 8));
+        out.push_back(static_cast<std::uint8_t>(v));
+    }
+
+    void putHuffman(std::vector<std::uint8_t> &out, std::uint8_t tableClassId,
+                    const std::uint8_t *bits, const std::uint8_t *values, std::size_t count)
+    {
+        putMarker(out, 0xC4, 2 + 1 + 16 + count);
+        out.push_back(tableClassId);
+        out.insert(out.end(), bits, bits + 16);
+        out.insert(out.end(), values, values + count);
+    }
+}
+
+JpegEncoder::JpegEncoder(int quality, unsigned threads)
+    : m_quality(std::clamp(quality, 1, 100)), m_threads(threads) {}
+
+bool JpegEncoder::encode(const std::uint8_t *rgba, sf::Vector2u size, std::ostream &out) const
+{
+    if (!rgba || size.x == 0 || size.y == 0 || size.x > 65535 || size.y > 65535)
+        return false;
+
+    // IJG quality scaling
+    int scale = m_quality < 50 ? 5000 / m_quality : 200 - 2 * m_quality;
+    std::uint8_t lumaQ[64], chromaQ[64];
+    for (int i = 0; i < 64; ++i)
+    {
+        lumaQ[i] = static_cast<std::uint8_t>(std::clamp((LumaQuant[i] * scale + 50) / 100, 1, 255));
+        chromaQ[i] = static_cast<std::uint8_t>(std::clamp((ChromaQuant[i] * scale + 50) / 100, 1, 255));
+    }
+
+    // Fold the AAN output scaling into the quantizer
+    static const float aasf[8] = {1.0f, 1.387039845f, 1.306562965f, 1.175875602f,
+                                  1.0f, 0.785694958f, 0.541196100f, 0.275899379f};
+    float fdLuma[64], fdChroma[64];
+    for (int r = 0; r < 8; ++r)
+        for (int c = 0; c < 8; ++c)
+        {
+            fdLuma[r * 8 + c] = 1.f / (lumaQ[r * 8 + c] * aasf[r] * aasf[c] * 8.f);
+            fdChroma[r * 8 + c] = 1.f / (chromaQ[r * 8 + c] * aasf[r] * aasf[c] * 8.f);
+        }
+
+    const unsigned w = size.x, h = size.y;
+    const unsigned mcusX = (w + 15) / 16, mcusY = (h + 15) / 16;
+
+    // Entropy-code every MCU row independently (restart interval = one row)
+    std::vector<std::vector<std::uint8_t>> rows(mcusY);
+    std::atomic<unsigned> nextRow{0};
+    auto worker = [&]()
+    {
+        float ycc[3][16][16];
+        float block[64];
+        for (unsigned my = nextRow++; my < mcusY; my = nextRow++)
+        {
+            std::vector<std::uint8_t> &data = rows[my];
+            data.reserve(static_cast<std::size_t>(mcusX) * 64);
+            BitWriter bw(data);
+            int prevY = 0, prevCb = 0, prevCr = 0;
+
+            for (unsigned mx = 0; mx < mcusX; ++mx)
+            {
+                // Convert the 16x16 MCU to YCbCr (edges replicate the last pixel)
+                for (int py = 0; py < 16; ++py)
+                {
+                    unsigned y = std::min(h - 1, my * 16 + static_cast<unsigned>(py));
+                    const std::uint8_t *src = rgba + static_cast<std::size_t>(y) * w * 4;
+                    for (int px = 0; px < 16; ++px)
+                    {
+                        unsigned x = std::min(w - 1, mx * 16 + static_cast<unsigned>(px));
+                        const std::uint8_t *p = src + x * 4;
+                        float a = p[3] / 255.f;
+                        float r = p[0] * a + 255.f * (1.f - a);
+                        float g = p[1] * a + 255.f * (1.f - a);
+                        float b = p[2] * a + 255.f * (1.f - a);
+                        ycc[0][py][px] = 0.299f * r + 0.587f * g + 0.114f * b - 128.f;
+                        ycc[1][py][px] = -0.168736f * r - 0.331264f * g + 0.5f * b;
+                        ycc[2][py][px] = 0.5f * r - 0.418688f * g - 0.081312f * b;
+                    }
+                }
+
+                // Four luma blocks
+                for (int by = 0; by < 2; ++by)
+                    for (int bx = 0; bx < 2; ++bx)
+                    {
+                        for (int i = 0; i < 64; ++i)
+                            block[i] = ycc[0][by * 8 + i / 8][bx * 8 + i % 8];
+                        encodeBlock(bw, block, fdLuma, prevY, dcLuma(), acLuma());
+                    }
+
+                // One 2x2-averaged block per chroma component
+                for (int comp = 1; comp <= 2; ++comp)
+                {
+                    for (int i = 0; i < 64; ++i)
+                    {
+                        int r = (i / 8) * 2, c = (i % 8) * 2;
+                        block[i] = 0.25f * (ycc[comp][r][c] + ycc[comp][r][c + 1] +
+                                            ycc[comp][r + 1][c] + ycc[comp][r + 1][c + 1]);
+                    }
+                    encodeBlock(bw, block, fdChroma, comp == 1 ? prevCb : prevCr, dcChroma(), acChroma());
+                }
+            }
+            bw.flush();
+        }
+    };
+
+    // Build the Huffman tables before the workers touch them
+    dcLuma(); dcChroma(); acLuma(); acChroma();
+
+    unsigned threads = m_threads ? m_threads : std::thread::hardware_concurrency();
+    threads = std::max(1u, std::min(threads, mcusY));
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; ++i)
+        pool.emplace_back(worker);
+    worker();
+    for (auto &th : pool)
+        th.join();
+
+    // Headers
+    std::vector<std::uint8_t> head;
+    putMarker(head, 0xD8, 0); // SOI
+
+    const std::uint8_t jfif[] = {'J', 'F', 'I', 'F', 0, 1, 1, 0, 0, 1, 0, 1, 0, 0};
+    putMarker(head, 0xE0, 2 + sizeof(jfif));
+    head.insert(head.end(), jfif, jfif + sizeof(jfif));
+
+    for (int t = 0; t < 2; ++t)
+    {
+        const std::uint8_t *table = t == 0 ? lumaQ : chromaQ;
+        putMarker(head, 0xDB, 2 + 1 + 64);
+        head.push_back(static_cast<std::uint8_t>(t));
+        for (int i = 0; i < 64; ++i)
+            head.push_back(table[ZigZag[i]]);
+    }
+
+    putMarker(head, 0xC0, 2 + 6 + 3 * 3); // SOF0
+    head.push_back(8);
+    putU16(head, h);
+    putU16(head, w);
+    head.push_back(3);
+    const std::uint8_t components[3][3] = {{1, 0x22, 0}, {2, 0x11, 1}, {3, 0x11, 1}};
+    for (const auto &c : components)
+        head.insert(head.end(), c, c + 3);
+
+    putHuffman(head, 0x00, DcLumaBits, DcValues, sizeof(DcValues));
+    putHuffman(head, 0x10, AcLumaBits, AcLumaValues, sizeof(AcLumaValues));
+    putHuffman(head, 0x01, DcChromaBits, DcValues, sizeof(DcValues));
+    putHuffman(head, 0x11, AcChromaBits, AcChromaValues, sizeof(AcChromaValues));
+
+    putMarker(head, 0xDD, 4); // DRI
+    putU16(head, mcusX);
+
+    putMarker(head, 0xDA, 2 + 1 + 3 * 2 + 3); // SOS
+    head.push_back(3);
+    const std::uint8_t scanTables[3][2] = {{1, 0x00}, {2, 0x11}, {3, 0x11}};
+    for (const auto &s : scanTables)
+        head.insert(head.end(), s, s + 2);
+    head.push_back(0);
+    head.push_back(63);
+    head.push_back(0);
+
+    out.write(reinterpret_cast<const char *>(head.data()), static_cast<std::streamsize>(head.size()));
+    for (unsigned my = 0; my < mcusY; ++my)
+    {
+        out.write(reinterpret_cast<const char *>(rows[my].data()), static_cast<std::streamsize>(rows[my].size()));
+        if (my + 1 < mcusY)
+        {
+            const char rst[2] = {static_cast<char>(0xFF), static_cast<char>(0xD0 + my % 8)};
+            out.write(rst, 2);
+        }
+    }
+    const char eoi[2] = {static_cast<char>(0xFF), static_cast<char>(0xD9)};
+    out.write(eoi, 2);
+    return static_cast<bool>(out);
+}
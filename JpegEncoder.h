@@ -0,0 +1,32 @@
+//=============================================================================
+// JpegEncoder.h
+//=============================================================================
+// PURPOSE:
+//   Small baseline JPEG writer for fast preview exports (SFML's writer has a
+//   fixed quality and runs on one thread).
+//
+// KEY FEATURES:
+//   - YCbCr 4:2:0, standard (Annex K) Huffman tables, IJG quality scaling
+//   - AAN floating point forward DCT with scaling folded into quantization
+//   - A restart marker after every MCU row, so rows are entropy coded in
+//     parallel and simply concatenated
+//   - Alpha is composited over white (JPEG has no transparency)
+//
+// WHERE TO MODIFY:
+//   - Chroma subsampling / tables: Modify JpegEncoder.cpp
+//=============================================================================
+
+#pragma once
+
+#include "ImageEncoder.h"
+
+class JpegEncoder : public ImageEncoder {
+public:
+    explicit JpegEncoder(int quality = 90, unsigned threads = 0);
+
+    bool encode(const std::uint8_t* rgba, sf::Vector2u size, std::ostream& out) const override;
+
+private:
+    int m_quality;
+    unsigned m_threads;
+};
@@ -0,0 +1,151 @@
+//=============================================================================
+// LatencyProbe.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the input-to-photon latency measurement
+//   (see LatencyProbe.h).
+//=============================================================================
+
+#include "LatencyProbe.h"
+#include "BrushStroke.h"
+#include "Logger.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    std::int64_t nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    // Upper bounds of the logged distribution, in ms (1, 2, 4 frames at 60 Hz ...)
+    constexpr double DistributionMs[] = {8.0, 16.7, 33.3, 50.0, 66.7, 100.0};
+}
+
+LatencyProbe::LatencyProbe(bool enabled) : m_enabled(enabled) {}
+
+void LatencyProbe::pointerArrived()
+{
+    if (m_enabled)
+        m_arrivalNs = nowNs();
+}
+
+void LatencyProbe::tagVertices(const BrushStroke &stroke, std::size_t vertexEnd)
+{
+    if (!m_enabled || m_arrivalNs < 0)
+        return;
+    m_tags.push_back({&stroke, vertexEnd, m_arrivalNs});
+    m_arrivalNs = -1;
+}
+
+void LatencyProbe::frameDrawn(const std::vector<std::unique_ptr<BrushStroke>> &strokes)
+{
+    if (m_tags.empty())
+        return;
+    const std::int64_t now = nowNs();
+    for (const Tag &tag : m_tags)
+    {
+        // The stroke being drawn is almost always the last one
+        bool drawn = false;
+        for (auto it = strokes.rbegin(); it != strokes.rend(); ++it)
+        {
+            if (it->get() == tag.stroke)
+            {
+                drawn = tag.stroke->getPointCount() >= tag.vertexEnd;
+                break;
+            }
+        }
+        if (drawn)
+            m_drawn.push_back({tag.arrivalNs, now});
+        else
+            ++m_dropped;
+    }
+    m_tags.clear();
+}
+
+void LatencyProbe::framePresented()
+{
+    if (m_drawn.empty())
+        return;
+    const std::int64_t now = nowNs();
+    for (const Drawn &d : m_drawn)
+    {
+        m_toPresentNs.push_back(static_cast<double>(now - d.arrivalNs));
+        m_toDrawNs.push_back(static_cast<double>(d.drawnNs - d.arrivalNs));
+    }
+    m_drawn.clear();
+}
+
+std::vector<BenchmarkResult> LatencyProbe::report() const
+{
+    std::vector<BenchmarkResult> results;
+    if (m_toPresentNs.empty())
+        return results;
+    results.push_back(summarizeSamples("latency/pointer_to_present", "events", 1.0, 1, m_toPresentNs));
+    results.push_back(summarizeSamples("latency/pointer_to_draw", "events", 1.0, 1, m_toDrawNs));
+    return results;
+}
+
+bool LatencyProbe::finish(const std::string &reportPath) const
+{
+    if (!m_enabled)
+        return true;
+    if (m_toPresentNs.empty())
+    {
+        LOG_INFO("Latency") << "No stroke input measured (draw with the brush to collect samples)";
+        return true;
+    }
+
+    char line[160];
+    const auto results = report();
+    for (const auto &r : results)
+    {
+        std::snprintf(line, sizeof(line), "%-28s %7zu x  median %.3f ms  p95 %.3f ms  p99 %.3f ms  max %.3f ms",
+                      r.name.c_str(), r.samples, r.medianNs / 1e6, r.p95Ns / 1e6, r.p99Ns / 1e6, r.maxNs / 1e6);
+        LOG_INFO("Latency") << line;
+    }
+
+    std::size_t counts[std::size(DistributionMs) + 1] = {};
+    for (double ns : m_toPresentNs)
+    {
+        std::size_t i = 0;
+        while (i < std::size(DistributionMs) && ns / 1e6 >= DistributionMs[i])
+            ++i;
+        ++counts[i];
+    }
+    double lower = 0.0;
+    for (std::size_t i = 0; i <= std::size(DistributionMs); ++i)
+    {
+        const double share = 100.0 * static_cast<double>(counts[i]) / static_cast<double>(m_toPresentNs.size());
+        if (i < std::size(DistributionMs))
+            std::snprintf(line, sizeof(line), "  %6.1f - %6.1f ms %7zu  %5.1f%%", lower, DistributionMs[i], counts[i],
+                          share);
+        else
+            std::snprintf(line, sizeof(line), "  %6.1f ms and up  %7zu  %5.1f%%", lower, counts[i], share);
+        LOG_INFO("Latency") << line;
+        if (i < std::size(DistributionMs))
+            lower = DistributionMs[i];
+    }
+    if (m_dropped > 0)
+    {
+        LOG_INFO("Latency") << m_dropped << " events never drawn (stroke removed first)";
+    }
+
+    if (reportPath.empty())
+        return true;
+    std::ofstream out(reportPath);
+    writeBenchmarkJson(out, results);
+    if (!out)
+    {
+        LOG_ERROR("Latency") << "Cannot write report: " << reportPath;
+        return false;
+    }
+    LOG_INFO("Latency") << "Report written to " << reportPath;
+    return true;
+}
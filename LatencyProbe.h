@@ -0,0 +1,88 @@
+//=============================================================================
+// LatencyProbe.h
+//=============================================================================
+// PURPOSE:
+//   Input-to-photon latency measurement for drawing (--latency): how long
+//   a pointer event takes until the stroke vertices it produced are on
+//   screen. Gives "drawing feels laggy" a number that every latency change
+//   can be checked against.
+//
+// HOW IT MEASURES:
+//   1. pointerArrived(): the main loop stamps each pointer event when it
+//      dequeues it from the window
+//   2. tagVertices(): the vertices that event appended to the active
+//      BrushStroke are tagged with the stamp (by vertex index)
+//   3. frameDrawn(): after the scene is drawn, tags whose vertices were part
+//      of it belong to this frame
+//   4. framePresented(): right after window.display() returns, each of those
+//      events yields one sample (display - arrival); drawn - arrival is kept
+//      as well to separate event/draw time from the wait for the swap
+//
+// REPORT:
+//   On exit: median / p95 / p99 / max of latency/pointer_to_present and
+//   latency/pointer_to_draw, plus a coarse distribution; --latency-report
+//   writes them in the benchmark JSON format (Benchmark.h), so runs can be
+//   compared like replay timings.
+//
+// NOTES:
+//   - "Presented" means display() returned: with vsync that includes the
+//     wait for the swap, but not compositor or monitor scan-out delay
+//   - Events whose vertices were never drawn (stroke removed in the same
+//     frame) are counted as dropped instead of measured
+//   - Works with --replay: replayed events are stamped when dequeued
+//=============================================================================
+
+#pragma once
+
+#include "Benchmark.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class BrushStroke;
+
+class LatencyProbe {
+public:
+    explicit LatencyProbe(bool enabled);
+
+    bool isEnabled() const { return m_enabled; }
+
+    // A pointer event was just dequeued
+    void pointerArrived();
+
+    // The last pointer event appended vertices up to `vertexEnd` to `stroke`
+    void tagVertices(const BrushStroke& stroke, std::size_t vertexEnd);
+
+    // Call after the strokes were drawn (before window.display())
+    void frameDrawn(const std::vector<std::unique_ptr<BrushStroke>>& strokes);
+
+    // Call right after window.display()
+    void framePresented();
+
+    std::vector<BenchmarkResult> report() const;
+
+    // Log the report and write it to `reportPath` (if set); false on I/O error
+    bool finish(const std::string& reportPath) const;
+
+private:
+    struct Tag {
+        const BrushStroke* stroke;
+        std::size_t vertexEnd;
+        std::int64_t arrivalNs;
+    };
+
+    struct Drawn {
+        std::int64_t arrivalNs;
+        std::int64_t drawnNs;
+    };
+
+    bool m_enabled;
+    std::int64_t m_arrivalNs{-1};                     // Of the last pointer event
+    std::vector<Tag> m_tags;                          // Waiting to be drawn
+    std::vector<Drawn> m_drawn;                       // Waiting to be presented
+    std::vector<double> m_toPresentNs;
+    std::vector<double> m_toDrawNs;
+    std::size_t m_dropped{0};
+};
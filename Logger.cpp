@@ -0,0 +1,204 @@
+//=============================================================================
+// Logger.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the asynchronous logger (see Logger.h).
+//=============================================================================
+
+#include "Logger.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    // Records written per flush of the console streams
+    constexpr std::size_t BatchSize = 64;
+}
+
+bool parseLogLevel(const std::string &text, LogLevel &out)
+{
+    static const std::pair<const char *, LogLevel> names[] = {
+        {"trace", LogLevel::Trace}, {"debug", LogLevel::Debug}, {"info", LogLevel::Info},
+        {"warn", LogLevel::Warn},   {"error", LogLevel::Error},
+    };
+    for (const auto &[name, level] : names)
+    {
+        if (text == name)
+        {
+            out = level;
+            return true;
+        }
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+// Logger
+//-----------------------------------------------------------------------------
+
+Logger &Logger::getInstance()
+{
+    static Logger instance;
+    return instance;
+}
+
+Logger::Logger() : m_out(&std::cout), m_err(&std::cerr)
+{
+    for (std::size_t i = 0; i < Capacity; ++i)
+        m_cells[i].seq.store(i, std::memory_order_relaxed);
+    m_thread = std::thread([this]() { run(); });
+}
+
+Logger::~Logger()
+{
+    // Runs at static destruction: everything queued is still written
+    m_stop.store(true, std::memory_order_release);
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+void Logger::setStreams(std::ostream &out, std::ostream &err)
+{
+    flush();
+    m_out.store(&out, std::memory_order_release);
+    m_err.store(&err, std::memory_order_release);
+}
+
+bool Logger::push(LogLevel level, const char *tag, std::string_view message)
+{
+    std::uint64_t pos = m_enqueue.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+    for (;;)
+    {
+        cell = &m_cells[pos & (Capacity - 1)];
+        const std::uint64_t seq = cell->seq.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::int64_t>(seq - pos);
+        if (diff == 0)
+        {
+            if (m_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            // Full: the writer is behind by a whole ring
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else
+            pos = m_enqueue.load(std::memory_order_relaxed);
+    }
+
+    Record &r = cell->record;
+    r.level = level;
+    r.tag = tag;
+    r.length = static_cast<std::uint32_t>(std::min(message.size(), MessageSize));
+    std::memcpy(r.text, message.data(), r.length);
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool Logger::pop(Record &out)
+{
+    Cell &cell = m_cells[m_dequeue & (Capacity - 1)];
+    if (cell.seq.load(std::memory_order_acquire) != m_dequeue + 1)
+        return false;
+    out = cell.record;
+    cell.seq.store(m_dequeue + Capacity, std::memory_order_release);
+    ++m_dequeue;
+    return true;
+}
+
+void Logger::flush()
+{
+    if (std::this_thread::get_id() == m_thread.get_id())
+        return;
+    // Cells are claimed in order, so `target` counts every earlier push
+    // (minus drops, which never got a cell)
+    const std::uint64_t target = m_enqueue.load(std::memory_order_acquire);
+    while (m_written.load(std::memory_order_acquire) < target)
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+}
+
+void Logger::run()
+{
+    Record record;
+    std::uint64_t reportedDrops = 0;
+    for (;;)
+    {
+        const bool stopping = m_stop.load(std::memory_order_acquire);
+        std::size_t batch = 0;
+        while (batch < BatchSize && pop(record))
+        {
+            write(record);
+            ++batch;
+        }
+
+        const std::uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+        if (dropped != reportedDrops)
+        {
+            *m_err.load(std::memory_order_acquire) << "[Log] " << dropped - reportedDrops
+                                                   << " lines dropped (queue full)\n";
+            reportedDrops = dropped;
+        }
+
+        if (batch > 0)
+        {
+            m_out.load(std::memory_order_acquire)->flush();
+            m_err.load(std::memory_order_acquire)->flush();
+            m_written.fetch_add(batch, std::memory_order_release);
+        }
+        else if (stopping)
+            break;
+        else
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+}
+
+void Logger::write(const Record &record)
+{
+    std::ostream &out = *(record.level >= LogLevel::Warn ? m_err : m_out).load(std::memory_order_acquire);
+    if (record.tag && *record.tag)
+        out << '[' << record.tag << "] ";
+    out.write(record.text, record.length);
+    if (record.length == MessageSize)
+        out << "...";
+    out << '\n';
+}
+
+//-----------------------------------------------------------------------------
+// LogLine
+//-----------------------------------------------------------------------------
+
+LogLine &LogLine::operator<<(std::string_view text)
+{
+    const std::size_t n = std::min(text.size(), Logger::MessageSize - m_length);
+    std::memcpy(m_text + m_length, text.data(), n);
+    m_length += n;
+    return *this;
+}
+
+LogLine &LogLine::operator<<(double value)
+{
+    char buffer[32];
+    const int n = std::snprintf(buffer, sizeof(buffer), "%g", value);
+    return *this << std::string_view(buffer, n > 0 ? static_cast<std::size_t>(n) : 0);
+}
+
+LogLine &LogLine::operator<<(long long value)
+{
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return *this << std::string_view(buffer, static_cast<std::size_t>(result.ptr - buffer));
+}
+
+LogLine &LogLine::operator<<(unsigned long long value)
+{
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return *this << std::string_view(buffer, static_cast<std::size_t>(result.ptr - buffer));
+}
@@ -0,0 +1,181 @@
+//=============================================================================
+// Logger.h
+//=============================================================================
+// PURPOSE:
+//   Asynchronous logger for the editor: callers format a line into a fixed
+//   buffer and push it into a lock-free ring; a background thread writes
+//   the lines to the console. Console I/O (slow terminals, Windows consoles,
+//   flushes) never runs on the UI thread.
+//
+// USAGE:
+//   LOG_INFO("Undo") << "Undid: " << name;
+//   LOG_WARN("AssetManager") << "Directory not found: " << dir;
+//   Output is "[Undo] Undid: ..."; Trace/Debug/Info go to stdout,
+//   Warn/Error to stderr. The line ends with the statement (no std::endl).
+//
+// LEVELS:
+//   Compile time: statements below COMIC_LOG_LEVEL (0 Trace .. 4 Error,
+//   default 1 = Debug) are discarded entirely, arguments included, e.g.
+//   -DCOMIC_LOG_LEVEL=2 for a build without Debug output.
+//   Run time: Logger::setLevel() (--log-level) filters the rest.
+//
+// QUEUE:
+//   Bounded multi-producer ring (per-slot sequence numbers, no locks) of
+//   Capacity records. When it is full the line is dropped and counted;
+//   logging never blocks the caller. Lines longer than MessageSize are
+//   truncated. The writer thread drains in batches and flushes once per
+//   batch.
+//
+// WHERE TO MODIFY:
+//   - Output format / destinations: Modify Logger::write()
+//   - New value types: Add a LogLine::operator<< overload
+//
+// NOTES:
+//   - Tags must be string literals (only the pointer is queued)
+//   - flush() waits until everything queued so far is written; call it
+//     before redirecting std::cout or writing program output that must
+//     come after the log lines
+//=============================================================================
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+#ifndef COMIC_LOG_LEVEL
+#define COMIC_LOG_LEVEL 1
+#endif
+
+enum class LogLevel
+{
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warn = 3,
+    Error = 4
+};
+
+// Accepts "trace", "debug", "info", "warn", "error"
+bool parseLogLevel(const std::string& text, LogLevel& out);
+
+class Logger {
+public:
+    static constexpr std::size_t Capacity = 4096;     // Records; power of two
+    static constexpr std::size_t MessageSize = 232;   // Bytes per line (truncated)
+
+    static Logger& getInstance();
+
+    void setLevel(LogLevel level) { m_level.store(static_cast<int>(level), std::memory_order_relaxed); }
+    bool accepts(LogLevel level) const
+    {
+        return static_cast<int>(level) >= m_level.load(std::memory_order_relaxed);
+    }
+
+    // Destinations of Trace..Info and of Warn/Error (default cout / cerr)
+    void setStreams(std::ostream& out, std::ostream& err);
+
+    // Queue a line; false if the ring was full (the line is dropped)
+    bool push(LogLevel level, const char* tag, std::string_view message);
+
+    // Block until every line pushed before the call is written
+    void flush();
+
+    std::uint64_t droppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Record {
+        LogLevel level{LogLevel::Info};
+        const char* tag{nullptr};
+        std::uint32_t length{0};
+        char text[MessageSize];
+    };
+
+    struct Cell {
+        std::atomic<std::uint64_t> seq{0};
+        Record record;
+    };
+
+    Logger();
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    bool pop(Record& out);
+    void run();
+    void write(const Record& record);
+
+    std::array<Cell, Capacity> m_cells;
+    alignas(64) std::atomic<std::uint64_t> m_enqueue{0};
+    alignas(64) std::uint64_t m_dequeue{0};           // Writer thread only
+    std::atomic<std::uint64_t> m_written{0};          // Records written so far
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::atomic<int> m_level{static_cast<int>(LogLevel::Debug)};
+    std::atomic<std::ostream*> m_out;
+    std::atomic<std::ostream*> m_err;
+    std::atomic<bool> m_stop{false};
+    std::thread m_thread;
+};
+
+// One log statement: collects the streamed values, queues them on destruction
+class LogLine {
+public:
+    LogLine(LogLevel level, const char* tag) : m_level(level), m_tag(tag) {}
+    ~LogLine() { Logger::getInstance().push(m_level, m_tag, std::string_view(m_text, m_length)); }
+
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    LogLine& operator<<(std::string_view text);
+    LogLine& operator<<(const char* text) { return *this << std::string_view(text ? text : "(null)"); }
+    LogLine& operator<<(const std::string& text) { return *this << std::string_view(text); }
+    LogLine& operator<<(char c) { return *this << std::string_view(&c, 1); }
+    LogLine& operator<<(bool value) { return *this << (value ? "true" : "false"); }
+    LogLine& operator<<(double value);
+    LogLine& operator<<(float value) { return *this << static_cast<double>(value); }
+    LogLine& operator<<(long long value);
+    LogLine& operator<<(unsigned long long value);
+
+    // Remaining integers, then anything printable with operator<<(ostream)
+    template <typename T>
+    LogLine& operator<<(const T& value)
+    {
+        if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+            return *this << static_cast<long long>(value);
+        else if constexpr (std::is_integral_v<T>)
+            return *this << static_cast<unsigned long long>(value);
+        else
+        {
+            std::ostringstream out;
+            out << value;
+            return *this << std::string_view(out.str());
+        }
+    }
+
+private:
+    LogLevel m_level;
+    const char* m_tag;
+    std::size_t m_length{0};
+    char m_text[Logger::MessageSize];
+};
+
+// Statements below COMIC_LOG_LEVEL compile to nothing (the constant test
+// folds away); the rest check the runtime level before formatting anything.
+// A single if/else, so a caller's `if (x) LOG_INFO(...) << ...; else ...`
+// keeps its else
+#define COMIC_LOG(level, tag)                                                        \
+    if (static_cast<int>(level) < COMIC_LOG_LEVEL ||                                 \
+        !Logger::getInstance().accepts(level)) {}                                    \
+    else LogLine(level, tag)
+
+#define LOG_TRACE(tag) COMIC_LOG(LogLevel::Trace, tag)
+#define LOG_DEBUG(tag) COMIC_LOG(LogLevel::Debug, tag)
+#define LOG_INFO(tag) COMIC_LOG(LogLevel::Info, tag)
+#define LOG_WARN(tag) COMIC_LOG(LogLevel::Warn, tag)
+#define LOG_ERROR(tag) COMIC_LOG(LogLevel::Error, tag)
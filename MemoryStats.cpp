@@ -0,0 +1,100 @@
+//=============================================================================
+// MemoryStats.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the per-subsystem memory report (see MemoryStats.h).
+//=============================================================================
+
+#include "MemoryStats.h"
+#include "AssetManager.h"
+#include "Command.h"
+#include "GlyphCache.h"
+#include "Logger.h"
+#include "Scene.h"
+#include "StripDocument.h"
+
+#include <cstdio>
+
+namespace
+{
+    template <typename T>
+    void addObjects(MemoryCategory &category, const std::vector<std::unique_ptr<T>> &objects)
+    {
+        category.bytes += heapBytes(objects);
+        for (const auto &object : objects)
+            category.bytes += object->memoryBytes();
+        category.count += objects.size();
+    }
+}
+
+std::size_t MemoryReport::totalBytes() const
+{
+    std::size_t total = 0;
+    for (const auto &c : categories)
+        total += c.bytes;
+    return total;
+}
+
+MemoryReport collectMemoryReport(const std::vector<const Scene *> &scenes, const CommandManager *commands,
+                                 const StripDocument *strip)
+{
+    MemoryCategory strokes{"Strokes", 0, 0, "strokes"};
+    MemoryCategory bubbles{"Bubbles", 0, 0, "bubbles"};
+    MemoryCategory characters{"Characters", 0, 0, "characters"};
+    MemoryCategory groups{"Groups", 0, 0, "groups"};
+    MemoryCategory paint{"Paint tiles", 0, 0, "tiles"};
+    for (const Scene *scene : scenes)
+    {
+        if (scene->paint)
+        {
+            paint.bytes += scene->paint->memoryBytes();
+            paint.count += scene->paint->tiles().size();
+        }
+        addObjects(strokes, scene->strokes);
+        addObjects(bubbles, scene->bubbles);
+        addObjects(characters, scene->characters);
+        addObjects(groups, scene->groups);
+    }
+
+    MemoryReport report;
+    report.categories = {strokes, bubbles, characters, groups, paint};
+
+    if (commands)
+        report.categories.push_back(
+            {"Undo history", commands->memoryBytes(), commands->getUndoCount() + commands->getRedoCount(), "commands"});
+
+    const AssetMemoryUsage assets = AssetManager::getInstance().getMemoryUsage();
+    report.categories.push_back({"Textures (GPU)", assets.textureBytes, assets.textureCount, "textures"});
+    report.categories.push_back({"Images (CPU)", assets.imageBytes, assets.imageCount, "images"});
+    report.categories.push_back({"Fonts", assets.fontBytes, assets.fontCount, "fonts"});
+
+    std::size_t glyphs = 0;
+    const std::size_t glyphBytes = GlyphCache::getInstance().memoryBytes(&glyphs);
+    report.categories.push_back({"Glyph cache", glyphBytes, glyphs, "glyphs"});
+
+    if (strip)
+        report.categories.push_back({"Strip panel renders", strip->cacheBytes(), strip->getPanelCount(), "panels"});
+    return report;
+}
+
+void logMemoryReport(const MemoryReport &report)
+{
+    for (const auto &c : report.categories)
+        LOG_INFO("Memory") << c.name << ": " << formatBytes(c.bytes) << " (" << c.count << " " << c.unit << ")";
+    LOG_INFO("Memory") << "Total: " << formatBytes(report.totalBytes());
+}
+
+std::string formatBytes(std::size_t bytes)
+{
+    char text[32];
+    const double b = static_cast<double>(bytes);
+    if (bytes >= (std::size_t(1) << 30))
+        std::snprintf(text, sizeof(text), "%.2f GB", b / (1 << 30));
+    else if (bytes >= (std::size_t(1) << 20))
+        std::snprintf(text, sizeof(text), "%.1f MB", b / (1 << 20));
+    else if (bytes >= 1024)
+        std::snprintf(text, sizeof(text), "%.1f KB", b / 1024);
+    else
+        std::snprintf(text, sizeof(text), "%zu B", bytes);
+    return text;
+}
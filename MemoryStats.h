@@ -0,0 +1,75 @@
+//=============================================================================
+// MemoryStats.h
+//=============================================================================
+// PURPOSE:
+//   Per-subsystem memory accounting for long editing sessions: how many
+//   bytes strokes, bubbles, characters, undo history, textures, fonts and
+//   glyph caches hold. Shown in the stats overlay (F3) and logged on demand
+//   (F4); the numbers are the basis for memory budgets.
+//
+// HOW IT IS COUNTED:
+//   Collected on demand by walking the owners; nothing is tracked on the
+//   allocation path. Each owner reports its own bytes:
+//   - CanvasObject::memoryBytes()   object + heap data it owns (vertices,
+//                                   strings, text/shape geometry estimate)
+//   - PaintLayer::memoryBytes()     CPU tiles and their GPU textures
+//   - CommandManager::memoryBytes() both stacks, including objects that
+//                                   only the history keeps alive (deleted
+//                                   objects, undone additions, paint tiles
+//                                   replaced since a snapshot)
+//   - AssetManager::getMemoryUsage() GPU textures (w x h x 4), decoded CPU
+//                                   images, font files
+//   - GlyphCache::memoryBytes()     CPU glyph bitmaps of the software renderer
+//   - StripDocument::cacheBytes()   Cached panel renders
+//   Container overhead (map nodes, allocator slack) is not included, and
+//   SFML's own glyph pages of sf::Font cannot be queried.
+//
+// WHERE TO MODIFY:
+//   - New subsystem: Add a category in collectMemoryReport()
+//   - New object type: Override CanvasObject::memoryBytes()
+//=============================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct Scene;
+class CommandManager;
+class StripDocument;
+
+struct MemoryCategory {
+    std::string name;
+    std::size_t bytes{0};
+    std::size_t count{0};
+    std::string unit;                         // What `count` counts
+};
+
+struct MemoryReport {
+    std::vector<MemoryCategory> categories;
+
+    std::size_t totalBytes() const;
+};
+
+// `scenes` are the edited scene plus any other loaded panels
+MemoryReport collectMemoryReport(const std::vector<const Scene*>& scenes, const CommandManager* commands,
+                                 const StripDocument* strip = nullptr);
+
+// One LOG_INFO line per category plus the total
+void logMemoryReport(const MemoryReport& report);
+
+// "12.3 MB" style
+std::string formatBytes(std::size_t bytes);
+
+// Heap bytes behind a container (0 for strings stored inline)
+inline std::size_t heapBytes(const std::string& s)
+{
+    return s.capacity() > std::string().capacity() ? s.capacity() + 1 : 0;
+}
+
+template <typename T>
+std::size_t heapBytes(const std::vector<T>& v)
+{
+    return v.capacity() * sizeof(T);
+}
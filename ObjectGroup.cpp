@@ -0,0 +1,242 @@
+//=============================================================================
+// ObjectGroup.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the group node (see ObjectGroup.h).
+//=============================================================================
+
+#include "ObjectGroup.h"
+#include "ContentHash.h"
+#include "Logger.h"
+#include "Scene.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    template <typename Objects>
+    void unionBounds(const Objects &objects, sf::Vector2f &lo, sf::Vector2f &hi, bool &any)
+    {
+        for (const auto &o : objects)
+        {
+            const sf::Vector2f p = o->getPosition(), q = p + o->getSize();
+            lo = any ? sf::Vector2f(std::min(lo.x, p.x), std::min(lo.y, p.y)) : p;
+            hi = any ? sf::Vector2f(std::max(hi.x, q.x), std::max(hi.y, q.y)) : q;
+            any = true;
+        }
+    }
+
+    template <typename Objects>
+    std::uint64_t foldHashes(const Objects &objects, std::uint64_t h)
+    {
+        h = hashValue(static_cast<std::uint64_t>(objects.size()), h);
+        for (const auto &o : objects)
+            h = hashValue(o->getContentHash(), h);
+        return h;
+    }
+
+    template <typename Objects>
+    std::size_t sumBytes(const Objects &objects)
+    {
+        std::size_t bytes = objects.capacity() * sizeof(objects.front());
+        for (const auto &o : objects)
+            bytes += o->memoryBytes();
+        return bytes;
+    }
+}
+
+ObjectGroup::ObjectGroup(const std::string &id, Scene members)
+    : CanvasObject(id, 0.f, 0.f, 0.f, 0.f, 0.f), m_members(std::make_unique<Scene>())
+{
+    setMembers(std::move(members));
+}
+
+ObjectGroup::~ObjectGroup() = default;
+
+std::unique_ptr<ObjectGroup> ObjectGroup::clone(const std::string &id) const
+{
+    Scene copy;
+    for (const auto &s : m_members->strokes)
+        copy.strokes.push_back(s->clone(s->getId()));
+    for (const auto &c : m_members->characters)
+        copy.characters.push_back(c->clone(c->getId()));
+    for (const auto &b : m_members->bubbles)
+        copy.bubbles.push_back(b->clone(b->getId()));
+
+    auto group = std::make_unique<ObjectGroup>(id, std::move(copy));
+    group->setSize(m_size);
+    group->setPosition(m_position);
+    group->setFlipped(m_isFlipped);
+    return group;
+}
+
+const Scene &ObjectGroup::members() const { return *m_members; }
+
+std::size_t ObjectGroup::memberCount() const
+{
+    return m_members->strokes.size() + m_members->characters.size() + m_members->bubbles.size();
+}
+
+void ObjectGroup::setMembers(Scene members)
+{
+    m_members->strokes = std::move(members.strokes);
+    m_members->characters = std::move(members.characters);
+    m_members->bubbles = std::move(members.bubbles);
+
+    sf::Vector2f lo, hi;
+    bool any = false;
+    unionBounds(m_members->strokes, lo, hi, any);
+    unionBounds(m_members->characters, lo, hi, any);
+    unionBounds(m_members->bubbles, lo, hi, any);
+    m_content = any ? sf::FloatRect(lo, hi - lo) : sf::FloatRect();
+
+    m_padding = 1.f;
+    for (const auto &s : m_members->strokes)
+        m_padding = std::max(m_padding, std::max(s->getThickness() * 0.5f, 0.5f) + 1.f);
+
+    // Identity transform
+    x_ = m_content.position.x;
+    y_ = m_content.position.y;
+    width_ = m_content.size.x;
+    height_ = m_content.size.y;
+    m_position = m_content.position;
+    m_size = m_content.size;
+    m_isFlipped = false;
+    m_cacheValid = false;
+    touch();
+}
+
+Scene ObjectGroup::takeMembers()
+{
+    Scene members;
+    members.strokes = std::move(m_members->strokes);
+    members.characters = std::move(m_members->characters);
+    members.bubbles = std::move(m_members->bubbles);
+    m_members->strokes.clear();
+    m_members->characters.clear();
+    m_members->bubbles.clear();
+    m_cacheValid = false;
+    touch();
+    return members;
+}
+
+sf::FloatRect ObjectGroup::contentBounds() const { return m_content; }
+
+Placement ObjectGroup::worldPlacement(CanvasObject &member) const
+{
+    // An empty extent (e.g. one straight stroke) is not scaled
+    const float sx = m_content.size.x > 0.f ? width_ / m_content.size.x : 1.f;
+    const float sy = m_content.size.y > 0.f ? height_ / m_content.size.y : 1.f;
+
+    Placement p = Placement::of(&member);
+    const float left = (p.position.x - m_content.position.x) * sx;
+    p.size = {p.size.x * sx, p.size.y * sy};
+    p.position.x = m_isFlipped ? x_ + width_ - left - p.size.x : x_ + left;
+    p.position.y = y_ + (p.position.y - m_content.position.y) * sy;
+    p.flipped = p.flipped != m_isFlipped;
+    return p;
+}
+
+template <typename Member>
+std::unique_ptr<Member> ObjectGroup::placedClone(Member &member) const
+{
+    Placement p = worldPlacement(member);
+    auto copy = member.clone(member.getId());
+    p.object = copy.get();
+    p.apply();
+    return copy;
+}
+
+Scene ObjectGroup::worldMembers() const
+{
+    Scene world;
+    for (const auto &s : m_members->strokes)
+        world.strokes.push_back(placedClone(*s));
+    for (const auto &c : m_members->characters)
+        world.characters.push_back(placedClone(*c));
+    for (const auto &b : m_members->bubbles)
+        world.bubbles.push_back(placedClone(*b));
+    return world;
+}
+
+void ObjectGroup::draw(sf::RenderTarget &target)
+{
+    if (!m_cacheValid || m_cacheExtent != m_size || m_cacheFlipped != m_isFlipped)
+        rebuildCache();
+
+    if (m_cache)
+    {
+        // The texture holds premultiplied colors (drawn over transparent)
+        sf::Sprite sprite(m_cache->getTexture());
+        sprite.setPosition(m_position + m_cacheOffset);
+        sf::RenderStates states;
+        states.blendMode = sf::BlendMode(sf::BlendMode::Factor::One, sf::BlendMode::Factor::OneMinusSrcAlpha);
+        target.draw(sprite, states);
+        return;
+    }
+
+    // Too large for a texture: draw the members directly
+    Scene world = worldMembers();
+    for (const auto &s : world.strokes)
+        s->draw(target);
+    for (const auto &c : world.characters)
+        c->draw(target);
+    for (const auto &b : world.bubbles)
+        b->draw(target);
+}
+
+void ObjectGroup::rebuildCache()
+{
+    m_cacheValid = true;
+    m_cacheExtent = m_size;
+    m_cacheFlipped = m_isFlipped;
+
+    // Pixel-aligned, so the sprite is crisp where the group was rendered
+    const sf::Vector2f origin(std::floor(x_ - m_padding), std::floor(y_ - m_padding));
+    m_cacheOffset = origin - m_position;
+    const sf::Vector2u size(static_cast<unsigned>(std::ceil(x_ + std::max(width_, 0.f) + m_padding - origin.x)),
+                            static_cast<unsigned>(std::ceil(y_ + std::max(height_, 0.f) + m_padding - origin.y)));
+    if (!m_cache)
+        m_cache.emplace();
+    if (m_cache->getSize() != size && !m_cache->resize(size))
+    {
+        LOG_WARN("Group") << getId() << ": no " << size.x << "x" << size.y << " cache texture, drawing members";
+        m_cache.reset();
+        return;
+    }
+
+    // Render at the group's current place; moving it later keeps the texture
+    m_cache->setView(sf::View(sf::FloatRect(origin, {static_cast<float>(size.x), static_cast<float>(size.y)})));
+    m_cache->clear(sf::Color::Transparent);
+    Scene world = worldMembers();
+    for (const auto &s : world.strokes)
+        s->draw(*m_cache);
+    for (const auto &c : world.characters)
+        c->draw(*m_cache);
+    for (const auto &b : world.bubbles)
+        b->draw(*m_cache);
+    m_cache->display();
+}
+
+bool ObjectGroup::isClicked(float mouseX, float mouseY) const
+{
+    return mouseX >= x_ && mouseX <= x_ + width_ && mouseY >= y_ && mouseY <= y_ + height_;
+}
+
+std::size_t ObjectGroup::memoryBytes() const
+{
+    std::size_t bytes = CanvasObject::memoryBytes() + sizeof(ObjectGroup) - sizeof(CanvasObject) + sizeof(Scene);
+    bytes += sumBytes(m_members->strokes) + sumBytes(m_members->characters) + sumBytes(m_members->bubbles);
+    if (m_cache)
+        bytes += static_cast<std::size_t>(m_cache->getSize().x) * m_cache->getSize().y * 4;
+    return bytes;
+}
+
+std::uint64_t ObjectGroup::computeContentHash() const
+{
+    std::uint64_t h = CanvasObject::computeContentHash();
+    h = foldHashes(m_members->strokes, h);
+    h = foldHashes(m_members->characters, h);
+    return foldHashes(m_members->bubbles, h);
+}
@@ -0,0 +1,99 @@
+//=============================================================================
+// ObjectGroup.h
+//=============================================================================
+// PURPOSE:
+//   Group node: strokes, characters and bubbles combined into one object
+//   that moves, resizes and flips as a unit and is drawn from a cached
+//   texture while it does not change.
+//
+// TRANSFORM:
+//   Members keep the coordinates they had when they were grouped (the
+//   group's local space, spanning contentBounds()). The group's own
+//   CanvasObject rect and flip are its transform: contentBounds() is mapped
+//   onto (x, y, width, height), mirrored when flipped. Moving a group only
+//   changes that rect; no member is touched.
+//
+// RENDERING:
+//   - Editor: draw() keeps the members rendered into an sf::RenderTexture
+//     at the group's current size and draws it as one sprite (premultiplied
+//     alpha). Moving reuses the texture; it is rebuilt only after a resize,
+//     a flip or a change of members
+//   - Everything else (CPU renderer, SVG, ungroup) uses worldMembers() /
+//     worldPlacement(): each member is placed by its own rect and flip
+//     (Placement), so strokes keep their thickness and bubble text is never
+//     mirrored, exactly as in the cached texture
+//
+// NOTES:
+//   - Groups are not nested; members are strokes, characters and bubbles
+//   - Members are owned by the group. Scenes draw groups after bubbles
+//=============================================================================
+
+#pragma once
+
+#include "CanvasObject.h"
+
+#include <SFML/Graphics.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+
+struct Scene;
+
+class ObjectGroup : public CanvasObject {
+public:
+    // Takes the members (paint layer ignored); the group starts with the
+    // identity transform, its rect equal to the members' bounds
+    ObjectGroup(const std::string& id, Scene members);
+    ~ObjectGroup() override;
+
+    ObjectGroup(const ObjectGroup&) = delete;
+    ObjectGroup& operator=(const ObjectGroup&) = delete;
+
+    // Deep copy with a new id and the same transform; stroke points stay
+    // shared (BrushStroke::clone)
+    std::unique_ptr<ObjectGroup> clone(const std::string& id) const;
+
+    const Scene& members() const;
+    std::size_t memberCount() const;
+
+    // Replace / hand back the members (group and ungroup undo). Replacing
+    // resets the transform to the identity
+    void setMembers(Scene members);
+    Scene takeMembers();
+
+    // Bounds of the members in local space
+    sf::FloatRect contentBounds() const;
+
+    // Where a member (local) ends up in the world
+    Placement worldPlacement(CanvasObject& member) const;
+
+    // Clones of the members placed in the world, for renderers and export
+    Scene worldMembers() const;
+
+    // CanvasObject interface
+    void draw(sf::RenderTarget& target) override;
+    bool isClicked(float mouseX, float mouseY) const override;
+
+    // Members plus the cached texture
+    std::size_t memoryBytes() const override;
+
+protected:
+    std::uint64_t computeContentHash() const override;
+
+private:
+    void rebuildCache();
+
+    template <typename Member>
+    std::unique_ptr<Member> placedClone(Member& member) const;
+
+    std::unique_ptr<Scene> m_members;
+    sf::FloatRect m_content;
+    float m_padding{1.f};                          // Strokes reach past their points
+
+    std::optional<sf::RenderTexture> m_cache;     // Empty until drawn or if too large
+    sf::Vector2f m_cacheExtent{-1.f, -1.f};       // Group size it was rendered at
+    sf::Vector2f m_cacheOffset;                   // Texture origin - group position
+    bool m_cacheFlipped{false};
+    bool m_cacheValid{false};
+};
@@ -0,0 +1,295 @@
+//=============================================================================
+// PaintLayer.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the tiled raster paint layer (see PaintLayer.h).
+//=============================================================================
+
+#include "PaintLayer.h"
+#include "ContentHash.h"
+#include "ImageEncoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    std::uint64_t nextTileId()
+    {
+        static std::uint64_t id = 0;
+        return ++id;
+    }
+
+    // Tile coordinate of a world pixel (floor division)
+    int tileOf(int pixel)
+    {
+        return pixel >= 0 ? pixel / PaintLayer::TileSize : -((-pixel - 1) / PaintLayer::TileSize) - 1;
+    }
+
+    // Source-over with straight alpha; `sa` is the source alpha 0..1
+    void blendOver(std::uint8_t *dst, sf::Color color, float sa)
+    {
+        const float da = static_cast<float>(dst[3]) / 255.f;
+        const float outA = sa + da * (1.f - sa);
+        const float keep = da * (1.f - sa);
+        const std::uint8_t src[3] = {color.r, color.g, color.b};
+        for (int c = 0; c < 3; ++c)
+            dst[c] = static_cast<std::uint8_t>(
+                std::lround((static_cast<float>(src[c]) * sa + static_cast<float>(dst[c]) * keep) / outA));
+        dst[3] = static_cast<std::uint8_t>(std::lround(outA * 255.f));
+    }
+}
+
+PaintLayer::Tile &PaintLayer::writableTile(TileKey key)
+{
+    auto it = m_tiles.find(key);
+    if (it == m_tiles.end())
+    {
+        auto tile = std::make_shared<Tile>();
+        tile->pixels.assign(TileBytes, 0);
+        tile->id = nextTileId();
+        it = m_tiles.emplace(key, std::move(tile)).first;
+    }
+    else if (it->second.use_count() > 1)
+    {
+        // Still shared with a snapshot: copy before writing
+        auto copy = std::make_shared<Tile>(*it->second);
+        copy->id = nextTileId();
+        it->second = std::move(copy);
+    }
+    return *it->second;
+}
+
+void PaintLayer::markDirty(TileKey key, int y0, int y1)
+{
+    auto [it, inserted] = m_dirtyRows.try_emplace(key, y0, y1);
+    if (!inserted)
+        it->second = {std::min(it->second.first, y0), std::max(it->second.second, y1)};
+}
+
+void PaintLayer::dab(sf::Vector2f center, float radius, sf::Color color, bool erase)
+{
+    const float r = std::max(radius, 0.5f);
+    const int px0 = static_cast<int>(std::floor(center.x - r - 0.5f));
+    const int py0 = static_cast<int>(std::floor(center.y - r - 0.5f));
+    const int px1 = static_cast<int>(std::ceil(center.x + r + 0.5f));
+    const int py1 = static_cast<int>(std::ceil(center.y + r + 0.5f));
+    const float strength = static_cast<float>(color.a) / 255.f;
+    if (strength <= 0.f)
+        return;
+
+    for (int ty = tileOf(py0); ty <= tileOf(py1 - 1); ++ty)
+    {
+        for (int tx = tileOf(px0); tx <= tileOf(px1 - 1); ++tx)
+        {
+            const TileKey key{tx, ty};
+            Tile &tile = writableTile(key);
+            const int ox = tx * TileSize, oy = ty * TileSize;
+            const int y0 = std::max(py0, oy) - oy, y1 = std::min(py1, oy + TileSize) - oy;
+            const int x0 = std::max(px0, ox) - ox, x1 = std::min(px1, ox + TileSize) - ox;
+
+            for (int y = y0; y < y1; ++y)
+            {
+                const float dy = static_cast<float>(oy + y) + 0.5f - center.y;
+                std::uint8_t *dst = tile.pixels.data() + (static_cast<std::size_t>(y) * TileSize + x0) * 4;
+                for (int x = x0; x < x1; ++x, dst += 4)
+                {
+                    const float dx = static_cast<float>(ox + x) + 0.5f - center.x;
+                    // One pixel of antialiasing at the rim
+                    const float coverage = std::clamp(r + 0.5f - std::sqrt(dx * dx + dy * dy), 0.f, 1.f);
+                    const float sa = coverage * strength;
+                    if (sa <= 0.f)
+                        continue;
+
+                    if (erase)
+                        dst[3] = static_cast<std::uint8_t>(std::lround(dst[3] * (1.f - sa)));
+                    else
+                        blendOver(dst, color, sa);
+                }
+            }
+            ++tile.edits;
+            markDirty(key, y0, y1);
+        }
+    }
+    ++m_revision;
+}
+
+void PaintLayer::segment(sf::Vector2f from, sf::Vector2f to, float radius, sf::Color color, bool erase)
+{
+    const sf::Vector2f d = to - from;
+    const float length = std::sqrt(d.x * d.x + d.y * d.y);
+    const float spacing = std::max(radius * 0.25f, 0.5f);
+    const int steps = std::max(1, static_cast<int>(std::ceil(length / spacing)));
+    for (int i = 1; i <= steps; ++i)
+        dab(from + d * (static_cast<float>(i) / static_cast<float>(steps)), radius, color, erase);
+}
+
+void PaintLayer::fillMask(const std::uint8_t *mask, sf::Vector2u size, const sf::IntRect &bounds, sf::Vector2i origin,
+                          sf::Color color)
+{
+    const int w = static_cast<int>(size.x);
+    const int mx0 = std::max(bounds.position.x, 0), mx1 = std::min(bounds.position.x + bounds.size.x, w);
+    const int my0 = std::max(bounds.position.y, 0),
+              my1 = std::min(bounds.position.y + bounds.size.y, static_cast<int>(size.y));
+    if (mx0 >= mx1 || my0 >= my1 || color.a == 0)
+        return;
+    const float sa = static_cast<float>(color.a) / 255.f;
+    const std::uint8_t opaque[4] = {color.r, color.g, color.b, 255};
+
+    // World pixel range of the bounds
+    const int px0 = origin.x + mx0, px1 = origin.x + mx1;
+    const int py0 = origin.y + my0, py1 = origin.y + my1;
+    for (int ty = tileOf(py0); ty <= tileOf(py1 - 1); ++ty)
+    {
+        for (int tx = tileOf(px0); tx <= tileOf(px1 - 1); ++tx)
+        {
+            const int ox = tx * TileSize, oy = ty * TileSize;
+            const int y0 = std::max(py0, oy) - oy, y1 = std::min(py1, oy + TileSize) - oy;
+            const int x0 = std::max(px0, ox) - ox, x1 = std::min(px1, ox + TileSize) - ox;
+            auto maskRow = [&](int y) {
+                return mask + static_cast<std::size_t>(oy + y - origin.y) * size.x + (ox + x0 - origin.x);
+            };
+
+            // Leave tiles the region misses alone (no empty tiles, no clones)
+            int first = y1, last = y0;
+            for (int y = y0; y < y1; ++y)
+            {
+                const std::uint8_t *m = maskRow(y);
+                if (std::find(m, m + (x1 - x0), 1) != m + (x1 - x0))
+                {
+                    first = std::min(first, y);
+                    last = y + 1;
+                }
+            }
+            if (first >= last)
+                continue;
+
+            const TileKey key{tx, ty};
+            Tile &tile = writableTile(key);
+            for (int y = first; y < last; ++y)
+            {
+                const std::uint8_t *m = maskRow(y);
+                std::uint8_t *dst = tile.pixels.data() + (static_cast<std::size_t>(y) * TileSize + x0) * 4;
+                for (int x = x0; x < x1; ++x, ++m, dst += 4)
+                {
+                    if (!*m)
+                        continue;
+                    if (color.a == 255)
+                        std::copy_n(opaque, 4, dst);
+                    else
+                        blendOver(dst, color, sa);
+                }
+            }
+            ++tile.edits;
+            markDirty(key, first, last);
+        }
+    }
+    ++m_revision;
+}
+
+PaintLayer::Snapshot PaintLayer::snapshot() const
+{
+    return Snapshot(m_tiles.begin(), m_tiles.end());
+}
+
+void PaintLayer::restore(const Snapshot &snapshot)
+{
+    m_tiles.clear();
+    for (const auto &[key, tile] : snapshot)
+        m_tiles.emplace(key, std::const_pointer_cast<Tile>(tile));
+    // Swapped tiles have new ids and are uploaded whole
+    m_dirtyRows.clear();
+    ++m_revision;
+}
+
+std::size_t PaintLayer::changedTiles(const Snapshot &before, const Snapshot &after)
+{
+    std::size_t changed = 0;
+    for (const auto &[key, tile] : after)
+    {
+        auto it = before.find(key);
+        if (it == before.end() || it->second != tile)
+            ++changed;
+    }
+    return changed;
+}
+
+void PaintLayer::draw(sf::RenderTarget &target)
+{
+    // Textures of tiles an undo removed
+    for (auto it = m_gpu.begin(); it != m_gpu.end();)
+        it = m_tiles.count(it->first) ? std::next(it) : m_gpu.erase(it);
+
+    for (const auto &[key, tile] : m_tiles)
+    {
+        GpuTile &gpu = m_gpu[key];
+        if (gpu.tileId != tile->id)
+        {
+            if (gpu.tileId == 0 && !gpu.texture.resize({TileSize, TileSize}))
+                continue;
+            gpu.texture.update(tile->pixels.data());
+            gpu.tileId = tile->id;
+        }
+        else if (auto dirty = m_dirtyRows.find(key); dirty != m_dirtyRows.end())
+        {
+            const auto [y0, y1] = dirty->second;
+            gpu.texture.update(tile->pixels.data() + static_cast<std::size_t>(y0) * TileSize * 4,
+                               {static_cast<unsigned>(TileSize), static_cast<unsigned>(y1 - y0)},
+                               {0u, static_cast<unsigned>(y0)});
+        }
+
+        sf::Sprite sprite(gpu.texture);
+        sprite.setPosition({static_cast<float>(key.x * TileSize), static_cast<float>(key.y * TileSize)});
+        target.draw(sprite);
+    }
+    m_dirtyRows.clear();
+}
+
+std::uint64_t PaintLayer::contentHash() const
+{
+    std::uint64_t h = hashValue(static_cast<std::uint64_t>(m_tiles.size()));
+    for (const auto &[key, tile] : m_tiles)
+    {
+        if (tile->hashedEdits != tile->edits)
+        {
+            tile->hash = fnv1a64(tile->pixels.data(), tile->pixels.size());
+            tile->hashedEdits = tile->edits;
+        }
+        h = hashValue(key.x, h);
+        h = hashValue(key.y, h);
+        h = hashValue(tile->hash, h);
+    }
+    return h;
+}
+
+std::size_t PaintLayer::memoryBytes() const
+{
+    return sizeof(PaintLayer) + m_tiles.size() * (sizeof(Tile) + TileBytes) + m_gpu.size() * TileBytes;
+}
+
+std::string PaintLayer::encodeTile(const Tile &tile)
+{
+    EncoderSettings settings;
+    settings.threads = 1;
+    std::ostringstream out(std::ios::binary);
+    if (!createImageEncoder(ImageFormat::Png, settings)->encode(tile.pixels.data(), {TileSize, TileSize}, out))
+        throw std::runtime_error("Paint tile encoding failed");
+    return out.str();
+}
+
+void PaintLayer::setTile(TileKey key, const std::string &png)
+{
+    sf::Image image;
+    if (!image.loadFromMemory(png.data(), png.size()))
+        throw std::runtime_error("Invalid paint tile image");
+    if (image.getSize() != sf::Vector2u(TileSize, TileSize))
+        throw std::runtime_error("Paint tile is not " + std::to_string(TileSize) + "x" + std::to_string(TileSize));
+
+    auto tile = std::make_shared<Tile>();
+    tile->pixels.assign(image.getPixelsPtr(), image.getPixelsPtr() + TileBytes);
+    tile->id = nextTileId();
+    m_tiles[key] = std::move(tile);
+    ++m_revision;
+}
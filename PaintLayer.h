@@ -0,0 +1,127 @@
+//=============================================================================
+// PaintLayer.h
+//=============================================================================
+// PURPOSE:
+//   Raster paint layer: an alternative to vector BrushStrokes whose drawing
+//   cost does not grow with everything ever painted. Brush dabs are stamped
+//   straight into fixed-size RGBA tiles; a frame draws one sprite per
+//   painted tile and only re-uploads the rows that changed.
+//
+// KEY FEATURES:
+//   - Sparse 256x256 tiles on a world-aligned grid, created on first paint
+//   - dab()/segment(): antialiased round dabs, painted (source-over) or
+//     erased back to transparent
+//   - fillMask(): writes a bucket fill region (FloodFill.h) into the tiles
+//   - Copy-on-write tiles: snapshot() copies tile pointers only; the first
+//     dab into a tile a snapshot still shares clones that one tile. Undo
+//     (PaintCommand) keeps the before/after snapshots of a stroke, so the
+//     history only holds the tiles the stroke touched
+//   - Dirty tracking: a new or swapped tile is uploaded whole, edits in
+//     place upload just their row band
+//
+// PIXEL FORMAT:
+//   Straight (non-premultiplied) RGBA8, transparent where nothing was
+//   painted, composited like an sf::Sprite with BlendAlpha. Drawn under
+//   strokes, characters and bubbles (see Scene.h).
+//
+// WHERE TO MODIFY:
+//   - Brush shape / hardness: Modify PaintLayer::dab()
+//   - Tile size: TileSize (project files store it per tile, see encodeTile)
+//
+// NOTES:
+//   - Editor thread only; renderers read tiles() while nothing paints
+//=============================================================================
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class PaintLayer {
+public:
+    static constexpr int TileSize = 256;
+    static constexpr std::size_t TileBytes = static_cast<std::size_t>(TileSize) * TileSize * 4;
+
+    struct Tile {
+        std::vector<std::uint8_t> pixels;             // TileBytes, straight RGBA
+        std::uint64_t id{0};                          // New for every created/cloned tile
+        std::uint64_t edits{0};                       // Bumped by every in-place change
+        mutable std::uint64_t hash{0};                // Content hash at `hashedEdits`
+        mutable std::uint64_t hashedEdits{UINT64_MAX};
+    };
+
+    // World tile coordinates; ordered row by row
+    struct TileKey {
+        int x{0}, y{0};
+        bool operator<(const TileKey& other) const { return y != other.y ? y < other.y : x < other.x; }
+        bool operator==(const TileKey& other) const { return x == other.x && y == other.y; }
+    };
+
+    using Snapshot = std::map<TileKey, std::shared_ptr<const Tile>>;
+
+    PaintLayer() = default;
+    PaintLayer(const PaintLayer&) = delete;
+    PaintLayer& operator=(const PaintLayer&) = delete;
+
+    // One round dab (radius in world units); erase lowers alpha instead
+    void dab(sf::Vector2f center, float radius, sf::Color color, bool erase = false);
+
+    // Dabs from `from` (exclusive) to `to`, spaced for a continuous line
+    void segment(sf::Vector2f from, sf::Vector2f to, float radius, sf::Color color, bool erase = false);
+
+    // Paint `color` (opaque over, like a dab at full coverage) where `mask`
+    // is set. The mask is size.x * size.y bytes placed with its top-left at
+    // world pixel `origin`; only tiles with set pixels inside `bounds` (mask
+    // coordinates) are touched
+    void fillMask(const std::uint8_t* mask, sf::Vector2u size, const sf::IntRect& bounds, sf::Vector2i origin,
+                  sf::Color color);
+
+    // O(tiles) pointer copy; tiles are shared until painted again
+    Snapshot snapshot() const;
+    void restore(const Snapshot& snapshot);
+
+    // Tiles that differ between two snapshots (what an undo step holds)
+    static std::size_t changedTiles(const Snapshot& before, const Snapshot& after);
+
+    // Upload changed tiles, then draw every tile as a sprite
+    void draw(sf::RenderTarget& target);
+
+    const std::map<TileKey, std::shared_ptr<Tile>>& tiles() const { return m_tiles; }
+    bool empty() const { return m_tiles.empty(); }
+
+    // Bumped by every change (paint, restore, setTile)
+    std::uint64_t revision() const { return m_revision; }
+
+    // Hash of all tiles (export cache); per-tile hashes are cached
+    std::uint64_t contentHash() const;
+
+    // CPU tiles plus their GPU copies
+    std::size_t memoryBytes() const;
+
+    // PNG bytes of a tile, used by project files and SVG export
+    static std::string encodeTile(const Tile& tile);
+
+    // Replace a tile with decoded PNG bytes (TileSize x TileSize); throws
+    // std::runtime_error on bad data
+    void setTile(TileKey key, const std::string& png);
+
+private:
+    struct GpuTile {
+        sf::Texture texture;
+        std::uint64_t tileId{0};                      // 0 = nothing uploaded yet
+    };
+
+    // The tile at `key`, created or cloned so that only this layer owns it
+    Tile& writableTile(TileKey key);
+    void markDirty(TileKey key, int y0, int y1);
+
+    std::map<TileKey, std::shared_ptr<Tile>> m_tiles;
+    std::map<TileKey, GpuTile> m_gpu;
+    std::map<TileKey, std::pair<int, int>> m_dirtyRows;   // Edited in place since the last draw
+    std::uint64_t m_revision{0};
+};
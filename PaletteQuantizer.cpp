@@ -0,0 +1,323 @@
+//=============================================================================
+// PaletteQuantizer.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the palette quantizer (see PaletteQuantizer.h).
+//=============================================================================
+
+#include "PaletteQuantizer.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+    // Histogram cell: 5 bits each of R, G, B and 3 bits of alpha
+    constexpr unsigned CellBits = 18;
+    constexpr std::size_t CellCount = std::size_t(1) << CellBits;
+
+    inline std::uint32_t cellOf(const std::uint8_t *p)
+    {
+        return (std::uint32_t(p[0] >> 3) << 13) | (std::uint32_t(p[1] >> 3) << 8) |
+               (std::uint32_t(p[2] >> 3) << 3) | std::uint32_t(p[3] >> 5);
+    }
+
+    // Cell coordinate along one axis, scaled to 0..255
+    inline int cellAxis(std::uint32_t cell, int axis)
+    {
+        switch (axis)
+        {
+        case 0: return static_cast<int>((cell >> 13) & 31) << 3;
+        case 1: return static_cast<int>((cell >> 8) & 31) << 3;
+        case 2: return static_cast<int>((cell >> 3) & 31) << 3;
+        default: return static_cast<int>(cell & 7) << 5;
+        }
+    }
+
+    struct Cell
+    {
+        std::uint32_t id{0};
+        std::uint64_t count{0};
+        std::array<std::uint64_t, 4> sum{};
+    };
+
+    struct Box
+    {
+        std::size_t begin{0}, end{0};         // Range in the cell list
+        std::uint64_t count{0};
+        int axis{0};                          // Widest axis
+        int range{0};                         // Its extent (0..255)
+    };
+
+    void measure(Box &box, const std::vector<Cell> &cells)
+    {
+        int lo[4] = {255, 255, 255, 255}, hi[4] = {0, 0, 0, 0};
+        box.count = 0;
+        for (std::size_t i = box.begin; i < box.end; ++i)
+        {
+            box.count += cells[i].count;
+            for (int a = 0; a < 4; ++a)
+            {
+                int v = cellAxis(cells[i].id, a);
+                lo[a] = std::min(lo[a], v);
+                hi[a] = std::max(hi[a], v);
+            }
+        }
+        box.range = -1;
+        for (int a = 0; a < 4; ++a)
+        {
+            if (hi[a] - lo[a] > box.range)
+            {
+                box.range = hi[a] - lo[a];
+                box.axis = a;
+            }
+        }
+    }
+
+    // Run fn(y0, y1) over row blocks on `threads` threads (caller included)
+    template <typename Fn>
+    void forRows(unsigned height, unsigned threads, Fn fn)
+    {
+        constexpr unsigned BlockRows = 64;
+        const unsigned blocks = (height + BlockRows - 1) / BlockRows;
+        std::atomic<unsigned> next{0};
+        auto worker = [&]()
+        {
+            for (unsigned b = next++; b < blocks; b = next++)
+                fn(b * BlockRows, std::min(height, (b + 1) * BlockRows));
+        };
+
+        threads = threads ? threads : std::thread::hardware_concurrency();
+        threads = std::max(1u, std::min(threads, blocks));
+        std::vector<std::thread> pool;
+        for (unsigned i = 1; i < threads; ++i)
+            pool.emplace_back(worker);
+        worker();
+        for (auto &th : pool)
+            th.join();
+    }
+
+    // Move translucent entries to the front (keeps tRNS short)
+    void sortTranslucentFirst(IndexedImage &image)
+    {
+        const std::size_t n = image.palette.size();
+        std::vector<std::uint8_t> order(n);
+        for (std::size_t i = 0; i < n; ++i)
+            order[i] = static_cast<std::uint8_t>(i);
+        std::stable_partition(order.begin(), order.end(),
+                              [&](std::uint8_t i) { return image.palette[i].a < 255; });
+
+        bool identity = true;
+        std::array<std::uint8_t, 256> remap{};
+        std::vector<sf::Color> sorted(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            sorted[i] = image.palette[order[i]];
+            remap[order[i]] = static_cast<std::uint8_t>(i);
+            identity = identity && order[i] == i;
+        }
+        if (identity)
+            return;
+
+        image.palette = std::move(sorted);
+        for (auto &index : image.indices)
+            index = remap[index];
+    }
+}
+
+unsigned IndexedImage::bitDepth() const
+{
+    const std::size_t n = palette.size();
+    return n <= 2 ? 1 : n <= 4 ? 2 : n <= 16 ? 4 : 8;
+}
+
+std::size_t IndexedImage::translucentCount() const
+{
+    std::size_t n = 0;
+    while (n < palette.size() && palette[n].a < 255)
+        ++n;
+    return n;
+}
+
+PaletteQuantizer::PaletteQuantizer(unsigned maxColors, unsigned threads)
+    : m_maxColors(std::clamp(maxColors, 2u, 256u)), m_threads(threads)
+{
+}
+
+IndexedImage PaletteQuantizer::quantize(const std::uint8_t *rgba, sf::Vector2u size) const
+{
+    IndexedImage out;
+    out.size = size;
+    if (!rgba || size.x == 0 || size.y == 0)
+        return out;
+
+    if (!quantizeExact(rgba, out))
+        medianCut(rgba, out);
+    sortTranslucentFirst(out);
+    return out;
+}
+
+bool PaletteQuantizer::quantizeExact(const std::uint8_t *rgba, IndexedImage &out) const
+{
+    const std::size_t pixels = static_cast<std::size_t>(out.size.x) * out.size.y;
+    out.indices.resize(pixels);
+
+    // Open addressing, at most 25% full
+    constexpr std::size_t Slots = 1024;
+    std::array<std::uint32_t, Slots> keys{};
+    std::array<std::int16_t, Slots> values;
+    values.fill(-1);
+    std::vector<std::uint32_t> colors;
+
+    std::uint32_t lastKey = 0;
+    std::uint8_t lastIndex = 0;
+    bool haveLast = false;
+    for (std::size_t i = 0; i < pixels; ++i)
+    {
+        std::uint32_t key;
+        std::memcpy(&key, rgba + i * 4, 4);
+        if (haveLast && key == lastKey) // Flat areas: same color as the previous pixel
+        {
+            out.indices[i] = lastIndex;
+            continue;
+        }
+
+        std::size_t slot = (key * 2654435761u) >> 22;
+        while (values[slot] >= 0 && keys[slot] != key)
+            slot = (slot + 1) & (Slots - 1);
+        if (values[slot] < 0)
+        {
+            if (colors.size() == m_maxColors)
+                return false;
+            keys[slot] = key;
+            values[slot] = static_cast<std::int16_t>(colors.size());
+            colors.push_back(key);
+        }
+
+        lastKey = key;
+        lastIndex = static_cast<std::uint8_t>(values[slot]);
+        haveLast = true;
+        out.indices[i] = lastIndex;
+    }
+
+    out.palette.clear();
+    for (std::uint32_t key : colors)
+    {
+        std::uint8_t c[4];
+        std::memcpy(c, &key, 4);
+        out.palette.emplace_back(c[0], c[1], c[2], c[3]);
+    }
+    out.exact = true;
+    return true;
+}
+
+void PaletteQuantizer::medianCut(const std::uint8_t *rgba, IndexedImage &out) const
+{
+    const std::size_t width = out.size.x;
+
+    // 1. Histogram with per-cell color sums (for exact box means)
+    std::vector<std::uint32_t> slotOf(CellCount, ~0u);
+    std::vector<Cell> cells;
+    const std::size_t pixels = width * out.size.y;
+    for (std::size_t i = 0; i < pixels; ++i)
+    {
+        const std::uint8_t *p = rgba + i * 4;
+        std::uint32_t id = cellOf(p);
+        if (slotOf[id] == ~0u)
+        {
+            slotOf[id] = static_cast<std::uint32_t>(cells.size());
+            cells.push_back(Cell{id, 0, {}});
+        }
+        Cell &cell = cells[slotOf[id]];
+        ++cell.count;
+        for (int c = 0; c < 4; ++c)
+            cell.sum[c] += p[c];
+    }
+
+    // 2. Split boxes until the palette is full or nothing can be split
+    std::vector<Box> boxes(1);
+    boxes[0].end = cells.size();
+    measure(boxes[0], cells);
+    while (boxes.size() < m_maxColors)
+    {
+        Box *target = nullptr;
+        std::uint64_t bestScore = 0;
+        for (auto &box : boxes)
+        {
+            std::uint64_t score = box.count * static_cast<std::uint64_t>(box.range);
+            if (box.end - box.begin > 1 && box.range > 0 && score > bestScore)
+            {
+                bestScore = score;
+                target = &box;
+            }
+        }
+        if (!target)
+            break;
+
+        const int axis = target->axis;
+        std::sort(cells.begin() + target->begin, cells.begin() + target->end,
+                  [axis](const Cell &a, const Cell &b) { return cellAxis(a.id, axis) < cellAxis(b.id, axis); });
+
+        // Weighted median, keeping both halves non-empty
+        std::uint64_t half = target->count / 2, seen = 0;
+        std::size_t split = target->begin;
+        while (split < target->end - 1 && seen + cells[split].count <= half)
+            seen += cells[split++].count;
+        split = std::max(split, target->begin + 1);
+
+        Box upper;
+        upper.begin = split;
+        upper.end = target->end;
+        target->end = split;
+        measure(*target, cells);
+        measure(upper, cells);
+        boxes.push_back(upper); // May reallocate: `target` is not used after this
+    }
+
+    // 3. Palette = box means; every cell maps to the nearest entry
+    out.palette.clear();
+    for (const auto &box : boxes)
+    {
+        std::array<std::uint64_t, 4> sum{};
+        for (std::size_t i = box.begin; i < box.end; ++i)
+            for (int c = 0; c < 4; ++c)
+                sum[c] += cells[i].sum[c];
+        auto mean = [&](int c) { return static_cast<std::uint8_t>((sum[c] + box.count / 2) / box.count); };
+        out.palette.emplace_back(mean(0), mean(1), mean(2), mean(3));
+    }
+
+    std::vector<std::uint8_t> cellPalette(CellCount, 0);
+    for (const auto &cell : cells)
+    {
+        int c[4];
+        for (int k = 0; k < 4; ++k)
+            c[k] = static_cast<int>((cell.sum[k] + cell.count / 2) / cell.count);
+
+        int best = 0;
+        long bestDist = -1;
+        for (std::size_t i = 0; i < out.palette.size(); ++i)
+        {
+            const sf::Color &p = out.palette[i];
+            long dr = c[0] - p.r, dg = c[1] - p.g, db = c[2] - p.b, da = c[3] - p.a;
+            long dist = dr * dr + dg * dg + db * db + da * da;
+            if (bestDist < 0 || dist < bestDist)
+            {
+                bestDist = dist;
+                best = static_cast<int>(i);
+            }
+        }
+        cellPalette[cell.id] = static_cast<std::uint8_t>(best);
+    }
+
+    // 4. Map pixels (parallel over row blocks)
+    out.indices.resize(pixels);
+    forRows(out.size.y, m_threads, [&](unsigned y0, unsigned y1)
+    {
+        for (std::size_t i = y0 * width; i < y1 * width; ++i)
+            out.indices[i] = cellPalette[cellOf(rgba + i * 4)];
+    });
+    out.exact = false;
+}
@@ -0,0 +1,55 @@
+//=============================================================================
+// PaletteQuantizer.h
+//=============================================================================
+// PURPOSE:
+//   Reduces an RGBA8 image to an indexed palette for small PNG exports
+//   (comic pages are mostly flat colors).
+//
+// KEY FEATURES:
+//   - Exact: images with <= maxColors distinct colors keep every color; the
+//     scan stops as soon as the limit is exceeded
+//   - Otherwise median cut over a 5-5-5-3 bit (RGB + alpha) histogram: the
+//     box with the most pixels x widest range is split at its weighted
+//     median until the palette is full; entries are the box means
+//   - Pixels map to the nearest entry, cached per histogram cell, no
+//     dithering (dither noise defeats PNG compression on flat art)
+//   - Translucent entries are sorted first so tRNS stays short
+//
+// WHERE TO MODIFY:
+//   - Histogram precision: Modify the bit split in PaletteQuantizer.cpp
+//   - Split heuristic: Modify PaletteQuantizer::medianCut()
+//=============================================================================
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <vector>
+
+struct IndexedImage {
+    sf::Vector2u size{0, 0};
+    std::vector<sf::Color> palette;           // 1..256 entries, translucent first
+    std::vector<std::uint8_t> indices;        // One palette index per pixel
+    bool exact{false};                        // True if no color was approximated
+
+    // Smallest PNG bit depth that holds the palette (1, 2, 4 or 8)
+    unsigned bitDepth() const;
+
+    // Palette entries with alpha < 255 (they precede all opaque entries)
+    std::size_t translucentCount() const;
+};
+
+class PaletteQuantizer {
+public:
+    explicit PaletteQuantizer(unsigned maxColors = 256, unsigned threads = 0);
+
+    IndexedImage quantize(const std::uint8_t* rgba, sf::Vector2u size) const;
+
+private:
+    bool quantizeExact(const std::uint8_t* rgba, IndexedImage& out) const;
+    void medianCut(const std::uint8_t* rgba, IndexedImage& out) const;
+
+    unsigned m_maxColors;
+    unsigned m_threads;
+};
@@ -0,0 +1,308 @@
+//=============================================================================
+// PerfGate.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the performance regression gate (see PerfGate.h).
+//=============================================================================
+
+#include "PerfGate.h"
+#include "Process.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    std::string formatNs(double ns)
+    {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(ns < 10.0 ? 2 : 1);
+        if (ns >= 1e9)
+            out << ns / 1e9 << " s";
+        else if (ns >= 1e6)
+            out << ns / 1e6 << " ms";
+        else if (ns >= 1e3)
+            out << ns / 1e3 << " us";
+        else
+            out << ns << " ns";
+        return out.str();
+    }
+
+    std::string formatChange(double ratio)
+    {
+        std::ostringstream out;
+        out << std::showpos << std::fixed << std::setprecision(1) << (ratio - 1.0) * 100.0 << "%";
+        return out.str();
+    }
+
+    const char *verdictName(PerfGate::Verdict v)
+    {
+        switch (v)
+        {
+        case PerfGate::Verdict::Ok:
+            return "ok";
+        case PerfGate::Verdict::Faster:
+            return "FASTER";
+        case PerfGate::Verdict::Noisy:
+            return "NOISY";
+        case PerfGate::Verdict::Regression:
+            return "REGRESSION";
+        case PerfGate::Verdict::Missing:
+            return "MISSING";
+        case PerfGate::Verdict::New:
+            return "NEW";
+        }
+        return "?";
+    }
+
+    // P(X <= k) for X ~ Binomial(n, 1/2)
+    double binomialCdf(std::size_t k, std::size_t n)
+    {
+        double term = std::pow(0.5, static_cast<double>(n));   // C(n,0) / 2^n
+        double sum = term;
+        for (std::size_t i = 1; i <= k; ++i)
+        {
+            term *= static_cast<double>(n - i + 1) / static_cast<double>(i);
+            sum += term;
+        }
+        return sum;
+    }
+
+    // Whitespace-separated editor arguments of a scenario (FILE.args)
+    std::vector<std::string> scenarioArgs(const std::string &scenario)
+    {
+        std::vector<std::string> args;
+        std::ifstream in(fs::path(scenario).replace_extension(".args"));
+        std::string arg;
+        while (in >> std::quoted(arg))
+            args.push_back(arg);
+        return args;
+    }
+}
+
+PerfGate::PerfGate(const PerfGateOptions &options, const BenchmarkRunner &runner)
+    : m_options(options), m_runner(runner)
+{
+    m_options.runs = std::max(1u, m_options.runs);
+}
+
+PerfGate::Estimate PerfGate::estimate(std::vector<double> values, double confidence)
+{
+    Estimate e;
+    if (values.empty())
+        return e;
+
+    std::sort(values.begin(), values.end());
+    const std::size_t n = values.size();
+    e.median = n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2.0;
+
+    // Largest k with P(X < k) <= alpha/2: [x(k), x(n-k+1)] (1-based) covers
+    // the true median with at least `confidence`, whatever the distribution
+    const double tail = (1.0 - confidence) / 2.0;
+    std::size_t k = 0;
+    while (k + 1 <= n / 2 && binomialCdf(k, n) <= tail)
+        ++k;
+    const std::size_t lo = k > 0 ? k - 1 : 0;
+    e.low = values[lo];
+    e.high = values[n - 1 - lo];
+    return e;
+}
+
+PerfGate::Verdict PerfGate::judge(double baseline, const Estimate &current, double threshold)
+{
+    const double limit = baseline * (1.0 + threshold);
+    if (current.low > limit)
+        return Verdict::Regression;
+    if (current.median > limit)
+        return Verdict::Noisy;
+    if (current.high < baseline * (1.0 - threshold))
+        return Verdict::Faster;
+    return Verdict::Ok;
+}
+
+double PerfGate::thresholdFor(const std::string &name, const BenchmarkThresholds &thresholds) const
+{
+    double threshold = m_options.defaultThreshold;
+    std::size_t best = 0;
+    bool found = false;
+    for (const auto &[prefix, value] : thresholds)
+    {
+        if (prefix == "default")
+        {
+            if (!found)
+                threshold = value;
+        }
+        else if (name.compare(0, prefix.size(), prefix) == 0 && (!found || prefix.size() > best))
+        {
+            threshold = value;
+            best = prefix.size();
+            found = true;
+        }
+    }
+    return threshold;
+}
+
+void PerfGate::collectRun(unsigned run, std::ostream &log)
+{
+    auto add = [this](const BenchmarkResult &r, const std::string &name, double value)
+    {
+        auto it = std::find_if(m_metrics.begin(), m_metrics.end(), [&](const auto &m) { return m.first == name; });
+        if (it == m_metrics.end())
+        {
+            Metric m;
+            m.unit = r.unit;
+            m.ops = r.ops;
+            m.itemsPerOp = r.medianNs > 0.0 ? r.itemsPerSecond * r.medianNs / 1e9 : 1.0;
+            m_metrics.emplace_back(name, std::move(m));
+            it = std::prev(m_metrics.end());
+        }
+        it->second.values.push_back(value);
+    };
+
+    log << "[Gate] Run " << run + 1 << "/" << m_options.runs << "\n";
+    for (const auto &r : m_runner.run(log))
+        add(r, r.name, r.medianNs);
+
+    for (const auto &scenario : m_options.scenarios)
+    {
+        const std::string tmp = replayScenario(scenario, run, log);
+        std::ifstream in(tmp);
+        if (!in)
+            throw std::runtime_error("Replay wrote no report: " + scenario);
+        const std::string prefix = "replay:" + fs::path(scenario).stem().string() + "/";
+        for (const auto &r : readBenchmarkJson(in))
+        {
+            const std::string kind = r.name.substr(r.name.find('/') + 1);
+            add(r, prefix + kind, r.medianNs);
+            add(r, prefix + kind + "@p95", r.p95Ns);
+        }
+        in.close();
+        fs::remove(tmp);
+    }
+}
+
+std::string PerfGate::replayScenario(const std::string &scenario, unsigned run, std::ostream &log)
+{
+    if (m_options.app.empty() || !fs::exists(m_options.app))
+        throw std::runtime_error("Editor executable not found (--app): " + m_options.app);
+
+    const std::string tmp =
+        (fs::temp_directory_path() / ("perfgate-" + fs::path(scenario).stem().string() + ".json")).string();
+    std::vector<std::string> args{m_options.app};
+    for (auto &arg : scenarioArgs(scenario))
+        args.push_back(std::move(arg));
+    for (const char *arg : {"--replay", scenario.c_str(), "--fast", "--replay-report", tmp.c_str()})
+        args.emplace_back(arg);
+
+    log << "[Gate] Replaying " << scenario << " (run " << run + 1 << ")\n";
+    const int code = runProcess(args);
+    if (code != 0)
+        throw std::runtime_error("Replay of " + scenario + " failed (exit code " + std::to_string(code) + ")");
+    return tmp;
+}
+
+int PerfGate::run(std::ostream &log, std::ostream &report)
+{
+    // Existing thresholds are kept on update; a fresh file gets the default
+    BenchmarkThresholds thresholds;
+    std::vector<BenchmarkResult> baseline;
+    {
+        std::ifstream in(m_options.baselinePath);
+        if (in)
+            baseline = readBenchmarkJson(in, &thresholds);
+        else if (!m_options.updateBaseline)
+        {
+            log << "[Gate] No baseline at " << m_options.baselinePath << " (run with --update-baseline)\n";
+            return 1;
+        }
+    }
+    if (thresholds.empty())
+        thresholds.emplace_back("default", m_options.defaultThreshold);
+
+    // Runs are interleaved (suite, scenarios, suite, ...) so slow drift of
+    // the machine spreads over every metric instead of biasing one
+    m_metrics.clear();
+    for (unsigned r = 0; r < m_options.runs; ++r)
+        collectRun(r, log);
+
+    if (m_options.updateBaseline)
+    {
+        std::vector<BenchmarkResult> results;
+        for (const auto &[name, m] : m_metrics)
+            results.push_back(summarizeSamples(name, m.unit, m.itemsPerOp, m.ops, m.values));
+
+        const fs::path path(m_options.baselinePath);
+        if (path.has_parent_path())
+            fs::create_directories(path.parent_path());
+        std::ofstream out(path);
+        writeBenchmarkJson(out, results, thresholds);
+        if (!out)
+            throw std::runtime_error("Write failed: " + m_options.baselinePath);
+        log << "[Gate] Baseline with " << results.size() << " metrics (" << m_options.runs << " runs) written to "
+            << m_options.baselinePath << "\n";
+        return 0;
+    }
+
+    std::map<std::string, double> base;
+    for (const auto &r : baseline)
+        base[r.name] = r.medianNs;
+
+    const int pct = static_cast<int>(std::lround(m_options.confidence * 100.0));
+    report << std::left << std::setw(36) << "metric" << std::right << std::setw(12) << "baseline" << std::setw(12)
+           << "current" << "  " << std::left << std::setw(24) << (std::to_string(pct) + "% interval") << std::right
+           << std::setw(8) << "limit" << std::setw(9) << "change" << "  verdict\n";
+
+    std::map<Verdict, std::size_t> counts;
+    for (const auto &[name, m] : m_metrics)
+    {
+        const Estimate e = estimate(m.values, m_options.confidence);
+        const double threshold = thresholdFor(name, thresholds);
+        auto b = base.find(name);
+        const Verdict v = b == base.end() ? Verdict::New : judge(b->second, e, threshold);
+        ++counts[v];
+
+        std::ostringstream limit;
+        limit << "+" << std::lround(threshold * 100.0) << "%";
+        report << std::left << std::setw(36) << name << std::right << std::setw(12)
+               << (b == base.end() ? "-" : formatNs(b->second)) << std::setw(12) << formatNs(e.median) << "  "
+               << std::left << std::setw(24) << (formatNs(e.low) + " .. " + formatNs(e.high)) << std::right
+               << std::setw(8) << limit.str() << std::setw(9)
+               << (b == base.end() || b->second <= 0.0 ? "" : formatChange(e.median / b->second)) << "  "
+               << verdictName(v) << "\n";
+        if (b != base.end())
+            base.erase(b);
+    }
+    for (const auto &[name, ns] : base)
+    {
+        ++counts[Verdict::Missing];
+        report << std::left << std::setw(36) << name << std::right << std::setw(12) << formatNs(ns) << std::setw(12)
+               << "-" << "  " << std::left << std::setw(24) << "" << std::right << std::setw(8) << "" << std::setw(9)
+               << "" << "  " << verdictName(Verdict::Missing) << "\n";
+    }
+
+    // A metric without a baseline is unchecked, not passed: an empty or
+    // stale baseline must not turn the gate green
+    const std::size_t regressions = counts[Verdict::Regression];
+    const std::size_t unchecked = counts[Verdict::New];
+    report << "\n" << m_metrics.size() << " metrics over " << m_options.runs << " runs: " << regressions
+           << " regressions, " << counts[Verdict::Noisy] << " noisy, " << counts[Verdict::Faster] << " faster, "
+           << unchecked << " new, " << counts[Verdict::Missing] << " missing\n";
+    if (counts[Verdict::Noisy] > 0)
+        report << "NOISY metrics exceed their limit at the median only; rerun with more --runs to decide.\n";
+    if (unchecked > 0)
+        report << "NEW metrics have no baseline to compare against; record them with --update-baseline.\n";
+    else if (counts[Verdict::Faster] > 0 || counts[Verdict::Missing] > 0)
+        report << "Record intended changes with --update-baseline.\n";
+    const bool pass = regressions == 0 && unchecked == 0;
+    report << (pass ? "PASS" : "FAIL") << std::endl;
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+//=============================================================================
+// PerfGate.h
+//=============================================================================
+// PURPOSE:
+//   Performance regression gate of the ComicBenchmarks executable: runs the
+//   benchmark suite and recorded editor sessions several times, compares
+//   the results with a committed baseline (perf/baseline.json) and fails
+//   when a metric got slower than its threshold allows.
+//
+// METRICS:
+//   - Every benchmark case (ns per op)
+//   - For every --scenario FILE.rec: the editor is started with
+//     `--replay FILE.rec --fast --replay-report <tmp>` (plus the arguments
+//     in FILE.args next to it, e.g. `--generate 5000 --seed 3`) and its
+//     report gives "replay:<name>/frame", "replay:<name>/<event kind>" and
+//     the same with "@p95" (95th percentile instead of median)
+//
+// NOISE HANDLING:
+//   Each run yields one value per metric (the median of its samples); the
+//   current value is the median over `runs` runs, with a distribution-free
+//   confidence interval from the order statistics of the runs (binomial
+//   ranks; with fewer than 6 runs it is the min..max range).
+//   Verdicts, with limit = baseline x (1 + threshold):
+//     REGRESSION  the whole interval is above the limit (fails the gate)
+//     NOISY       the median is above the limit but the interval is not
+//                 (warning: rerun with more --runs)
+//     FASTER      the whole interval is below baseline x (1 - threshold)
+//     ok          otherwise; MISSING / NEW when only one side has it
+//   NEW (a metric the baseline has no result for) also fails the gate, so
+//   the committed baseline, which ships without results, fails every check
+//   until it is recorded on the gating machine with --update-baseline.
+//   MISSING (a baseline metric this run did not produce, e.g. a scenario
+//   not passed) is reported only.
+//
+// BASELINE FILE:
+//   Benchmark.h JSON plus "thresholds": { "<name prefix>": ratio, ... };
+//   the longest matching prefix wins, "default" applies to the rest.
+//   --update-baseline rewrites the results and keeps the thresholds.
+//
+// WHERE TO MODIFY:
+//   - Verdict rules: Modify PerfGate::judge()
+//   - Per-metric thresholds: Edit perf/baseline.json
+//=============================================================================
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+
+struct PerfGateOptions {
+    std::string baselinePath{"perf/baseline.json"};
+    unsigned runs{5};                         // Repetitions of suite + scenarios
+    bool updateBaseline{false};               // Record instead of compare
+    std::vector<std::string> scenarios;       // *.rec files to replay
+    std::string app;                          // ComicStripMaker executable
+    double confidence{0.95};                  // Of the median interval
+    double defaultThreshold{0.10};            // When the baseline names none
+};
+
+class PerfGate {
+public:
+    enum class Verdict
+    {
+        Ok,
+        Faster,
+        Noisy,
+        Regression,
+        Missing,
+        New
+    };
+
+    PerfGate(const PerfGateOptions& options, const BenchmarkRunner& runner);
+
+    // Progress goes to `log`, the report to `report`. Returns the exit code
+    // (0 = no regression / baseline written, 1 = regression, a metric
+    // without baseline, or error).
+    int run(std::ostream& log, std::ostream& report);
+
+    // Median of `values` and its order-statistic confidence interval
+    struct Estimate {
+        double median{0.0};
+        double low{0.0};
+        double high{0.0};
+    };
+    static Estimate estimate(std::vector<double> values, double confidence);
+
+    static Verdict judge(double baseline, const Estimate& current, double threshold);
+
+private:
+    struct Metric {
+        std::string unit;
+        double itemsPerOp{1.0};
+        std::uint64_t ops{0};
+        std::vector<double> values;           // One per run (ns)
+    };
+
+    void collectRun(unsigned run, std::ostream& log);
+    // Returns the path of the replay report
+    std::string replayScenario(const std::string& scenario, unsigned run, std::ostream& log);
+    double thresholdFor(const std::string& name, const BenchmarkThresholds& thresholds) const;
+
+    PerfGateOptions m_options;
+    const BenchmarkRunner& m_runner;
+    std::vector<std::pair<std::string, Metric>> m_metrics;   // In first-seen order
+};
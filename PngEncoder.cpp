@@ -0,0 +1,342 @@
+//=============================================================================
+// PngEncoder.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the parallel PNG writer (see PngEncoder.h).
+//
+// PIPELINE:
+//   1. Split the scanlines into bands of >= MinBandBytes.
+//   2. Worker threads pull bands from an atomic counter. For each band:
+//      filter its rows, re-filter the rows just before it to rebuild the
+//      32 KiB dictionary, then raw-deflate. Non-final bands end with
+//      Z_SYNC_FLUSH (byte aligned, stream left open), the last with Z_FINISH.
+//   3. Concatenate: zlib header + band segments + combined Adler-32.
+//   4. Wrap in IHDR / (PLTE / tRNS) / IDAT / IEND chunks.
+//=============================================================================
+
+#include "PngEncoder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#include <zlib.h>
+
+namespace
+{
+    constexpr std::size_t DictionarySize = 32 * 1024;
+    constexpr std::size_t IdatChunkSize = 1024 * 1024;
+
+    std::uint8_t paeth(int a, int b, int c)
+    {
+        int p = a + b - c;
+        int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+        if (pa <= pb && pa <= pc)
+            return static_cast<std::uint8_t>(a);
+        return static_cast<std::uint8_t>(pb <= pc ? b : c);
+    }
+
+    // Apply PNG filter `type` to one row (prev == nullptr for the first row)
+    void applyFilter(int type, const std::uint8_t *cur, const std::uint8_t *prev,
+                     std::size_t n, unsigned bpp, std::uint8_t *out)
+    {
+        static const std::vector<std::uint8_t> zeros(1 << 16, 0);
+        std::vector<std::uint8_t> zeroRow;
+        if (!prev)
+        {
+            if (n > zeros.size())
+                zeroRow.assign(n, 0);
+            prev = n > zeros.size() ? zeroRow.data() : zeros.data();
+        }
+
+        const std::size_t head = std::min<std::size_t>(bpp, n);
+        switch (type)
+        {
+        case 1: // Sub
+            std::memcpy(out, cur, head);
+            for (std::size_t i = bpp; i < n; ++i)
+                out[i] = static_cast<std::uint8_t>(cur[i] - cur[i - bpp]);
+            break;
+        case 2: // Up
+            for (std::size_t i = 0; i < n; ++i)
+                out[i] = static_cast<std::uint8_t>(cur[i] - prev[i]);
+            break;
+        case 3: // Average
+            for (std::size_t i = 0; i < head; ++i)
+                out[i] = static_cast<std::uint8_t>(cur[i] - (prev[i] >> 1));
+            for (std::size_t i = bpp; i < n; ++i)
+                out[i] = static_cast<std::uint8_t>(cur[i] - ((cur[i - bpp] + prev[i]) >> 1));
+            break;
+        case 4: // Paeth
+            for (std::size_t i = 0; i < head; ++i)
+                out[i] = static_cast<std::uint8_t>(cur[i] - prev[i]);
+            for (std::size_t i = bpp; i < n; ++i)
+                out[i] = static_cast<std::uint8_t>(cur[i] - paeth(cur[i - bpp], prev[i], prev[i - bpp]));
+            break;
+        default: // None
+            std::memcpy(out, cur, n);
+            break;
+        }
+    }
+
+    // Filter one row, writing the filter byte + data to `out`.
+    // Level 0 stores unfiltered; otherwise pick the filter with the smallest
+    // sum of absolute (signed) residuals, like libpng's heuristic.
+    void filterRow(const std::uint8_t *cur, const std::uint8_t *prev, std::size_t n,
+                   unsigned bpp, int level, std::uint8_t *out, std::vector<std::uint8_t> &scratch)
+    {
+        if (level == 0)
+        {
+            out[0] = 0;
+            std::memcpy(out + 1, cur, n);
+            return;
+        }
+
+        scratch.resize(n);
+        std::uint64_t best = ~0ull;
+        for (int type = 0; type < 5; ++type)
+        {
+            applyFilter(type, cur, prev, n, bpp, scratch.data());
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < n && sum < best; ++i)
+                sum += static_cast<std::uint64_t>(std::abs(static_cast<int>(static_cast<std::int8_t>(scratch[i]))));
+            if (sum < best)
+            {
+                best = sum;
+                out[0] = static_cast<std::uint8_t>(type);
+                std::memcpy(out + 1, scratch.data(), n);
+            }
+        }
+    }
+
+    void putU32(std::vector<std::uint8_t> &out, std::uint32_t v)
+    {
+        out.push_back(static_cast<std::uint8_t>(v >> 24));
+        out.push_back(static_cast<std::uint8_t>(v >> 16));
+        out.push_back(static_cast<std::uint8_t>(v >> 8));
+        out.push_back(static_cast<std::uint8_t>(v));
+    }
+
+    void writeChunk(std::vector<std::uint8_t> &out, const char *type,
+                    const std::uint8_t *data, std::size_t size)
+    {
+        putU32(out, static_cast<std::uint32_t>(size));
+        std::size_t start = out.size();
+        out.insert(out.end(), type, type + 4);
+        if (size)
+            out.insert(out.end(), data, data + size);
+        uLong crc = crc32(0L, out.data() + start, static_cast<uInt>(4 + size));
+        putU32(out, static_cast<std::uint32_t>(crc));
+    }
+
+    struct Band
+    {
+        unsigned y0{0}, y1{0};
+        std::vector<std::uint8_t> deflated;
+        uLong adler{1};
+        std::size_t filteredBytes{0};
+        bool ok{false};
+    };
+}
+
+PngEncoder::PngEncoder(const PngSettings &settings) : m_settings(settings)
+{
+    m_settings.compressionLevel = std::clamp(m_settings.compressionLevel, 0, 9);
+}
+
+std::vector<std::uint8_t> PngEncoder::compress(const std::uint8_t *rows, unsigned height,
+                                               std::size_t rowBytes, unsigned bytesPerPixel,
+                                               bool adaptiveFilter) const
+{
+    const int level = m_settings.compressionLevel;
+    const int filterLevel = adaptiveFilter ? level : 0; // filterRow: 0 = no filter
+    const int strategy = level && adaptiveFilter ? Z_FILTERED : Z_DEFAULT_STRATEGY;
+    const std::size_t lineBytes = rowBytes + 1; // filter byte + data
+
+    // Split scanlines into bands
+    unsigned bandRows = static_cast<unsigned>(std::max<std::size_t>(1, MinBandBytes / lineBytes));
+    std::vector<Band> bands;
+    for (unsigned y = 0; y < height; y += bandRows)
+    {
+        Band b;
+        b.y0 = y;
+        b.y1 = std::min(height, y + bandRows);
+        bands.push_back(std::move(b));
+    }
+
+    auto row = [&](unsigned y) { return rows + static_cast<std::size_t>(y) * rowBytes; };
+
+    std::atomic<std::size_t> nextBand{0};
+    auto worker = [&]()
+    {
+        std::vector<std::uint8_t> filtered, dictionary, scratch;
+        for (std::size_t i = nextBand++; i < bands.size(); i = nextBand++)
+        {
+            Band &band = bands[i];
+
+            filtered.resize(static_cast<std::size_t>(band.y1 - band.y0) * lineBytes);
+            for (unsigned y = band.y0; y < band.y1; ++y)
+                filterRow(row(y), y ? row(y - 1) : nullptr, rowBytes, bytesPerPixel, filterLevel,
+                          filtered.data() + (y - band.y0) * lineBytes, scratch);
+            band.filteredBytes = filtered.size();
+            band.adler = adler32(1L, filtered.data(), static_cast<uInt>(filtered.size()));
+
+            z_stream zs{};
+            if (deflateInit2(&zs, level, Z_DEFLATED, -15, 8, strategy) != Z_OK)
+                continue;
+
+            // Rebuild the tail of the previous band (filtering is deterministic)
+            if (band.y0 > 0 && level > 0)
+            {
+                unsigned dictRows = static_cast<unsigned>((DictionarySize + lineBytes - 1) / lineBytes);
+                unsigned start = band.y0 > dictRows ? band.y0 - dictRows : 0;
+                dictionary.resize(static_cast<std::size_t>(band.y0 - start) * lineBytes);
+                for (unsigned y = start; y < band.y0; ++y)
+                    filterRow(row(y), y ? row(y - 1) : nullptr, rowBytes, bytesPerPixel, filterLevel,
+                              dictionary.data() + (y - start) * lineBytes, scratch);
+                std::size_t dictBytes = std::min(dictionary.size(), DictionarySize);
+                deflateSetDictionary(&zs, dictionary.data() + dictionary.size() - dictBytes,
+                                     static_cast<uInt>(dictBytes));
+            }
+
+            const bool last = (i + 1 == bands.size());
+            band.deflated.resize(deflateBound(&zs, static_cast<uLong>(filtered.size())) + 16);
+            zs.next_in = filtered.data();
+            zs.avail_in = static_cast<uInt>(filtered.size());
+            zs.next_out = band.deflated.data();
+            zs.avail_out = static_cast<uInt>(band.deflated.size());
+            int rc = deflate(&zs, last ? Z_FINISH : Z_SYNC_FLUSH);
+            band.ok = last ? rc == Z_STREAM_END : (rc == Z_OK && zs.avail_in == 0 && zs.avail_out > 0);
+            band.deflated.resize(zs.total_out);
+            deflateEnd(&zs);
+        }
+    };
+
+    unsigned threads = m_settings.threads ? m_settings.threads : std::thread::hardware_concurrency();
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(bands.size())));
+
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; ++i)
+        pool.emplace_back(worker);
+    worker();
+    for (auto &th : pool)
+        th.join();
+
+    // zlib header: deflate, 32K window, level hint, FCHECK so header % 31 == 0
+    std::size_t total = 6;
+    for (const auto &band : bands)
+        total += band.deflated.size();
+
+    std::vector<std::uint8_t> stream;
+    stream.reserve(total);
+    std::uint8_t cmf = 0x78;
+    std::uint8_t flevel = level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3;
+    std::uint8_t flg = static_cast<std::uint8_t>(flevel << 6);
+    flg = static_cast<std::uint8_t>(flg + (31 - ((cmf * 256 + flg) % 31)) % 31);
+    stream.push_back(cmf);
+    stream.push_back(flg);
+
+    uLong adler = 1L;
+    for (auto &band : bands)
+    {
+        if (!band.ok)
+            return {};
+        stream.insert(stream.end(), band.deflated.begin(), band.deflated.end());
+        std::vector<std::uint8_t>().swap(band.deflated); // Free as we go
+        adler = adler32_combine(adler, band.adler, static_cast<z_off_t>(band.filteredBytes));
+    }
+    putU32(stream, static_cast<std::uint32_t>(adler));
+    return stream;
+}
+
+std::vector<std::uint8_t> PngEncoder::encode(const std::uint8_t *rgba, sf::Vector2u size) const
+{
+    if (!rgba || size.x == 0 || size.y == 0)
+        return {};
+
+    std::vector<std::uint8_t> zdata = compress(rgba, size.y, static_cast<std::size_t>(size.x) * 4, 4);
+    if (zdata.empty())
+        return {};
+    return wrapChunks(size, 8, 6, {}, {}, zdata); // 8-bit RGBA
+}
+
+std::vector<std::uint8_t> PngEncoder::encodeIndexed(const IndexedImage &image) const
+{
+    const sf::Vector2u size = image.size;
+    if (size.x == 0 || size.y == 0 || image.palette.empty() || image.palette.size() > 256 ||
+        image.indices.size() != static_cast<std::size_t>(size.x) * size.y)
+        return {};
+
+    // Pack indices MSB first (PNG bit order), rows padded to whole bytes
+    const unsigned depth = image.bitDepth();
+    const unsigned perByte = 8 / depth;
+    const std::size_t rowBytes = (static_cast<std::size_t>(size.x) + perByte - 1) / perByte;
+    std::vector<std::uint8_t> packed;
+    const std::uint8_t *rows = image.indices.data();
+    if (depth < 8)
+    {
+        packed.assign(rowBytes * size.y, 0);
+        for (unsigned y = 0; y < size.y; ++y)
+        {
+            const std::uint8_t *src = image.indices.data() + static_cast<std::size_t>(y) * size.x;
+            std::uint8_t *dst = packed.data() + y * rowBytes;
+            for (unsigned x = 0; x < size.x; ++x)
+                dst[x / perByte] |= static_cast<std::uint8_t>(src[x] << (8 - depth - (x % perByte) * depth));
+        }
+        rows = packed.data();
+    }
+
+    std::vector<std::uint8_t> zdata = compress(rows, size.y, rowBytes, 1, false);
+    if (zdata.empty())
+        return {};
+
+    std::vector<std::uint8_t> plte, trns;
+    for (const sf::Color &c : image.palette)
+        plte.insert(plte.end(), {c.r, c.g, c.b});
+    for (std::size_t i = 0; i < image.translucentCount(); ++i)
+        trns.push_back(image.palette[i].a);
+    return wrapChunks(size, static_cast<std::uint8_t>(depth), 3, plte, trns, zdata);
+}
+
+std::vector<std::uint8_t> PngEncoder::wrapChunks(sf::Vector2u size, std::uint8_t bitDepth,
+                                                 std::uint8_t colorType,
+                                                 const std::vector<std::uint8_t> &plte,
+                                                 const std::vector<std::uint8_t> &trns,
+                                                 const std::vector<std::uint8_t> &zdata)
+{
+    std::vector<std::uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    png.reserve(zdata.size() + plte.size() + trns.size() + (zdata.size() / IdatChunkSize + 6) * 12 + 64);
+
+    std::vector<std::uint8_t> ihdr;
+    putU32(ihdr, size.x);
+    putU32(ihdr, size.y);
+    ihdr.push_back(bitDepth);
+    ihdr.push_back(colorType); // 6 = RGBA, 3 = indexed
+    ihdr.push_back(0); // Compression: deflate
+    ihdr.push_back(0); // Filter method: adaptive
+    ihdr.push_back(0); // No interlace
+    writeChunk(png, "IHDR", ihdr.data(), ihdr.size());
+    if (!plte.empty())
+        writeChunk(png, "PLTE", plte.data(), plte.size());
+    if (!trns.empty())
+        writeChunk(png, "tRNS", trns.data(), trns.size());
+
+    for (std::size_t off = 0; off < zdata.size(); off += IdatChunkSize)
+        writeChunk(png, "IDAT", zdata.data() + off, std::min(IdatChunkSize, zdata.size() - off));
+    writeChunk(png, "IEND", nullptr, 0);
+    return png;
+}
+
+bool PngEncoder::encodeToFile(const std::uint8_t *rgba, sf::Vector2u size, const std::string &path) const
+{
+    std::vector<std::uint8_t> png = encode(rgba, size);
+    if (png.empty())
+        return false;
+
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(png.data()), static_cast<std::streamsize>(png.size()));
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,75 @@
+//=============================================================================
+// PngEncoder.h
+//=============================================================================
+// PURPOSE:
+//   Multi-threaded PNG writer for exports. sf::Image::saveToFile compresses
+//   on one thread, which dominates export time for large print pages.
+//
+// KEY FEATURES:
+//   - Rows are split into bands that are filtered and deflated in parallel
+//     (pigz-style): every band is an independent raw deflate segment ending
+//     on a byte boundary, primed with the previous 32 KiB as dictionary, so
+//     the concatenation is one valid zlib stream
+//   - Per-band Adler-32 checksums are merged with adler32_combine
+//   - Adaptive per-row filtering (minimum sum of absolute differences)
+//   - Selectable compression level (0 = store, 1 = fastest, 9 = smallest)
+//   - Indexed output (PLTE/tRNS, 1/2/4/8-bit) from a PaletteQuantizer image
+//
+// USAGE:
+//   PngSettings ps;
+//   ps.compressionLevel = 3;
+//   PngEncoder(ps).encodeToFile(image.getPixelsPtr(), image.getSize(), path);
+//
+// WHERE TO MODIFY:
+//   - Band size / threading: Modify PngEncoder::compress()
+//   - Filter heuristic: Modify filterRow() in PngEncoder.cpp
+//=============================================================================
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "PaletteQuantizer.h"
+
+struct PngSettings {
+    int compressionLevel{6};                  // zlib level 0..9
+    unsigned threads{0};                      // 0 = one per hardware thread
+};
+
+class PngEncoder {
+public:
+    // Minimum uncompressed bytes per band (smaller bands hurt the ratio)
+    static constexpr std::size_t MinBandBytes = 128 * 1024;
+
+    explicit PngEncoder(const PngSettings& settings = PngSettings());
+
+    // Encode tightly packed RGBA8 pixels. Returns the complete PNG file.
+    std::vector<std::uint8_t> encode(const std::uint8_t* rgba, sf::Vector2u size) const;
+
+    // Encode a palette image (color type 3, smallest bit depth that fits).
+    // Rows are left unfiltered, as recommended for indexed PNGs.
+    std::vector<std::uint8_t> encodeIndexed(const IndexedImage& image) const;
+
+    // Encode and write to `path`. Returns false on failure.
+    bool encodeToFile(const std::uint8_t* rgba, sf::Vector2u size, const std::string& path) const;
+
+private:
+    // Filter + deflate `height` rows of `rowBytes` bytes into a zlib stream
+    // (adaptiveFilter = false writes filter type None for every row)
+    std::vector<std::uint8_t> compress(const std::uint8_t* rows, unsigned height,
+                                       std::size_t rowBytes, unsigned bytesPerPixel,
+                                       bool adaptiveFilter = true) const;
+
+    // Signature, IHDR, optional PLTE/tRNS, IDAT chunks and IEND
+    static std::vector<std::uint8_t> wrapChunks(sf::Vector2u size, std::uint8_t bitDepth,
+                                                std::uint8_t colorType,
+                                                const std::vector<std::uint8_t>& plte,
+                                                const std::vector<std::uint8_t>& trns,
+                                                const std::vector<std::uint8_t>& zdata);
+
+    PngSettings m_settings;
+};
@@ -0,0 +1,123 @@
+//=============================================================================
+// Process.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the child-process helpers (see Process.h).
+//=============================================================================
+
+#include "Process.h"
+
+#include <filesystem>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+#ifdef _WIN32
+namespace
+{
+    std::string quoteArg(const std::string &arg)
+    {
+        std::string quoted = "\"";
+        for (char c : arg)
+        {
+            if (c == '"')
+                quoted += '\\';
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+}
+
+bool spawnProcess(const std::vector<std::string> &args, ProcessHandle &handle)
+{
+    std::string cmd;
+    for (const auto &a : args)
+        cmd += (cmd.empty() ? "" : " ") + quoteArg(a);
+
+    STARTUPINFOA si{};
+    si.cb = sizeof(si);
+    PROCESS_INFORMATION pi{};
+    if (!CreateProcessA(nullptr, cmd.data(), nullptr, nullptr, FALSE, 0, nullptr, nullptr, &si, &pi))
+        return false;
+    CloseHandle(pi.hThread);
+    handle = reinterpret_cast<ProcessHandle>(pi.hProcess);
+    return true;
+}
+
+int waitProcess(ProcessHandle handle)
+{
+    HANDLE process = reinterpret_cast<HANDLE>(handle);
+    WaitForSingleObject(process, INFINITE);
+    DWORD code = 1;
+    GetExitCodeProcess(process, &code);
+    CloseHandle(process);
+    return static_cast<int>(code);
+}
+#else
+bool spawnProcess(const std::vector<std::string> &args, ProcessHandle &handle)
+{
+    std::vector<char *> argv;
+    for (const auto &a : args)
+        argv.push_back(const_cast<char *>(a.c_str()));
+    argv.push_back(nullptr);
+
+    pid_t pid = fork();
+    if (pid < 0)
+        return false;
+    if (pid == 0)
+    {
+        execv(argv[0], argv.data());
+        _exit(127);
+    }
+    handle = static_cast<ProcessHandle>(pid);
+    return true;
+}
+
+int waitProcess(ProcessHandle handle)
+{
+    int status = 0;
+    if (waitpid(static_cast<pid_t>(handle), &status, 0) < 0)
+        return 1;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+}
+#endif
+
+int runProcess(const std::vector<std::string> &args)
+{
+    ProcessHandle handle{};
+    if (!spawnProcess(args, handle))
+        return -1;
+    return waitProcess(handle);
+}
+
+std::string selfExecutable(const std::string &fallback)
+{
+#ifdef _WIN32
+    char buffer[MAX_PATH];
+    DWORD len = GetModuleFileNameA(nullptr, buffer, MAX_PATH);
+    if (len > 0 && len < MAX_PATH)
+        return std::string(buffer, len);
+#else
+    std::error_code ec;
+    auto self = fs::read_symlink("/proc/self/exe", ec);
+    if (!ec)
+        return self.string();
+#endif
+    return fs::absolute(fallback).string();
+}
+
+std::uint64_t currentProcessId()
+{
+#ifdef _WIN32
+    return static_cast<std::uint64_t>(GetCurrentProcessId());
+#else
+    return static_cast<std::uint64_t>(getpid());
+#endif
+}
@@ -0,0 +1,36 @@
+//=============================================================================
+// Process.h
+//=============================================================================
+// PURPOSE:
+//   Minimal child-process helpers for the tools that re-run this program
+//   or a sibling executable: batch workers (BatchRenderer.h) and replay
+//   scenarios of the performance gate (PerfGate.h).
+//
+// NOTES:
+//   - fork/execv on POSIX, CreateProcess on Windows
+//   - args[0] must be a path to the executable (no PATH lookup)
+//=============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Opaque: a pid on POSIX, a process HANDLE on Windows
+using ProcessHandle = std::intptr_t;
+
+// Start args[0] with the given arguments. Returns false if it could not start.
+bool spawnProcess(const std::vector<std::string>& args, ProcessHandle& handle);
+
+// Wait for the process to exit; returns its exit code (1 if unknown)
+int waitProcess(ProcessHandle handle);
+
+// spawnProcess() + waitProcess(); -1 if the process could not start
+int runProcess(const std::vector<std::string>& args);
+
+// Absolute path of the running executable (falls back to `fallback`)
+std::string selfExecutable(const std::string& fallback);
+
+// Id of the running process
+std::uint64_t currentProcessId();
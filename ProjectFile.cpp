@@ -0,0 +1,371 @@
+//=============================================================================
+// ProjectFile.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the *.comic project reader/writer.
+//
+// NOTES:
+//   - Objects are recreated through their normal constructors and setters,
+//     so bubbles re-wrap text and rebuild geometry exactly like in the editor.
+//   - Loading requires the referenced fonts/textures to be registered in the
+//     AssetManager first (headless mode is fine).
+//=============================================================================
+
+#include "ProjectFile.h"
+#include "AssetManager.h"
+#include "Base64.h"
+#include "ContentHash.h"
+#include "FrameWatchdog.h"
+#include "Scene.h"
+#include "Telemetry.h"
+
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    constexpr int ProjectVersion = 4;
+
+    template <typename T>
+    T readValue(std::istream &in, const std::string &what)
+    {
+        T value{};
+        if (!(in >> value))
+            throw std::runtime_error("Project parse error: expected " + what);
+        return value;
+    }
+
+    std::string readString(std::istream &in, const std::string &what)
+    {
+        std::string value;
+        if (!(in >> std::quoted(value)))
+            throw std::runtime_error("Project parse error: expected " + what);
+        return value;
+    }
+
+    void collectKeys(const Scene &scene, std::set<std::pair<std::string, std::string>> &keys)
+    {
+        for (const auto &c : scene.characters)
+            keys.insert({"texture", c->getImagePath()});
+        for (const auto &b : scene.bubbles)
+        {
+            keys.insert({"font", b->getFontName()});
+            if (b->usesImageBubble())
+                keys.insert({"texture", b->getBubbleImageKey()});
+        }
+        for (const auto &g : scene.groups)
+            collectKeys(g->members(), keys);
+    }
+
+    // STROKE, CHARACTER and BUBBLE records of the scene's own lists
+    void writeObjects(std::ostream &out, const Scene &scene)
+    {
+        for (const auto &s : scene.strokes)
+        {
+            // World points: the stroke's transform (including a flip) is baked in
+            const auto points = s->getWorldPoints();
+            sf::Color c = s->getColor();
+            out << "STROKE " << std::quoted(s->getId()) << " "
+                << int(c.r) << " " << int(c.g) << " " << int(c.b) << " " << int(c.a) << " "
+                << s->getThickness() << " " << 0 << " " << points.size();
+            for (const auto &p : points)
+                out << " " << p.x << " " << p.y;
+            out << "\n";
+        }
+
+        for (const auto &c : scene.characters)
+        {
+            auto pos = c->getPosition();
+            auto size = c->getSize();
+            out << "CHARACTER " << std::quoted(c->getId()) << " " << std::quoted(c->getImagePath()) << " "
+                << pos.x << " " << pos.y << " " << size.x << " " << size.y << " "
+                << c->getRotation() << " " << c->isFlipped() << " " << std::quoted(c->getExpression()) << "\n";
+        }
+
+        for (const auto &b : scene.bubbles)
+        {
+            auto pos = b->getPosition();
+            auto size = b->getSize();
+            out << "BUBBLE " << std::quoted(b->getId()) << " " << std::quoted(b->getStyle()) << " "
+                << std::quoted(b->getFontName()) << " " << b->getFontSize() << " "
+                << pos.x << " " << pos.y << " " << size.x << " " << size.y << " "
+                << b->isFlipped() << " " << std::quoted(b->getText()) << "\n";
+        }
+    }
+
+    void clearScene(Scene &scene)
+    {
+        scene.paint.reset();
+        scene.strokes.clear();
+        scene.characters.clear();
+        scene.bubbles.clear();
+        scene.groups.clear();
+    }
+}
+
+std::vector<AssetRef> collectAssetRefs(const Scene &scene)
+{
+    auto &AM = AssetManager::getInstance();
+    std::set<std::pair<std::string, std::string>> keys;
+    collectKeys(scene, keys);
+
+    std::vector<AssetRef> refs;
+    for (const auto &[kind, key] : keys)
+    {
+        AssetRef ref;
+        ref.kind = kind;
+        ref.key = key;
+        ref.path = kind == "font" ? AM.getFontPath(key) : AM.getTexturePath(key);
+        ref.hash = ref.path.empty() ? 0 : hashFile(ref.path);
+        refs.push_back(ref);
+    }
+    return refs;
+}
+
+std::vector<AssetRef> readProjectAssets(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        throw std::runtime_error("Project open failed: " + path);
+
+    std::vector<AssetRef> refs;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::istringstream ss(line);
+        std::string record;
+        ss >> record;
+        if (record == "COMIC" || record == "CANVAS")
+            continue;
+        if (record != "ASSET")
+            break; // Object records follow the header
+
+        AssetRef ref;
+        ref.kind = readValue<std::string>(ss, "asset kind");
+        ref.key = readString(ss, "asset key");
+        ref.path = readString(ss, "asset path");
+        ref.hash = fromHex(readValue<std::string>(ss, "asset hash"));
+        refs.push_back(ref);
+    }
+    return refs;
+}
+
+void saveProject(const std::string &path, const Scene &scene, const ProjectCanvas &canvas)
+{
+    TimedScope timed("project/save");
+    Telemetry::getInstance().count(Counter::ProjectSaves);
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+        throw std::runtime_error("Project save failed: " + path);
+
+    // Round-trip floats exactly
+    out << std::setprecision(9);
+    out << "COMIC " << ProjectVersion << "\n";
+    out << "CANVAS " << canvas.origin.x << " " << canvas.origin.y << " "
+        << canvas.size.x << " " << canvas.size.y << "\n";
+
+    for (const auto &ref : collectAssetRefs(scene))
+        out << "ASSET " << ref.kind << " " << std::quoted(ref.key) << " "
+            << std::quoted(ref.path) << " " << toHex(ref.hash) << "\n";
+
+    // Paint tiles as base64 PNG (version 3)
+    if (scene.paint)
+        for (const auto &[key, tile] : scene.paint->tiles())
+            out << "PAINT " << key.x << " " << key.y << " " << base64Encode(PaintLayer::encodeTile(*tile)) << "\n";
+
+    writeObjects(out, scene);
+
+    // Group members follow their GROUP record, in the group's local space (version 4)
+    for (const auto &g : scene.groups)
+    {
+        const Scene &members = g->members();
+        auto pos = g->getPosition();
+        auto size = g->getSize();
+        out << "GROUP " << std::quoted(g->getId()) << " " << pos.x << " " << pos.y << " " << size.x << " "
+            << size.y << " " << g->isFlipped() << " " << members.strokes.size() << " "
+            << members.characters.size() << " " << members.bubbles.size() << "\n";
+        writeObjects(out, members);
+    }
+
+    if (!out)
+        throw std::runtime_error("Project save failed: " + path);
+}
+
+ProjectCanvas loadProject(const std::string &path, Scene &scene)
+{
+    TimedScope timed("project/load");
+    Telemetry::getInstance().count(Counter::ProjectLoads);
+    clearScene(scene);
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        throw std::runtime_error("Project open failed: " + path);
+
+    std::string magic;
+    if (!(in >> magic) || magic != "COMIC")
+        throw std::runtime_error("Not a comic project: " + path);
+    int version = readValue<int>(in, "version");
+    if (version > ProjectVersion)
+        throw std::runtime_error("Unsupported project version " + std::to_string(version) + ": " + path);
+
+    ProjectCanvas canvas;
+    try
+    {
+        // Object records go to `target`: the scene, or the members of the
+        // group being read until `pending` of them have been read
+        Scene *target = &scene;
+        Scene members;
+        std::size_t pending = 0;
+        std::string groupId;
+        sf::Vector2f groupPos, groupSize;
+        bool groupFlipped = false;
+
+        auto finishGroup = [&]()
+        {
+            auto group = std::make_unique<ObjectGroup>(groupId, std::move(members));
+            group->setSize(groupSize);
+            group->setPosition(groupPos);
+            group->setFlipped(groupFlipped);
+            scene.groups.push_back(std::move(group));
+            members = Scene{};
+            target = &scene;
+        };
+        auto memberRead = [&]()
+        {
+            if (target != &scene && --pending == 0)
+                finishGroup();
+        };
+
+        std::string record;
+        while (in >> record)
+        {
+            if (record == "CANVAS")
+            {
+                canvas.origin.x = readValue<float>(in, "canvas origin");
+                canvas.origin.y = readValue<float>(in, "canvas origin");
+                canvas.size.x = readValue<unsigned>(in, "canvas width");
+                canvas.size.y = readValue<unsigned>(in, "canvas height");
+            }
+            else if (record == "ASSET")
+            {
+                // Dependency info only (see readProjectAssets)
+                readValue<std::string>(in, "asset kind");
+                readString(in, "asset key");
+                readString(in, "asset path");
+                readValue<std::string>(in, "asset hash");
+            }
+            else if (record == "PAINT")
+            {
+                PaintLayer::TileKey key;
+                key.x = readValue<int>(in, "paint tile x");
+                key.y = readValue<int>(in, "paint tile y");
+                std::string data = readValue<std::string>(in, "paint tile data");
+                if (!scene.paint)
+                    scene.paint = std::make_unique<PaintLayer>();
+                scene.paint->setTile(key, base64Decode(data));
+            }
+            else if (record == "STROKE")
+            {
+                std::string id = readString(in, "stroke id");
+                int r = readValue<int>(in, "stroke color");
+                int g = readValue<int>(in, "stroke color");
+                int b = readValue<int>(in, "stroke color");
+                int a = readValue<int>(in, "stroke color");
+                float thickness = readValue<float>(in, "stroke thickness");
+                bool flipped = readValue<bool>(in, "stroke flip");
+                std::size_t count = readValue<std::size_t>(in, "stroke point count");
+
+                std::vector<sf::Vector2f> points(count);
+                for (auto &p : points)
+                {
+                    p.x = readValue<float>(in, "stroke point");
+                    p.y = readValue<float>(in, "stroke point");
+                }
+
+                auto stroke = std::make_unique<BrushStroke>(
+                    id, sf::Color(static_cast<std::uint8_t>(r), static_cast<std::uint8_t>(g),
+                                  static_cast<std::uint8_t>(b), static_cast<std::uint8_t>(a)),
+                    thickness);
+                stroke->setPoints(points);
+                stroke->setFlipped(flipped);
+                target->strokes.push_back(std::move(stroke));
+                memberRead();
+            }
+            else if (record == "CHARACTER")
+            {
+                std::string id = readString(in, "character id");
+                std::string key = readString(in, "character asset");
+                float x = readValue<float>(in, "character x");
+                float y = readValue<float>(in, "character y");
+                float w = readValue<float>(in, "character width");
+                float h = readValue<float>(in, "character height");
+                float rotation = readValue<float>(in, "character rotation");
+                bool flipped = readValue<bool>(in, "character flip");
+                std::string expression = readString(in, "character expression");
+
+                auto ch = std::make_unique<Character>(id, key, x, y, w, h);
+                ch->setRotation(rotation);
+                ch->setFlipped(flipped);
+                ch->setExpression(expression);
+                target->characters.push_back(std::move(ch));
+                memberRead();
+            }
+            else if (record == "BUBBLE")
+            {
+                std::string id = readString(in, "bubble id");
+                std::string style = readString(in, "bubble style");
+                std::string font = readString(in, "bubble font");
+                int fontSize = readValue<int>(in, "bubble font size");
+                float x = readValue<float>(in, "bubble x");
+                float y = readValue<float>(in, "bubble y");
+                float w = readValue<float>(in, "bubble width");
+                float h = readValue<float>(in, "bubble height");
+                bool flipped = readValue<bool>(in, "bubble flip");
+                std::string text = readString(in, "bubble text");
+
+                auto b = std::make_unique<SpeechBubble>(id, "", x, y, w, h);
+                b->setStyle(style);
+                b->setFontName(font);
+                b->setFontSize(fontSize);
+                b->setText(text);
+                b->setFlipped(flipped);
+                target->bubbles.push_back(std::move(b));
+                memberRead();
+            }
+            else if (record == "GROUP")
+            {
+                if (target != &scene)
+                    throw std::runtime_error("Project parse error: group inside group " + groupId);
+                groupId = readString(in, "group id");
+                groupPos.x = readValue<float>(in, "group x");
+                groupPos.y = readValue<float>(in, "group y");
+                groupSize.x = readValue<float>(in, "group width");
+                groupSize.y = readValue<float>(in, "group height");
+                groupFlipped = readValue<bool>(in, "group flip");
+                pending = readValue<std::size_t>(in, "group stroke count");
+                pending += readValue<std::size_t>(in, "group character count");
+                pending += readValue<std::size_t>(in, "group bubble count");
+                target = &members;
+                if (pending == 0)
+                    finishGroup();
+            }
+            else
+            {
+                throw std::runtime_error("Project parse error: unknown record '" + record + "'");
+            }
+        }
+        if (target != &scene)
+            throw std::runtime_error("Project parse error: group " + groupId + " is missing members");
+    }
+    catch (const std::runtime_error &e)
+    {
+        clearScene(scene);
+        throw std::runtime_error(std::string(e.what()) + " in " + path);
+    }
+
+    return canvas;
+}
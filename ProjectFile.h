@@ -0,0 +1,71 @@
+//=============================================================================
+// ProjectFile.h
+//=============================================================================
+// PURPOSE:
+//   Saves and loads a Scene to/from a plain-text project file (*.comic),
+//   so panels can be reopened in the editor or re-rendered in batch.
+//
+// FILE FORMAT (whitespace separated, strings use std::quoted):
+//   COMIC 4
+//   CANVAS <originX> <originY> <width> <height>
+//   ASSET <kind> <key> <path> <hash>       (kind: texture | font)
+//   PAINT <tileX> <tileY> <base64 PNG>     (one paint layer tile, version 3)
+//   STROKE <id> <r> <g> <b> <a> <thickness> <flipped> <pointCount> <x y>...
+//   CHARACTER <id> <assetKey> <x> <y> <w> <h> <rotation> <flipped> <expression>
+//   BUBBLE <id> <style> <font> <fontSize> <x> <y> <w> <h> <flipped> <text>
+//   GROUP <id> <x> <y> <w> <h> <flipped> <strokes> <characters> <bubbles>
+//                                          (version 4, followed by that many
+//                                          member records)
+//
+// NOTES:
+//   - Stroke points are stored after interpolation, so a reloaded stroke is
+//     identical to the one that was drawn.
+//   - CANVAS is the exported region in world coordinates (the editor's
+//     canvas starts right of the sidebar).
+//   - ASSET records list every AssetManager key the scene depends on, with
+//     the file path and FNV-1a hash at save time. They come before the
+//     object records so readProjectAssets() can stop early. Version 1
+//     files have none.
+//   - Group members are stored in the group's local space; the GROUP rect
+//     and flip are the group transform (see ObjectGroup.h). Groups are not
+//     nested.
+//
+// WHERE TO MODIFY:
+//   - New object kinds: Add a record type in save/load and bump the version
+//=============================================================================
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct Scene;
+
+// World-space region that is exported for a project
+struct ProjectCanvas {
+    sf::Vector2f origin{0.f, 0.f};
+    sf::Vector2u size{0, 0};
+};
+
+// One asset a project depends on
+struct AssetRef {
+    std::string kind;             // "texture" or "font"
+    std::string key;              // AssetManager key
+    std::string path;             // Source file
+    std::uint64_t hash{0};        // Content hash of the file (0 = unreadable)
+};
+
+// Assets referenced by the scene, resolved and hashed through the AssetManager
+std::vector<AssetRef> collectAssetRefs(const Scene& scene);
+
+// Only the ASSET records of a project (does not create any objects)
+std::vector<AssetRef> readProjectAssets(const std::string& path);
+
+// Write the scene to `path`. Throws runtime_error if the file cannot be written.
+void saveProject(const std::string& path, const Scene& scene, const ProjectCanvas& canvas);
+
+// Replace the contents of `scene` with the project at `path`.
+// Throws runtime_error on I/O or format errors (scene is left empty).
+ProjectCanvas loadProject(const std::string& path, Scene& scene);
@@ -0,0 +1,35 @@
+//=============================================================================
+// Scene.h
+//=============================================================================
+// PURPOSE:
+//   Owns the drawable content of one comic panel: the raster paint layer,
+//   brush strokes, characters, speech bubbles and groups of them. Kept
+//   separate from the window so the same scene can be drawn by the editor,
+//   rendered offscreen, or exported headlessly.
+//
+// DRAW ORDER:
+//   paint -> strokes -> characters -> bubbles -> groups (same order as the
+//   editor render loop; inside a group: strokes -> characters -> bubbles)
+//
+// WHERE TO MODIFY:
+//   - Add new object kinds: Add a container here and extend the renderers
+//=============================================================================
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "BrushStroke.h"
+#include "Character.h"
+#include "ObjectGroup.h"
+#include "PaintLayer.h"
+#include "SpeechBubble.h"
+
+struct Scene {
+    std::unique_ptr<PaintLayer> paint;                // Null until something is painted
+    std::vector<std::unique_ptr<BrushStroke>> strokes;
+    std::vector<std::unique_ptr<Character>> characters;
+    std::vector<std::unique_ptr<SpeechBubble>> bubbles;
+    std::vector<std::unique_ptr<ObjectGroup>> groups; // Drawn last, each as a unit
+};
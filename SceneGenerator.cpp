@@ -0,0 +1,174 @@
+//=============================================================================
+// SceneGenerator.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the synthetic scene generator (see SceneGenerator.h).
+//=============================================================================
+
+#include "SceneGenerator.h"
+#include "AssetManager.h"
+
+#include <algorithm>
+
+namespace
+{
+    const char *const Words[] = {"Wait", "what", "is", "that", "thing", "over", "there", "?!", "We", "have",
+                                 "to", "go", "now", "before", "the", "villain", "escapes", "Look", "out",
+                                 "BOOM", "Hmm...", "I", "knew", "it", "Run", "Never", "again", "tomorrow"};
+    constexpr int WordCount = static_cast<int>(sizeof(Words) / sizeof(Words[0]));
+
+    const sf::Color InkColors[] = {sf::Color::Black, sf::Color(40, 40, 40), sf::Color(200, 30, 30),
+                                   sf::Color(30, 80, 200), sf::Color(20, 140, 60), sf::Color(240, 180, 0),
+                                   sf::Color(120, 60, 160), sf::Color(255, 255, 255)};
+    constexpr int InkCount = static_cast<int>(sizeof(InkColors) / sizeof(InkColors[0]));
+
+    std::vector<std::string> sortedAssets(const std::string &type)
+    {
+        auto keys = AssetManager::getInstance().getAssetsByType(type);
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        return keys;
+    }
+}
+
+SceneGeneratorOptions SceneGeneratorOptions::forObjectCount(std::size_t objects, std::uint64_t seed)
+{
+    SceneGeneratorOptions options;
+    options.seed = seed;
+    options.characters = objects / 5;
+    options.bubbles = objects / 10;
+    options.strokes = objects - options.characters - options.bubbles;
+    return options;
+}
+
+SceneGenerator::SceneGenerator(const SceneGeneratorOptions &options)
+    : m_options(options),
+      m_characterKeys(sortedAssets("CHARACTER")),
+      m_fontKeys(sortedAssets("FONT")),
+      m_styles{"speech", "speech_rectangle", "thought", "shout"}
+{
+    m_options.area.x = std::max(m_options.area.x, 64u);
+    m_options.area.y = std::max(m_options.area.y, 64u);
+    m_options.minStrokeSamples = std::max(m_options.minStrokeSamples, 1u);
+    m_options.maxStrokeSamples = std::max(m_options.maxStrokeSamples, m_options.minStrokeSamples);
+    for (const auto &key : sortedAssets("BUBBLE"))
+        if (std::find(m_styles.begin(), m_styles.end(), key) == m_styles.end())
+            m_styles.push_back(key);
+}
+
+Scene SceneGenerator::generate() const
+{
+    Scene scene;
+    generate(scene);
+    return scene;
+}
+
+void SceneGenerator::generate(Scene &scene) const
+{
+    scene.strokes.reserve(scene.strokes.size() + m_options.strokes);
+    for (std::size_t i = 0; i < m_options.strokes; ++i)
+        scene.strokes.push_back(makeStroke(i));
+
+    if (!m_characterKeys.empty())
+    {
+        scene.characters.reserve(scene.characters.size() + m_options.characters);
+        for (std::size_t i = 0; i < m_options.characters; ++i)
+            scene.characters.push_back(makeCharacter(i));
+    }
+
+    if (!m_fontKeys.empty())
+    {
+        scene.bubbles.reserve(scene.bubbles.size() + m_options.bubbles);
+        for (std::size_t i = 0; i < m_options.bubbles; ++i)
+            scene.bubbles.push_back(makeBubble(i));
+    }
+}
+
+SplitMix64 SceneGenerator::streamFor(Kind kind, std::size_t index) const
+{
+    // Decorrelate (seed, kind, index) before using it as a stream seed
+    SplitMix64 mix(m_options.seed ^ (static_cast<std::uint64_t>(kind) << 56));
+    return SplitMix64(mix.next() ^ (static_cast<std::uint64_t>(index) * 0xD1B54A32D192ED03ull));
+}
+
+std::unique_ptr<BrushStroke> SceneGenerator::makeStroke(std::size_t index) const
+{
+    SplitMix64 rng = streamFor(Kind::Stroke, index);
+    const int w = static_cast<int>(m_options.area.x);
+    const int h = static_cast<int>(m_options.area.y);
+
+    // Mostly thin ink lines, a few marker-thick ones
+    const float thickness = static_cast<float>(rng.range(0, 9) < 8 ? rng.range(1, 6) : rng.range(8, 24));
+    auto stroke = std::make_unique<BrushStroke>("gen_stroke_" + std::to_string(index),
+                                                InkColors[rng.range(0, InkCount - 1)], thickness);
+
+    // Integer mouse samples: a drifting velocity, 2..~20 px per event
+    int x = rng.range(0, w - 1), y = rng.range(0, h - 1);
+    int vx = rng.range(-8, 8), vy = rng.range(-8, 8);
+    const int maxSpeed = rng.range(6, 20);
+    const int samples = rng.range(static_cast<int>(m_options.minStrokeSamples),
+                                  static_cast<int>(m_options.maxStrokeSamples));
+
+    auto world = [&](int px, int py)
+    { return sf::Vector2f(m_options.origin.x + static_cast<float>(px), m_options.origin.y + static_cast<float>(py)); };
+
+    stroke->beginAt(world(x, y));
+    for (int s = 1; s < samples; ++s)
+    {
+        vx = std::clamp(vx + rng.range(-3, 3), -maxSpeed, maxSpeed);
+        vy = std::clamp(vy + rng.range(-3, 3), -maxSpeed, maxSpeed);
+        if (vx == 0 && vy == 0)
+            vx = 1;
+        x = std::clamp(x + vx, 0, w - 1);
+        y = std::clamp(y + vy, 0, h - 1);
+        stroke->addPoint(world(x, y));
+    }
+    return stroke;
+}
+
+std::unique_ptr<Character> SceneGenerator::makeCharacter(std::size_t index) const
+{
+    SplitMix64 rng = streamFor(Kind::Character, index);
+    const int size = rng.range(64, std::max(64, static_cast<int>(std::min(m_options.area.x, m_options.area.y)) / 3));
+    const int x = rng.range(0, std::max(0, static_cast<int>(m_options.area.x) - size));
+    const int y = rng.range(0, std::max(0, static_cast<int>(m_options.area.y) - size));
+    const std::string &key = m_characterKeys[static_cast<std::size_t>(rng.range(0, static_cast<int>(m_characterKeys.size()) - 1))];
+
+    auto character = std::make_unique<Character>("gen_char_" + std::to_string(index), key,
+                                                 m_options.origin.x + static_cast<float>(x),
+                                                 m_options.origin.y + static_cast<float>(y),
+                                                 static_cast<float>(size), static_cast<float>(size));
+    if (rng.range(0, 3) == 0)
+        character->setFlipped(true);
+    return character;
+}
+
+std::unique_ptr<SpeechBubble> SceneGenerator::makeBubble(std::size_t index) const
+{
+    SplitMix64 rng = streamFor(Kind::Bubble, index);
+
+    std::string text;
+    const int words = rng.range(1, 24);
+    for (int i = 0; i < words; ++i)
+    {
+        if (i)
+            text += ' ';
+        text += Words[rng.range(0, WordCount - 1)];
+    }
+
+    const int w = rng.range(120, 360);
+    const int h = rng.range(80, 220);
+    const int x = rng.range(0, std::max(0, static_cast<int>(m_options.area.x) - w));
+    const int y = rng.range(0, std::max(0, static_cast<int>(m_options.area.y) - h));
+
+    auto bubble = std::make_unique<SpeechBubble>("gen_bubble_" + std::to_string(index), text,
+                                                 m_options.origin.x + static_cast<float>(x),
+                                                 m_options.origin.y + static_cast<float>(y),
+                                                 static_cast<float>(w), static_cast<float>(h));
+    bubble->setStyle(m_styles[static_cast<std::size_t>(rng.range(0, static_cast<int>(m_styles.size()) - 1))]);
+    bubble->setFontName(m_fontKeys[static_cast<std::size_t>(rng.range(0, static_cast<int>(m_fontKeys.size()) - 1))]);
+    bubble->setFontSize(rng.range(14, 36));
+    if (rng.range(0, 5) == 0)
+        bubble->setFlipped(true);
+    return bubble;
+}
@@ -0,0 +1,97 @@
+//=============================================================================
+// SceneGenerator.h
+//=============================================================================
+// PURPOSE:
+//   Builds synthetic scenes of any size (10 .. 1,000,000 objects) for
+//   benchmarks, headless rendering (--generate) and stress runs.
+//
+// KEY FEATURES:
+//   - Deterministic: the same options give the same scene bit for bit on
+//     every platform (splitmix64 integers only, no <random> distributions,
+//     no libm; see SceneHash.h to compare)
+//   - Every object draws from its own stream (seed, kind, index), so a
+//     smaller scene is a prefix of a larger one with the same seed
+//   - Strokes are fed to BrushStroke::addPoint as integer mouse samples
+//     with mouse-like speeds, so point densities match real drawing
+//   - Characters and bubble fonts/images come from the loaded asset set
+//     (sorted keys; load assets first)
+//
+// WHERE TO MODIFY:
+//   - Object mix for --generate: Modify SceneGeneratorOptions::forObjectCount()
+//   - Stroke shape: Modify SceneGenerator::makeStroke()
+//=============================================================================
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Scene.h"
+
+// splitmix64 (Steele, Lea & Flood): tiny, fast, fully specified
+class SplitMix64 {
+public:
+    explicit SplitMix64(std::uint64_t seed) : m_state(seed) {}
+
+    std::uint64_t next()
+    {
+        std::uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform integer in [lo, hi] (multiply-shift, negligible bias)
+    int range(int lo, int hi)
+    {
+        const std::uint64_t span = static_cast<std::uint64_t>(static_cast<std::int64_t>(hi) - lo) + 1;
+        return lo + static_cast<int>(((next() >> 32) * span) >> 32);
+    }
+
+private:
+    std::uint64_t m_state;
+};
+
+struct SceneGeneratorOptions {
+    std::uint64_t seed{1};
+    std::size_t strokes{70};
+    std::size_t characters{20};
+    std::size_t bubbles{10};
+    sf::Vector2f origin{0.f, 0.f};            // Top-left of the area (world)
+    sf::Vector2u area{1600, 1200};            // Objects start inside this area
+    unsigned minStrokeSamples{8};             // Mouse samples per stroke
+    unsigned maxStrokeSamples{48};
+
+    // `objects` split 70% strokes, 20% characters, 10% bubbles
+    static SceneGeneratorOptions forObjectCount(std::size_t objects, std::uint64_t seed = 1);
+
+    std::size_t objectCount() const { return strokes + characters + bubbles; }
+};
+
+class SceneGenerator {
+public:
+    explicit SceneGenerator(const SceneGeneratorOptions& options);
+
+    Scene generate() const;
+
+    // Append the generated objects to an existing scene
+    void generate(Scene& scene) const;
+
+private:
+    enum class Kind : std::uint64_t { Stroke = 1, Character = 2, Bubble = 3 };
+
+    SplitMix64 streamFor(Kind kind, std::size_t index) const;
+
+    std::unique_ptr<BrushStroke> makeStroke(std::size_t index) const;
+    std::unique_ptr<Character> makeCharacter(std::size_t index) const;
+    std::unique_ptr<SpeechBubble> makeBubble(std::size_t index) const;
+
+    SceneGeneratorOptions m_options;
+    std::vector<std::string> m_characterKeys;
+    std::vector<std::string> m_fontKeys;
+    std::vector<std::string> m_styles;        // Procedural styles + bubble images
+};
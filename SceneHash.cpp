@@ -0,0 +1,53 @@
+//=============================================================================
+// SceneHash.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the incremental scene hash (see SceneHash.h).
+//=============================================================================
+
+#include "SceneHash.h"
+#include "ContentHash.h"
+#include "Scene.h"
+
+namespace
+{
+    // Object count first, so moving an object between lists changes the hash
+    template <typename Objects>
+    std::uint64_t foldObjects(const Objects &objects, std::uint64_t hash)
+    {
+        hash = hashValue(static_cast<std::uint64_t>(objects.size()), hash);
+        for (const auto &object : objects)
+            hash = hashValue(object->getContentHash(), hash);
+        return hash;
+    }
+}
+
+std::uint64_t SceneHasher::hash(const Scene &scene)
+{
+    // Read before hashing: a change made meanwhile forces the next recompute
+    const std::uint64_t revision = CanvasObject::getRevision();
+    const PaintLayer *paint = scene.paint.get();
+    const std::uint64_t paintRevision = paint ? paint->revision() : 0;
+    if (m_valid && m_scene == &scene && m_revision == revision && m_paint == paint &&
+        m_paintRevision == paintRevision)
+        return m_hash;
+
+    std::uint64_t h = FnvOffsetBasis;
+    if (paint && !paint->empty())
+        h = hashValue(paint->contentHash(), h);
+    h = foldObjects(scene.strokes, h);
+    h = foldObjects(scene.characters, h);
+    h = foldObjects(scene.bubbles, h);
+    if (!scene.groups.empty()) // Keeps the hashes of scenes without groups
+        h = foldObjects(scene.groups, h);
+
+    m_scene = &scene;
+    m_revision = revision;
+    m_paint = paint;
+    m_paintRevision = paintRevision;
+    m_hash = h;
+    m_valid = true;
+    return h;
+}
+
+void SceneHasher::invalidate() { m_valid = false; }
@@ -0,0 +1,51 @@
+//=============================================================================
+// SceneHash.h
+//=============================================================================
+// PURPOSE:
+//   Stable 64-bit content hash of a Scene, used as the key of the export
+//   cache (see ExportCache.h). Two scenes with the same hash render to the
+//   same pixels.
+//
+// WHAT IS HASHED:
+//   Every object in draw order, through CanvasObject::getContentHash():
+//   transforms and flip, stroke points/color/thickness, character image key,
+//   bubble style, wrapped text, font and size, plus the file contents of
+//   every referenced image and font (via AssetManager), and the paint
+//   layer's tiles (PaintLayer::contentHash()).
+//   Output settings (format, level, canvas region) are added by the Exporter.
+//
+// INCREMENTAL UPDATES:
+//   Objects cache their own hash until a setter changes them, so after an
+//   edit only that object is rehashed and the rest are folded from cache.
+//   The scene hash itself is reused while no object changed (global object
+//   revision), the paint layer's revision is unchanged and no command ran (CommandManager change listener calls
+//   invalidate() for adds, deletes, undo and redo).
+//
+// WHERE TO MODIFY:
+//   - New object kinds: Fold their container in SceneHasher::hash() and
+//     override computeContentHash() in the class
+//=============================================================================
+
+#pragma once
+
+#include <cstdint>
+
+struct Scene;
+class PaintLayer;
+
+class SceneHasher {
+public:
+    // Hash of everything in `scene` that affects the exported image
+    std::uint64_t hash(const Scene& scene);
+
+    // Force a recomputation on the next hash() (scene structure changed)
+    void invalidate();
+
+private:
+    const Scene* m_scene{nullptr};
+    std::uint64_t m_revision{0};
+    const PaintLayer* m_paint{nullptr};
+    std::uint64_t m_paintRevision{0};
+    std::uint64_t m_hash{0};
+    bool m_valid{false};
+};
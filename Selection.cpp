@@ -0,0 +1,224 @@
+//=============================================================================
+// Selection.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the multi-object selection (see Selection.h).
+//=============================================================================
+
+#include "Selection.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Rubber bands smaller than this (px) in both directions are clicks
+    constexpr float ClickSlop = 2.f;
+
+    sf::FloatRect rectOf(const CanvasObject &o)
+    {
+        return sf::FloatRect(o.getPosition(), o.getSize());
+    }
+
+    // Inclusive, so zero-height strokes (straight lines) can be selected
+    bool overlaps(const sf::FloatRect &a, const sf::FloatRect &b)
+    {
+        return a.position.x <= b.position.x + b.size.x && b.position.x <= a.position.x + a.size.x &&
+               a.position.y <= b.position.y + b.size.y && b.position.y <= a.position.y + a.size.y;
+    }
+
+    // Even-odd rule
+    bool insidePolygon(const std::vector<sf::Vector2f> &polygon, sf::Vector2f p)
+    {
+        bool inside = false;
+        for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+        {
+            const sf::Vector2f a = polygon[i], b = polygon[j];
+            if ((a.y > p.y) != (b.y > p.y) && p.x < (b.x - a.x) * (p.y - a.y) / (b.y - a.y) + a.x)
+                inside = !inside;
+        }
+        return inside;
+    }
+
+    sf::Vector2f centerOf(const CanvasObject &o)
+    {
+        return o.getPosition() + o.getSize() * 0.5f;
+    }
+}
+
+void Selection::clear()
+{
+    m_strokes.clear();
+    m_characters.clear();
+    m_bubbles.clear();
+    m_groups.clear();
+    m_objects.clear();
+    m_start.clear();
+}
+
+void Selection::add(BrushStroke *stroke)
+{
+    m_strokes.push_back(stroke);
+    m_objects.push_back(stroke);
+}
+
+void Selection::add(Character *character)
+{
+    m_characters.push_back(character);
+    m_objects.push_back(character);
+}
+
+void Selection::add(SpeechBubble *bubble)
+{
+    m_bubbles.push_back(bubble);
+    m_objects.push_back(bubble);
+}
+
+void Selection::add(ObjectGroup *group)
+{
+    m_groups.push_back(group);
+    m_objects.push_back(group);
+}
+
+void Selection::selectRect(const Scene &scene, const sf::FloatRect &rect)
+{
+    // A plain click (no drag) picks what is under the cursor by the object's
+    // own hit test, not everything whose bounding box contains the point
+    const bool click = rect.size.x < ClickSlop && rect.size.y < ClickSlop;
+    const sf::Vector2f point = rect.getCenter();
+    auto picks = [&](const CanvasObject &o)
+    {
+        return click ? o.isClicked(point.x, point.y) : overlaps(rectOf(o), rect);
+    };
+
+    clear();
+    for (const auto &s : scene.strokes)
+        if (picks(*s))
+            add(s.get());
+    for (const auto &c : scene.characters)
+        if (picks(*c))
+            add(c.get());
+    for (const auto &b : scene.bubbles)
+        if (picks(*b))
+            add(b.get());
+    for (const auto &g : scene.groups)
+        if (picks(*g))
+            add(g.get());
+}
+
+void Selection::selectLasso(const Scene &scene, const std::vector<sf::Vector2f> &polygon)
+{
+    clear();
+    if (polygon.size() < 3)
+        return;
+    for (const auto &s : scene.strokes)
+        if (insidePolygon(polygon, centerOf(*s)))
+            add(s.get());
+    for (const auto &c : scene.characters)
+        if (insidePolygon(polygon, centerOf(*c)))
+            add(c.get());
+    for (const auto &b : scene.bubbles)
+        if (insidePolygon(polygon, centerOf(*b)))
+            add(b.get());
+    for (const auto &g : scene.groups)
+        if (insidePolygon(polygon, centerOf(*g)))
+            add(g.get());
+}
+
+sf::FloatRect Selection::bounds() const
+{
+    if (m_objects.empty())
+        return {};
+    sf::Vector2f lo = m_objects.front()->getPosition(), hi = lo;
+    for (const CanvasObject *o : m_objects)
+    {
+        const sf::FloatRect r = rectOf(*o);
+        lo = {std::min(lo.x, r.position.x), std::min(lo.y, r.position.y)};
+        hi = {std::max(hi.x, r.position.x + r.size.x), std::max(hi.y, r.position.y + r.size.y)};
+    }
+    return sf::FloatRect(lo, hi - lo);
+}
+
+bool Selection::hit(sf::Vector2f point) const
+{
+    return std::any_of(m_objects.begin(), m_objects.end(),
+                       [&](const CanvasObject *o) { return o->isClicked(point.x, point.y); });
+}
+
+Scene Selection::copy() const
+{
+    Scene scene;
+    for (const BrushStroke *s : m_strokes)
+        scene.strokes.push_back(s->clone(s->getId()));
+    for (const Character *c : m_characters)
+        scene.characters.push_back(c->clone(c->getId()));
+    for (const SpeechBubble *b : m_bubbles)
+        scene.bubbles.push_back(b->clone(b->getId()));
+    for (const ObjectGroup *g : m_groups)
+        scene.groups.push_back(g->clone(g->getId()));
+    return scene;
+}
+
+void Selection::beginTransform()
+{
+    m_start.clear();
+    m_start.reserve(m_objects.size());
+    for (CanvasObject *o : m_objects)
+        m_start.push_back(Placement::of(o));
+    m_startBounds = bounds();
+}
+
+void Selection::moveBy(sf::Vector2f delta)
+{
+    for (const Placement &p : m_start)
+        p.object->setPosition(p.position.x + delta.x, p.position.y + delta.y);
+}
+
+void Selection::resizeTo(sf::Vector2f size)
+{
+    // Scale about the top-left corner of the start bounds
+    const sf::FloatRect &b = m_startBounds;
+    const float sx = b.size.x > 0.f ? size.x / b.size.x : 1.f;
+    const float sy = b.size.y > 0.f ? size.y / b.size.y : 1.f;
+    for (Placement p : m_start)
+    {
+        p.position = {b.position.x + (p.position.x - b.position.x) * sx,
+                      b.position.y + (p.position.y - b.position.y) * sy};
+        p.size = {p.size.x * sx, p.size.y * sy};
+        p.apply();
+    }
+}
+
+std::unique_ptr<Command> Selection::endTransform(const std::string &name)
+{
+    std::vector<Placement> after;
+    after.reserve(m_start.size());
+    bool changed = false;
+    for (const Placement &p : m_start)
+    {
+        after.push_back(Placement::of(p.object));
+        const Placement &a = after.back();
+        changed = changed || a.position != p.position || a.size != p.size || a.flipped != p.flipped;
+    }
+    std::vector<Placement> before = std::move(m_start);
+    m_start.clear();
+    if (!changed)
+        return nullptr;
+    return std::make_unique<TransformCommand>(std::move(before), std::move(after), name);
+}
+
+std::unique_ptr<Command> Selection::flipCommand() const
+{
+    const sf::FloatRect b = bounds();
+    std::vector<Placement> before, after;
+    before.reserve(m_objects.size());
+    after.reserve(m_objects.size());
+    for (CanvasObject *o : m_objects)
+    {
+        before.push_back(Placement::of(o));
+        Placement p = before.back();
+        p.position.x = b.position.x + b.size.x - (p.position.x - b.position.x) - p.size.x;
+        p.flipped = !p.flipped;
+        after.push_back(p);
+    }
+    return std::make_unique<TransformCommand>(std::move(before), std::move(after), "Flip");
+}
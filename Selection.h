@@ -0,0 +1,87 @@
+//=============================================================================
+// Selection.h
+//=============================================================================
+// PURPOSE:
+//   Multi-object selection for the editor: any mix of strokes, characters,
+//   bubbles and groups picked with a rubber-band rectangle or a lasso, then moved,
+//   resized or flipped as a group.
+//
+// KEY FEATURES:
+//   - selectRect(): objects whose rect overlaps the rectangle; a click
+//     (a rectangle under 2 px) selects the objects whose hit test contains it
+//   - selectLasso(): objects whose rect center lies inside the polygon
+//   - Group transforms change one Placement (position, size, flip) per
+//     object, never individual points: strokes apply it through their
+//     per-instance transform (BrushStroke.h), so dragging a drawing of
+//     hundreds of strokes costs one setPosition() per stroke per event
+//   - Interactive: beginTransform() remembers the start placements,
+//     moveBy()/resizeTo() re-place every object from them on each mouse
+//     move, endTransform() returns the whole gesture as one undoable
+//     TransformCommand
+//
+// NOTES:
+//   - Holds raw pointers into the scene lists. Clear it whenever objects may
+//     leave the scene (undo/redo, delete, panel switch)
+//=============================================================================
+
+#pragma once
+
+#include "Command.h"
+#include "Scene.h"
+
+#include <SFML/Graphics.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class Selection {
+public:
+    void clear();
+    bool empty() const { return m_objects.empty(); }
+    std::size_t size() const { return m_objects.size(); }
+
+    void add(BrushStroke* stroke);
+    void add(Character* character);
+    void add(SpeechBubble* bubble);
+    void add(ObjectGroup* group);
+
+    // Replace the selection with the scene objects inside the area
+    void selectRect(const Scene& scene, const sf::FloatRect& rect);
+    void selectLasso(const Scene& scene, const std::vector<sf::Vector2f>& polygon);
+
+    const std::vector<CanvasObject*>& objects() const { return m_objects; }
+    const std::vector<ObjectGroup*>& groups() const { return m_groups; }
+
+    // Union of the selected object rects
+    sf::FloatRect bounds() const;
+
+    // True when `point` is on one of the selected objects
+    bool hit(sf::Vector2f point) const;
+
+    // Clones of the selected objects (same ids), for copy/duplicate
+    Scene copy() const;
+
+    // Interactive group transform, relative to the placements and bounds at
+    // beginTransform()
+    void beginTransform();
+    void moveBy(sf::Vector2f delta);
+    void resizeTo(sf::Vector2f size);
+
+    // The gesture as one command (already applied; execute() re-applies),
+    // or null when nothing changed
+    std::unique_ptr<Command> endTransform(const std::string& name);
+
+    // Mirror every object inside the selection bounds (not applied yet)
+    std::unique_ptr<Command> flipCommand() const;
+
+private:
+    std::vector<BrushStroke*> m_strokes;
+    std::vector<Character*> m_characters;
+    std::vector<SpeechBubble*> m_bubbles;
+    std::vector<ObjectGroup*> m_groups;
+    std::vector<CanvasObject*> m_objects;         // All of the above
+
+    std::vector<Placement> m_start;               // At beginTransform()
+    sf::FloatRect m_startBounds;
+};
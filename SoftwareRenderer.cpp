@@ -0,0 +1,716 @@
+//=============================================================================
+// SoftwareRenderer.cpp
+//=============================================================================
+// PURPOSE:
+//   Implements the CPU rasterizer declared in SoftwareRenderer.h.
+//
+// PIPELINE:
+//   1. Walk the scene in draw order and emit pixel-space primitives
+//      (circles, convex polygons, textured quads, glyph bitmaps).
+//      Asset lookups happen here, on the calling thread.
+//   2. Bin every primitive into the TileSize x TileSize tiles it touches.
+//   3. Worker threads pull tiles from an atomic counter and rasterize each
+//      tile's primitives in order, clipped to the tile. Tiles never overlap,
+//      so no locking is needed on the target buffer.
+//
+// NOTES:
+//   - A pixel is covered when its center lies inside the primitive, which is
+//     the OpenGL rule for non-multisampled rendering.
+//   - Blending follows sf::BlendAlpha: rgb = src*a + dst*(1-a),
+//     alpha = a + dst.a*(1-a), computed in 8-bit fixed point.
+//   - Bubble outlines reproduce sf::Shape's mitered outline strip.
+//=============================================================================
+
+#include "SoftwareRenderer.h"
+#include "AssetManager.h"
+#include "FrameWatchdog.h"
+#include "GlyphCache.h"
+#include "Scene.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COMIC_RASTER_SSE2 1
+#endif
+
+namespace
+{
+    //-------------------------------------------------------------------------
+    // PIXEL OPERATIONS
+    //-------------------------------------------------------------------------
+
+    // Rounded x / 255 for x in [0, 65025]
+    inline std::uint32_t div255(std::uint32_t x)
+    {
+        x += 128;
+        return (x + (x >> 8)) >> 8;
+    }
+
+    inline void blendPixel(std::uint8_t *dst, const sf::Color &c, std::uint32_t alpha)
+    {
+        if (alpha == 0)
+            return;
+        if (alpha == 255)
+        {
+            dst[0] = c.r; dst[1] = c.g; dst[2] = c.b; dst[3] = 255;
+            return;
+        }
+        std::uint32_t inv = 255 - alpha;
+        dst[0] = static_cast<std::uint8_t>(div255(c.r * alpha + dst[0] * inv));
+        dst[1] = static_cast<std::uint8_t>(div255(c.g * alpha + dst[1] * inv));
+        dst[2] = static_cast<std::uint8_t>(div255(c.b * alpha + dst[2] * inv));
+        dst[3] = static_cast<std::uint8_t>(div255(255 * alpha + dst[3] * inv));
+    }
+
+    // Blend a solid color over `count` consecutive pixels
+    void fillSpan(std::uint8_t *dst, int count, const sf::Color &c)
+    {
+        if (count <= 0 || c.a == 0)
+            return;
+        int i = 0;
+
+        if (c.a == 255)
+        {
+            const std::uint8_t rgba[4] = {c.r, c.g, c.b, 255};
+            std::uint32_t packed;
+            std::memcpy(&packed, rgba, 4);
+#ifdef COMIC_RASTER_SSE2
+            const __m128i v = _mm_set1_epi32(static_cast<int>(packed));
+            for (; i + 4 <= count; i += 4)
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), v);
+#endif
+            for (; i < count; ++i)
+                std::memcpy(dst + i * 4, &packed, 4);
+            return;
+        }
+
+#ifdef COMIC_RASTER_SSE2
+        // Two pixels per 128-bit register as 16-bit lanes: src*a + dst*(255-a),
+        // then the same rounded divide-by-255 as div255()
+        const std::uint32_t a = c.a;
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i inv = _mm_set1_epi16(static_cast<short>(255 - a));
+        const short sr = static_cast<short>(c.r * a + 128);
+        const short sg = static_cast<short>(c.g * a + 128);
+        const short sb = static_cast<short>(c.b * a + 128);
+        const short sa = static_cast<short>(255 * a + 128);
+        const __m128i src = _mm_setr_epi16(sr, sg, sb, sa, sr, sg, sb, sa);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i * 4));
+            __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(px, zero), inv), src);
+            __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(px, zero), inv), src);
+            lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+            hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), _mm_packus_epi16(lo, hi));
+        }
+#endif
+        for (; i < count; ++i)
+            blendPixel(dst + i * 4, c, c.a);
+    }
+
+    //-------------------------------------------------------------------------
+    // PRIMITIVES
+    //-------------------------------------------------------------------------
+
+    enum class PrimKind : std::uint8_t
+    {
+        Circle,
+        Polygon,
+        Image,
+        Glyph
+    };
+
+    struct Primitive
+    {
+        PrimKind kind{PrimKind::Polygon};
+        sf::Color color;
+        int x0{0}, y0{0}, x1{0}, y1{0};        // Pixel bounds, half-open
+
+        float cx{0.f}, cy{0.f}, radius{0.f};   // Circle
+        std::uint32_t first{0}, count{0};      // Polygon / image outline points
+
+        const std::uint8_t *texels{nullptr};   // Image: RGBA texels, pixel -> texel affine map
+        int texW{0}, texH{0};
+        float inv[6]{};                        // u = inv0*x + inv1*y + inv2, v = inv3*x + inv4*y + inv5
+
+        const GlyphBitmap *glyph{nullptr};     // Glyph: bitmap origin in pixels
+        float gx{0.f}, gy{0.f};
+    };
+
+    struct ClipRect
+    {
+        int x0, y0, x1, y1;
+    };
+
+    class PrimitiveList
+    {
+    public:
+        explicit PrimitiveList(sf::Vector2u size) : m_width(static_cast<int>(size.x)), m_height(static_cast<int>(size.y)) {}
+
+        std::vector<Primitive> prims;
+        std::vector<sf::Vector2f> points;
+        std::vector<ImagePtr> images;          // Keeps referenced images alive
+
+        void addCircle(sf::Vector2f center, float radius, const sf::Color &color)
+        {
+            if (color.a == 0 || radius <= 0.f)
+                return;
+            Primitive p;
+            p.kind = PrimKind::Circle;
+            p.color = color;
+            p.cx = center.x;
+            p.cy = center.y;
+            p.radius = radius;
+            if (setBounds(p, center.x - radius, center.y - radius, center.x + radius, center.y + radius))
+                prims.push_back(p);
+        }
+
+        void addPolygon(const sf::Vector2f *pts, std::size_t n, const sf::Color &color)
+        {
+            if (color.a == 0 || n < 3)
+                return;
+            Primitive p;
+            p.kind = PrimKind::Polygon;
+            p.color = color;
+            if (pushPoints(p, pts, n))
+                prims.push_back(p);
+        }
+
+        void addTriangle(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, const sf::Color &color)
+        {
+            const sf::Vector2f tri[3] = {a, b, c};
+            addPolygon(tri, 3, color);
+        }
+
+        // Textured quad covering texture rect (0,0)-(size) under `transform`
+        void addImage(const ImagePtr &image, const sf::Transform &transform)
+        {
+            if (image && addTexels(image->getPixelsPtr(), image->getSize(), transform))
+                images.push_back(image);
+        }
+
+        // Same for raw RGBA texels the caller keeps alive (paint tiles)
+        bool addTexels(const std::uint8_t *texels, sf::Vector2u size, const sf::Transform &transform)
+        {
+            if (!texels || size.x == 0 || size.y == 0)
+                return false;
+
+            const float w = static_cast<float>(size.x), h = static_cast<float>(size.y);
+            const sf::Vector2f corners[4] = {
+                transform.transformPoint({0.f, 0.f}), transform.transformPoint({w, 0.f}),
+                transform.transformPoint({w, h}), transform.transformPoint({0.f, h})};
+
+            // Column-major 4x4 from sf::Transform::getMatrix()
+            const float *m = transform.getInverse().getMatrix();
+
+            Primitive p;
+            p.kind = PrimKind::Image;
+            p.color = sf::Color::White;
+            p.texels = texels;
+            p.texW = static_cast<int>(size.x);
+            p.texH = static_cast<int>(size.y);
+            p.inv[0] = m[0]; p.inv[1] = m[4]; p.inv[2] = m[12];
+            p.inv[3] = m[1]; p.inv[4] = m[5]; p.inv[5] = m[13];
+            if (!pushPoints(p, corners, 4))
+                return false;
+            prims.push_back(p);
+            return true;
+        }
+
+        void addGlyph(const GlyphBitmap *glyph, sf::Vector2f topLeft, const sf::Color &color)
+        {
+            if (!glyph || glyph->width == 0 || glyph->height == 0 || color.a == 0)
+                return;
+            Primitive p;
+            p.kind = PrimKind::Glyph;
+            p.color = color;
+            p.glyph = glyph;
+            p.gx = topLeft.x;
+            p.gy = topLeft.y;
+            // One extra pixel each side for bilinear sampling of the edges
+            if (setBounds(p, topLeft.x - 1.f, topLeft.y - 1.f,
+                          topLeft.x + static_cast<float>(glyph->width) + 1.f,
+                          topLeft.y + static_cast<float>(glyph->height) + 1.f))
+                prims.push_back(p);
+        }
+
+    private:
+        int m_width, m_height;
+
+        bool pushPoints(Primitive &p, const sf::Vector2f *pts, std::size_t n)
+        {
+            float minX = pts[0].x, minY = pts[0].y, maxX = pts[0].x, maxY = pts[0].y;
+            for (std::size_t i = 1; i < n; ++i)
+            {
+                minX = std::min(minX, pts[i].x); maxX = std::max(maxX, pts[i].x);
+                minY = std::min(minY, pts[i].y); maxY = std::max(maxY, pts[i].y);
+            }
+            if (!setBounds(p, minX, minY, maxX, maxY))
+                return false;
+            p.first = static_cast<std::uint32_t>(points.size());
+            p.count = static_cast<std::uint32_t>(n);
+            points.insert(points.end(), pts, pts + n);
+            return true;
+        }
+
+        bool setBounds(Primitive &p, float minX, float minY, float maxX, float maxY)
+        {
+            p.x0 = std::max(0, static_cast<int>(std::floor(minX)));
+            p.y0 = std::max(0, static_cast<int>(std::floor(minY)));
+            p.x1 = std::min(m_width, static_cast<int>(std::ceil(maxX)) + 1);
+            p.y1 = std::min(m_height, static_cast<int>(std::ceil(maxY)) + 1);
+            return p.x0 < p.x1 && p.y0 < p.y1;
+        }
+    };
+
+    //-------------------------------------------------------------------------
+    // SCENE -> PRIMITIVES
+    //-------------------------------------------------------------------------
+
+    // sf::Shape::updateOutline(): extrude every point along the mitered
+    // normal, pointing away from the fan center
+    std::vector<sf::Vector2f> shapeOutline(const std::vector<sf::Vector2f> &pts,
+                                           sf::Vector2f center, float thickness)
+    {
+        auto computeNormal = [](sf::Vector2f p1, sf::Vector2f p2)
+        {
+            sf::Vector2f n{p1.y - p2.y, p2.x - p1.x};
+            float len = std::sqrt(n.x * n.x + n.y * n.y);
+            if (len != 0.f)
+                n = {n.x / len, n.y / len};
+            return n;
+        };
+
+        const std::size_t count = pts.size();
+        std::vector<sf::Vector2f> strip;
+        strip.reserve(count * 2 + 2);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::Vector2f p0 = pts[(i + count - 1) % count];
+            sf::Vector2f p1 = pts[i];
+            sf::Vector2f p2 = pts[(i + 1) % count];
+
+            sf::Vector2f n1 = computeNormal(p0, p1);
+            sf::Vector2f n2 = computeNormal(p1, p2);
+            sf::Vector2f toCenter{center.x - p1.x, center.y - p1.y};
+            if (n1.x * toCenter.x + n1.y * toCenter.y > 0.f)
+                n1 = {-n1.x, -n1.y};
+            if (n2.x * toCenter.x + n2.y * toCenter.y > 0.f)
+                n2 = {-n2.x, -n2.y};
+
+            float factor = 1.f + (n1.x * n2.x + n1.y * n2.y);
+            sf::Vector2f normal{(n1.x + n2.x) / factor, (n1.y + n2.y) / factor};
+
+            strip.push_back(p1);
+            strip.push_back({p1.x + normal.x * thickness, p1.y + normal.y * thickness});
+        }
+        strip.push_back(strip[0]);
+        strip.push_back(strip[1]);
+        return strip;
+    }
+
+    void emitShape(PrimitiveList &out, const sf::Shape &shape, const sf::Transform &view)
+    {
+        const std::size_t count = shape.getPointCount();
+        if (count < 3)
+            return;
+
+        std::vector<sf::Vector2f> local(count);
+        float minX = 0.f, minY = 0.f, maxX = 0.f, maxY = 0.f;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            local[i] = shape.getPoint(i);
+            if (i == 0 || local[i].x < minX) minX = local[i].x;
+            if (i == 0 || local[i].y < minY) minY = local[i].y;
+            if (i == 0 || local[i].x > maxX) maxX = local[i].x;
+            if (i == 0 || local[i].y > maxY) maxY = local[i].y;
+        }
+        // sf::Shape fans its fill from the center of the point bounds
+        sf::Vector2f center{(minX + maxX) * 0.5f, (minY + maxY) * 0.5f};
+
+        sf::Transform t = view * shape.getTransform();
+
+        sf::Vector2f c = t.transformPoint(center);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            out.addTriangle(c, t.transformPoint(local[i]),
+                            t.transformPoint(local[(i + 1) % count]), shape.getFillColor());
+        }
+
+        float thickness = shape.getOutlineThickness();
+        if (thickness == 0.f)
+            return;
+
+        auto strip = shapeOutline(local, center, thickness);
+        for (auto &p : strip)
+            p = t.transformPoint(p);
+        for (std::size_t i = 0; i + 2 < strip.size(); ++i)
+            out.addTriangle(strip[i], strip[i + 1], strip[i + 2], shape.getOutlineColor());
+    }
+
+    // Same transform Character::draw / SpeechBubble::draw give their sprites
+    sf::Transform spriteTransform(sf::Vector2u texSize, sf::Vector2f pos, sf::Vector2f size,
+                                  float rotationDeg, bool flipped)
+    {
+        float sx = size.x / static_cast<float>(texSize.x);
+        float sy = size.y / static_cast<float>(texSize.y);
+
+        sf::Transformable xf;
+        if (flipped)
+        {
+            xf.setScale({-sx, sy});
+            xf.setOrigin({static_cast<float>(texSize.x), 0.f});
+        }
+        else
+        {
+            xf.setScale({sx, sy});
+        }
+        xf.setPosition(pos);
+        xf.setRotation(sf::degrees(rotationDeg));
+        return xf.getTransform();
+    }
+
+    void emitScene(PrimitiveList &out, const Scene &scene, const RasterSettings &rs)
+    {
+        auto &AM = AssetManager::getInstance();
+        auto &GC = GlyphCache::getInstance();
+
+        // World -> pixel mapping
+        sf::Transform view;
+        view.scale({rs.scale, rs.scale});
+        view.translate({-rs.origin.x, -rs.origin.y});
+
+        // 0. Paint layer: one textured quad per tile
+        if (scene.paint)
+        {
+            const sf::Vector2u tileSize(PaintLayer::TileSize, PaintLayer::TileSize);
+            for (const auto &[key, tile] : scene.paint->tiles())
+            {
+                sf::Transform at = view;
+                at.translate({static_cast<float>(key.x * PaintLayer::TileSize),
+                              static_cast<float>(key.y * PaintLayer::TileSize)});
+                out.addTexels(tile->pixels.data(), tileSize, at);
+            }
+        }
+
+        // 1. Brush strokes: one filled dot per stored point
+        for (const auto &s : scene.strokes)
+        {
+            float radius = std::max(s->getThickness() * 0.5f, 0.5f) * rs.scale;
+            const sf::Transform at = view * s->getTransform();
+            for (const auto &p : s->getPoints())
+                out.addCircle(at.transformPoint(p), radius, s->getColor());
+        }
+
+        // 2. Characters: textured quads
+        for (const auto &c : scene.characters)
+        {
+            auto img = AM.getImage(c->getImagePath());
+            if (!img || img->getSize().x == 0 || img->getSize().y == 0)
+                continue;
+            out.addImage(img, view * spriteTransform(img->getSize(), c->getPosition(), c->getSize(),
+                                                     c->getRotation(), c->isFlipped()));
+        }
+
+        // 3. Bubbles: image or procedural shape, then text on top
+        for (const auto &b : scene.bubbles)
+        {
+            if (b->usesImageBubble())
+            {
+                auto img = AM.getImage(b->getBubbleImageKey());
+                if (img && img->getSize().x > 0 && img->getSize().y > 0)
+                    out.addImage(img, view * spriteTransform(img->getSize(), b->getPosition(), b->getSize(),
+                                                             0.f, b->isFlipped()));
+            }
+            else
+            {
+                sf::ConvexShape shape = b->getShape();
+                if (b->isFlipped())
+                {
+                    shape.setScale({-1.f, 1.f});
+                    shape.setOrigin({b->getSize().x, 0.f});
+                }
+                emitShape(out, shape, view);
+            }
+
+            const std::string &text = b->getWrappedText();
+            if (text.empty())
+                continue;
+
+            unsigned size = static_cast<unsigned>(std::lround(static_cast<float>(b->getFontSize()) * rs.scale));
+            TextLayout layout = GC.layoutText(AM.getFontPath(b->getFontName()), size, text);
+
+            // sf::Text origin is the center of its local bounds (centerText())
+            sf::Vector2f anchor = view.transformPoint(b->getTextCenter());
+            sf::Vector2f base{anchor.x - (layout.bounds.position.x + layout.bounds.size.x / 2.f),
+                              anchor.y - (layout.bounds.position.y + layout.bounds.size.y / 2.f)};
+            for (const auto &g : layout.glyphs)
+            {
+                out.addGlyph(g.glyph,
+                             {base.x + g.pen.x + static_cast<float>(g.glyph->left),
+                              base.y + g.pen.y + static_cast<float>(g.glyph->top)},
+                             b->getTextColor());
+            }
+        }
+
+        // 4. Groups: their members, placed in the world
+        for (const auto &g : scene.groups)
+            emitScene(out, g->worldMembers(), rs);
+    }
+
+    //-------------------------------------------------------------------------
+    // RASTERIZATION (one primitive clipped to one tile)
+    //-------------------------------------------------------------------------
+
+    // Horizontal extent [xs, xe) of pixel centers inside a convex polygon on row y
+    bool convexSpan(const sf::Vector2f *pts, std::uint32_t n, int y, int &xs, int &xe)
+    {
+        float yc = static_cast<float>(y) + 0.5f;
+        float left = 0.f, right = 0.f;
+        bool any = false;
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            const sf::Vector2f &p = pts[i];
+            const sf::Vector2f &q = pts[(i + 1) % n];
+            if ((p.y <= yc && q.y > yc) || (q.y <= yc && p.y > yc))
+            {
+                float x = p.x + (yc - p.y) * (q.x - p.x) / (q.y - p.y);
+                if (!any) { left = right = x; any = true; }
+                else { left = std::min(left, x); right = std::max(right, x); }
+            }
+        }
+        if (!any)
+            return false;
+        xs = static_cast<int>(std::ceil(left - 0.5f));
+        xe = static_cast<int>(std::ceil(right - 0.5f));
+        return xs < xe;
+    }
+
+    void rasterize(const Primitive &p, const std::vector<sf::Vector2f> &points,
+                   RgbaBuffer &target, const ClipRect &clip)
+    {
+        const int x0 = std::max(p.x0, clip.x0), x1 = std::min(p.x1, clip.x1);
+        const int y0 = std::max(p.y0, clip.y0), y1 = std::min(p.y1, clip.y1);
+        if (x0 >= x1 || y0 >= y1)
+            return;
+
+        switch (p.kind)
+        {
+        case PrimKind::Circle:
+        {
+            const float r2 = p.radius * p.radius;
+            for (int y = y0; y < y1; ++y)
+            {
+                float dy = static_cast<float>(y) + 0.5f - p.cy;
+                float d2 = r2 - dy * dy;
+                if (d2 < 0.f)
+                    continue;
+                float half = std::sqrt(d2);
+                int xs = std::max(x0, static_cast<int>(std::ceil(p.cx - half - 0.5f)));
+                int xe = std::min(x1, static_cast<int>(std::floor(p.cx + half - 0.5f)) + 1);
+                fillSpan(target.row(static_cast<unsigned>(y)) + xs * 4, xe - xs, p.color);
+            }
+            break;
+        }
+        case PrimKind::Polygon:
+        {
+            const sf::Vector2f *pts = points.data() + p.first;
+            for (int y = y0; y < y1; ++y)
+            {
+                int xs, xe;
+                if (!convexSpan(pts, p.count, y, xs, xe))
+                    continue;
+                xs = std::max(xs, x0);
+                xe = std::min(xe, x1);
+                fillSpan(target.row(static_cast<unsigned>(y)) + xs * 4, xe - xs, p.color);
+            }
+            break;
+        }
+        case PrimKind::Image:
+        {
+            const sf::Vector2f *pts = points.data() + p.first;
+            const std::uint8_t *texels = p.texels;
+            const int tw = p.texW, th = p.texH;
+            for (int y = y0; y < y1; ++y)
+            {
+                int xs, xe;
+                if (!convexSpan(pts, p.count, y, xs, xe))
+                    continue;
+                xs = std::max(xs, x0);
+                xe = std::min(xe, x1);
+                float fx = static_cast<float>(xs) + 0.5f, fy = static_cast<float>(y) + 0.5f;
+                float u = p.inv[0] * fx + p.inv[1] * fy + p.inv[2];
+                float v = p.inv[3] * fx + p.inv[4] * fy + p.inv[5];
+                std::uint8_t *dst = target.row(static_cast<unsigned>(y)) + xs * 4;
+                for (int x = xs; x < xe; ++x, dst += 4, u += p.inv[0], v += p.inv[3])
+                {
+                    // Nearest filtering (sf::Texture is not smooth by default)
+                    int tx = std::clamp(static_cast<int>(std::floor(u)), 0, tw - 1);
+                    int ty = std::clamp(static_cast<int>(std::floor(v)), 0, th - 1);
+                    const std::uint8_t *t = texels + (static_cast<std::size_t>(ty) * tw + tx) * 4;
+                    blendPixel(dst, sf::Color(t[0], t[1], t[2]), t[3]);
+                }
+            }
+            break;
+        }
+        case PrimKind::Glyph:
+        {
+            // Font textures are smooth: bilinear sample the coverage bitmap
+            const GlyphBitmap &g = *p.glyph;
+            const int gw = static_cast<int>(g.width), gh = static_cast<int>(g.height);
+            auto coverage = [&](int i, int j) -> float
+            {
+                if (i < 0 || j < 0 || i >= gw || j >= gh)
+                    return 0.f;
+                return static_cast<float>(g.coverage[static_cast<std::size_t>(j) * gw + i]);
+            };
+            for (int y = y0; y < y1; ++y)
+            {
+                float fy = static_cast<float>(y) - p.gy;
+                int j0 = static_cast<int>(std::floor(fy));
+                float ty = fy - static_cast<float>(j0);
+                std::uint8_t *dst = target.row(static_cast<unsigned>(y)) + x0 * 4;
+                for (int x = x0; x < x1; ++x, dst += 4)
+                {
+                    float fx = static_cast<float>(x) - p.gx;
+                    int i0 = static_cast<int>(std::floor(fx));
+                    float tx = fx - static_cast<float>(i0);
+                    float top = coverage(i0, j0) * (1.f - tx) + coverage(i0 + 1, j0) * tx;
+                    float bottom = coverage(i0, j0 + 1) * (1.f - tx) + coverage(i0 + 1, j0 + 1) * tx;
+                    auto cov = static_cast<std::uint32_t>(top * (1.f - ty) + bottom * ty + 0.5f);
+                    blendPixel(dst, p.color, div255(cov * p.color.a));
+                }
+            }
+            break;
+        }
+        }
+    }
+}
+
+//=============================================================================
+// RgbaBuffer
+//=============================================================================
+
+RgbaBuffer::RgbaBuffer(sf::Vector2u size, sf::Color fill) { resize(size, fill); }
+
+void RgbaBuffer::resize(sf::Vector2u size, sf::Color fill)
+{
+    m_size = size;
+    m_pixels.resize(static_cast<std::size_t>(size.x) * size.y * 4);
+    const std::uint8_t rgba[4] = {fill.r, fill.g, fill.b, fill.a};
+    for (std::size_t i = 0; i < m_pixels.size(); i += 4)
+        std::memcpy(m_pixels.data() + i, rgba, 4);
+}
+
+sf::Vector2u RgbaBuffer::getSize() const { return m_size; }
+
+std::uint8_t *RgbaBuffer::row(unsigned y) { return m_pixels.data() + static_cast<std::size_t>(y) * m_size.x * 4; }
+
+const std::uint8_t *RgbaBuffer::row(unsigned y) const { return m_pixels.data() + static_cast<std::size_t>(y) * m_size.x * 4; }
+
+const std::uint8_t *RgbaBuffer::getPixelsPtr() const { return m_pixels.data(); }
+
+sf::Image RgbaBuffer::toImage() const
+{
+    if (m_size.x == 0 || m_size.y == 0)
+        return sf::Image();
+    return sf::Image(m_size, m_pixels.data());
+}
+
+//=============================================================================
+// SoftwareRenderer
+//=============================================================================
+
+SoftwareRenderer::SoftwareRenderer(const RasterSettings &settings) : m_settings(settings) {}
+
+RgbaBuffer SoftwareRenderer::render(const Scene &scene) const
+{
+    RgbaBuffer target;
+    render(scene, target);
+    return target;
+}
+
+void SoftwareRenderer::render(const Scene &scene, RgbaBuffer &target) const
+{
+    TimedScope timed("render/software");
+    const sf::Vector2u size = m_settings.size;
+    target.resize(size, m_settings.clearColor);
+    if (size.x == 0 || size.y == 0)
+        return;
+
+    PrimitiveList list(size);
+    emitScene(list, scene, m_settings);
+
+    // Bin primitives into tiles (draw order is preserved inside each bin)
+    const unsigned tilesX = (size.x + TileSize - 1) / TileSize;
+    const unsigned tilesY = (size.y + TileSize - 1) / TileSize;
+    std::vector<std::vector<std::uint32_t>> bins(static_cast<std::size_t>(tilesX) * tilesY);
+    for (std::uint32_t i = 0; i < list.prims.size(); ++i)
+    {
+        const Primitive &p = list.prims[i];
+        unsigned tx1 = static_cast<unsigned>(p.x1 - 1) / TileSize;
+        unsigned ty1 = static_cast<unsigned>(p.y1 - 1) / TileSize;
+        for (unsigned ty = static_cast<unsigned>(p.y0) / TileSize; ty <= ty1; ++ty)
+            for (unsigned tx = static_cast<unsigned>(p.x0) / TileSize; tx <= tx1; ++tx)
+                bins[static_cast<std::size_t>(ty) * tilesX + tx].push_back(i);
+    }
+
+    std::atomic<std::size_t> nextTile{0};
+    auto worker = [&]()
+    {
+        for (std::size_t t = nextTile++; t < bins.size(); t = nextTile++)
+        {
+            if (bins[t].empty())
+                continue;
+            int tx = static_cast<int>(t % tilesX), ty = static_cast<int>(t / tilesX);
+            ClipRect clip{tx * static_cast<int>(TileSize), ty * static_cast<int>(TileSize),
+                          std::min(static_cast<int>(size.x), (tx + 1) * static_cast<int>(TileSize)),
+                          std::min(static_cast<int>(size.y), (ty + 1) * static_cast<int>(TileSize))};
+            for (std::uint32_t index : bins[t])
+                rasterize(list.prims[index], list.points, target, clip);
+        }
+    };
+
+    unsigned threads = m_settings.threads ? m_settings.threads : std::thread::hardware_concurrency();
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(bins.size())));
+
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; ++i)
+        pool.emplace_back(worker);
+    worker();
+    for (auto &th : pool)
+        th.join();
+}
+
+RasterDiff SoftwareRenderer::compare(const std::uint8_t *a, const std::uint8_t *b,
+                                     sf::Vector2u size, unsigned tolerance)
+{
+    RasterDiff diff;
+    const std::size_t pixels = static_cast<std::size_t>(size.x) * size.y;
+    if (pixels == 0)
+        return diff;
+
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < pixels; ++i)
+    {
+        unsigned worst = 0;
+        for (int c = 0; c < 4; ++c)
+        {
+            unsigned d = static_cast<unsigned>(std::abs(static_cast<int>(a[i * 4 + c]) - static_cast<int>(b[i * 4 + c])));
+            total += d;
+            worst = std::max(worst, d);
+        }
+        diff.maxChannelDelta = std::max(diff.maxChannelDelta, worst);
+        if (worst > tolerance)
+            ++diff.pixelsOverTolerance;
+    }
+    diff.meanChannelDelta = static_cast<double>(total) / static_cast<double>(pixels * 4);
+    return diff;
+}
@@ -14,9 +14,14 @@
 
 #include "SpeechBubble.h"
 #include "AssetManager.h"
+#include "ContentHash.h"
+#include "FrameWatchdog.h"
+#include "GlyphCache.h"
+#include "Logger.h"
+#include "MemoryStats.h"
+#include "Telemetry.h"
 #include <algorithm>
 #include <cmath>
-#include <iostream>
 
 namespace
 {
@@ -43,9 +48,23 @@ SpeechBubble::SpeechBubble(const std::string &id,
     wrapText();
 }
 
+sf::FloatRect SpeechBubble::measureText(const std::string &text)
+{
+    auto &AM = AssetManager::getInstance();
+    if (AM.isHeadless()) {
+        // sf::Text bounds need glyph textures (OpenGL); measure on the CPU instead
+        return GlyphCache::getInstance().layoutText(AM.getFontPath(fontName_),
+                                                    static_cast<unsigned>(fontSize_), text).bounds;
+    }
+    m_text.setString(text);
+    return m_text.getLocalBounds();
+}
+
 void SpeechBubble::wrapText()
 {
-    if (text_.empty()) { m_text.setString(""); centerText(); return; }
+    TimedScope timed("text/wrap");
+    TelemetryTimer telemetry(Metric::WrapText);
+    if (text_.empty()) { wrappedText_.clear(); m_text.setString(""); centerText(); touch(); return; }
 
     float maxWidth = width_ * 0.80f;
     std::string wrappedText, currentWord, currentLine;
@@ -53,9 +72,8 @@ void SpeechBubble::wrapText()
     for (char c : text_) {
         if (c == ' ' || c == '\n') {
             std::string testLine = currentLine.empty() ? currentWord : currentLine + " " + currentWord;
-            m_text.setString(testLine);
             // SFML 3: usage of getLocalBounds().size.x is correct here
-            if (m_text.getLocalBounds().size.x > maxWidth && !currentLine.empty()) {
+            if (measureText(testLine).size.x > maxWidth && !currentLine.empty()) {
                 wrappedText += currentLine + "\n";
                 currentLine = currentWord;
             } else {
@@ -65,8 +83,7 @@ void SpeechBubble::wrapText()
             if (c == '\n') { wrappedText += currentLine + "\n"; currentLine.clear(); }
         } else {
             currentWord += c;
-            m_text.setString(currentWord);
-            if (m_text.getLocalBounds().size.x > maxWidth) {
+            if (measureText(currentWord).size.x > maxWidth) {
                 if (currentWord.length() > 1) {
                     char lastChar = currentWord.back(); currentWord.pop_back();
                     if (!currentLine.empty()) wrappedText += currentLine + " ";
@@ -78,15 +95,16 @@ void SpeechBubble::wrapText()
     }
     if (!currentWord.empty()) {
         std::string testLine = currentLine.empty() ? currentWord : currentLine + " " + currentWord;
-        m_text.setString(testLine);
-        if (m_text.getLocalBounds().size.x > maxWidth && !currentLine.empty()) wrappedText += currentLine + "\n" + currentWord;
+        if (measureText(testLine).size.x > maxWidth && !currentLine.empty()) wrappedText += currentLine + "\n" + currentWord;
         else wrappedText += testLine;
     } else if (!currentLine.empty()) {
         wrappedText += currentLine;
     }
 
+    wrappedText_ = wrappedText;
     m_text.setString(wrappedText);
     centerText();
+    touch();
 }
 
 void SpeechBubble::setSize(float w, float h)
@@ -108,10 +126,14 @@ void SpeechBubble::setSize(float w, float h)
 
 void SpeechBubble::centerText()
 {
-    auto bounds = m_text.getLocalBounds();
+    auto bounds = measureText(wrappedText_);
     // SFML 3: bounds.position.x and bounds.size.x
     m_text.setOrigin({bounds.position.x + bounds.size.x / 2.f, bounds.position.y + bounds.size.y / 2.f});
+    m_text.setPosition(getTextCenter());
+}
 
+sf::Vector2f SpeechBubble::getTextCenter() const
+{
     float centerX = m_position.x + width_ / 2.f;
     float centerY = m_position.y + height_ / 2.f;
 
@@ -121,7 +143,7 @@ void SpeechBubble::centerText()
         else if (style_ == "thought" || bubbleImagePath_ == "bubble_thought") centerY -= height_ * 0.08f;
         else if (style_ == "speech_rectangle" || bubbleImagePath_ == "bubble_speech_rectangle") centerY -= height_ * 0.12f;
     }
-    m_text.setPosition({centerX, centerY});
+    return {centerX, centerY};
 }
 
 void SpeechBubble::rebuild(float w, float h, float radius, float tailLen, float tailWidth) {
@@ -198,8 +220,15 @@ void SpeechBubble::rebuildShout(float w, float h) {
 
 void SpeechBubble::loadBubbleImage(const std::string &imagePath) {
     bubbleImagePath_ = imagePath;
-    auto tex = AssetManager::getInstance().getTexture(imagePath);
-    if (!tex) { useImageBubble_ = false; rebuild(width_, height_); return; }
+    auto &AM = AssetManager::getInstance();
+    auto tex = AM.getTexture(imagePath);
+    if (!tex) {
+        // Headless: the image is registered but has no GPU texture to draw from
+        useImageBubble_ = AM.isHeadless() && AM.hasTexture(imagePath);
+        m_bubbleSprite.reset();
+        rebuild(width_, height_);
+        return;
+    }
     m_bubbleSprite = sf::Sprite(*tex);
     useImageBubble_ = true;
     auto texSize = tex->getSize();
@@ -210,12 +239,13 @@ void SpeechBubble::loadBubbleImage(const std::string &imagePath) {
 void SpeechBubble::setStyle(const std::string &style) {
     style_ = style;
     std::string imagePath = "bubble_" + style;
-    if (AssetManager::getInstance().getTexture(imagePath)) loadBubbleImage(imagePath);
+    if (AssetManager::getInstance().hasTexture(imagePath)) loadBubbleImage(imagePath);
     else { useImageBubble_ = false; rebuild(width_, height_); }
+    touch();
 }
 
 // [FIXED] Updated Draw Method to use .size.x instead of .width for SFML 3
-void SpeechBubble::draw(sf::RenderWindow &window)
+void SpeechBubble::draw(sf::RenderTarget &target)
 {
     if (useImageBubble_ && m_bubbleSprite.has_value())
     {
@@ -226,7 +256,7 @@ void SpeechBubble::draw(sf::RenderWindow &window)
             // FIXED: Used .size.x instead of .width
             sprite.setOrigin({sprite.getLocalBounds().size.x, 0.f});
         }
-        window.draw(sprite);
+        target.draw(sprite);
     }
     else
     {
@@ -236,17 +266,39 @@ void SpeechBubble::draw(sf::RenderWindow &window)
             shape.setScale({-1.f, 1.f});
             shape.setOrigin({width_, 0.f});
         }
-        window.draw(shape);
+        target.draw(shape);
     }
 
     // Text is drawn NORMALLY (not flipped) over the bubble
-    window.draw(m_text);
+    target.draw(m_text);
+}
+
+std::unique_ptr<SpeechBubble> SpeechBubble::clone(const std::string& id) const {
+    auto copy = std::make_unique<SpeechBubble>(*this);
+    copy->id_ = id;
+    copy->m_id = id;
+    copy->touch();
+    return copy;
 }
 
 bool SpeechBubble::isClicked(float mouseX, float mouseY) const {
     return (mouseX >= x_ && mouseX <= x_ + width_ && mouseY >= y_ && mouseY <= y_ + height_);
 }
 
+std::size_t SpeechBubble::memoryBytes() const {
+    std::size_t bytes = CanvasObject::memoryBytes() + sizeof(SpeechBubble) - sizeof(CanvasObject);
+    bytes += heapBytes(text_) + heapBytes(wrappedText_) + heapBytes(fontName_) + heapBytes(style_) +
+             heapBytes(bubbleImagePath_);
+
+    // sf::ConvexShape: points, fan and outline strip
+    const std::size_t points = m_shape.getPointCount();
+    bytes += points * sizeof(sf::Vector2f) + (points + 2 + (points + 1) * 2) * sizeof(sf::Vertex);
+
+    // sf::Text: UTF-32 copy of the string and 6 vertices per glyph
+    bytes += wrappedText_.size() * (sizeof(char32_t) + 6 * sizeof(sf::Vertex));
+    return bytes;
+}
+
 void SpeechBubble::setPosition(float x, float y) {
     CanvasObject::setPosition(x, y);
     m_shape.setPosition(m_position);
@@ -254,6 +306,14 @@ void SpeechBubble::setPosition(float x, float y) {
     centerText();
 }
 
+const sf::ConvexShape &SpeechBubble::getShape() const { return m_shape; }
+bool SpeechBubble::usesImageBubble() const { return useImageBubble_; }
+const std::string &SpeechBubble::getBubbleImageKey() const { return bubbleImagePath_; }
+const std::string &SpeechBubble::getWrappedText() const { return wrappedText_; }
+const std::string &SpeechBubble::getFontName() const { return fontName_; }
+const std::string &SpeechBubble::getStyle() const { return style_; }
+sf::Color SpeechBubble::getTextColor() const { return m_text.getFillColor(); }
+
 void SpeechBubble::setText(const std::string &text) { text_ = text; wrapText(); }
 std::string SpeechBubble::getText() const { return text_; }
 void SpeechBubble::setFontSize(int size) { fontSize_ = size; m_text.setCharacterSize(size); wrapText(); }
@@ -261,5 +321,20 @@ int SpeechBubble::getFontSize() const { return fontSize_; }
 void SpeechBubble::setFontName(const std::string &fname) {
     fontName_ = fname;
     try { m_text.setFont(AssetManager::getInstance().getFont(fname)); wrapText(); }
-    catch (const std::exception &e) { std::cerr << e.what() << "\n"; }
-}
\ No newline at end of file
+    catch (const std::exception &e) { LOG_WARN("SpeechBubble") << e.what(); }
+}
+
+std::uint64_t SpeechBubble::computeContentHash() const
+{
+    auto &AM = AssetManager::getInstance();
+    std::uint64_t h = CanvasObject::computeContentHash();
+    h = fnv1a64(style_, h);
+    h = hashValue(useImageBubble_, h);
+    if (useImageBubble_)
+        h = hashValue(AM.getTextureHash(bubbleImagePath_), fnv1a64(bubbleImagePath_, h));
+    h = fnv1a64(wrappedText_, h);
+    h = fnv1a64(fontName_, h);
+    h = hashValue(AM.getFontHash(fontName_), h);
+    h = hashValue(fontSize_, h);
+    return hashValue(getTextColor(), h);
+}
@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <optional>
 #include <SFML/Graphics.hpp>
@@ -51,7 +52,10 @@ public:
     //-------------------------------------------------------------------------
 
     // Draws bubble shape (or image) and centered text
-    void draw(sf::RenderWindow& window) override;
+    // Copy with a new id (copy/paste, duplicate); font and image stay shared
+    std::unique_ptr<SpeechBubble> clone(const std::string& id) const;
+
+    void draw(sf::RenderTarget& target) override;
 
     //-------------------------------------------------------------------------
     // HIT DETECTION
@@ -60,6 +64,9 @@ public:
     // Simple AABB hit test (returns true if mouse is inside bubble bounds)
     bool isClicked(float mouseX, float mouseY) const override;
 
+    // Object, text strings and an estimate of the shape/text geometry
+    std::size_t memoryBytes() const override;
+
     //-------------------------------------------------------------------------
     // GEOMETRY OVERRIDES - Update text positioning when bubble moves/resizes
     //-------------------------------------------------------------------------
@@ -95,6 +102,24 @@ public:
     // Will attempt to load image asset first, falls back to procedural
     void setStyle(const std::string& style);
 
+    //-------------------------------------------------------------------------
+    // RENDER DATA - Read by offscreen renderers (software rasterizer, export)
+    //-------------------------------------------------------------------------
+
+    const sf::ConvexShape& getShape() const;       // Procedural shape (local points)
+    bool usesImageBubble() const;                  // True if drawn from an image asset
+    const std::string& getBubbleImageKey() const;  // Asset key of that image
+    const std::string& getWrappedText() const;     // Text after word wrapping
+    const std::string& getFontName() const;
+    const std::string& getStyle() const;
+    sf::Color getTextColor() const;
+
+    // World position the text bounds are centered on (see centerText())
+    sf::Vector2f getTextCenter() const;
+
+protected:
+    std::uint64_t computeContentHash() const override;
+
 private:
     //-------------------------------------------------------------------------
     // INTERNAL SHAPE BUILDERS - Modify to change bubble geometry
@@ -134,6 +159,10 @@ private:
     // Wrap text to fit 80% of bubble width
     void wrapText();
 
+    // Local bounds of a string in the current font/size.
+    // Uses sf::Text normally and the CPU GlyphCache in headless mode.
+    sf::FloatRect measureText(const std::string& text);
+
     //-------------------------------------------------------------------------
     // IMAGE LOADING - For image-based bubbles
     //-------------------------------------------------------------------------
@@ -148,6 +177,7 @@ private:
     sf::ConvexShape m_shape;              // Procedural bubble shape
     sf::Text m_text;                      // Text object for display
     std::string text_;                    // Current text content
+    std::string wrappedText_;             // text_ with wrap newlines inserted
     int fontSize_ = 24;                   // Current font size
     std::string fontName_ = "actionman";  // Current font asset name
     std::string style_ = "speech";        // Current bubble style
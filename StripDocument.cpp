@@ -0,0 +1,269 @@
+//=============================================================================
+// StripDocument.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of multi-panel strips (see StripDocument.h).
+//=============================================================================
+
+#include "StripDocument.h"
+#include "ContentHash.h"
+#include "Exporter.h"
+#include "FrameWatchdog.h"
+#include "Logger.h"
+#include "SceneHash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    // Panel projects are stored relative to the strip file
+    std::string resolve(const std::string &stripPath, const std::string &panelPath)
+    {
+        fs::path p(panelPath);
+        return p.is_absolute() ? panelPath : (fs::path(stripPath).parent_path() / p).string();
+    }
+}
+
+StripDocument::StripDocument(const StripLayout &layout) : m_layout(layout) {}
+
+StripDocument StripDocument::create(const std::string &path, const StripLayout &layout,
+                                    sf::Vector2f canvasOrigin)
+{
+    StripDocument doc(layout);
+    const std::string stem = fs::path(path).stem().string();
+    doc.m_panels.resize(static_cast<std::size_t>(layout.columns) * layout.rows);
+    for (std::size_t i = 0; i < doc.m_panels.size(); ++i)
+    {
+        doc.m_panels[i].projectPath = stem + "_panel" + std::to_string(i + 1) + ".comic";
+        doc.m_panels[i].canvas.origin = canvasOrigin;
+        doc.m_panels[i].canvas.size = layout.panelSize;
+    }
+    return doc;
+}
+
+StripDocument StripDocument::load(const std::string &path)
+{
+    std::ifstream in(path);
+    if (!in)
+        throw std::runtime_error("Strip open failed: " + path);
+
+    std::string magic;
+    int version = 0;
+    if (!(in >> magic >> version) || magic != "STRIP" || version != 1)
+        throw std::runtime_error("Not a strip file: " + path);
+
+    StripLayout layout;
+    std::vector<std::string> panelPaths;
+    std::string record;
+    while (in >> record)
+    {
+        if (record == "LAYOUT")
+        {
+            if (!(in >> layout.columns >> layout.rows >> layout.panelSize.x >> layout.panelSize.y >>
+                  layout.gutter >> layout.margin))
+                throw std::runtime_error("Strip parse error: LAYOUT");
+        }
+        else if (record == "BACKGROUND")
+        {
+            int r, g, b, a;
+            if (!(in >> r >> g >> b >> a))
+                throw std::runtime_error("Strip parse error: BACKGROUND");
+            layout.background = sf::Color(static_cast<std::uint8_t>(r), static_cast<std::uint8_t>(g),
+                                          static_cast<std::uint8_t>(b), static_cast<std::uint8_t>(a));
+        }
+        else if (record == "PANEL")
+        {
+            std::string panel;
+            if (!(in >> std::quoted(panel)))
+                throw std::runtime_error("Strip parse error: PANEL");
+            panelPaths.push_back(panel);
+        }
+        else
+        {
+            throw std::runtime_error("Strip parse error: unknown record " + record);
+        }
+    }
+
+    if (layout.columns == 0 || layout.rows == 0 || panelPaths.size() > layout.columns * layout.rows)
+        throw std::runtime_error("Strip layout does not fit its panels: " + path);
+
+    StripDocument doc(layout);
+    doc.m_panels.resize(panelPaths.size());
+    for (std::size_t i = 0; i < panelPaths.size(); ++i)
+    {
+        Panel &panel = doc.m_panels[i];
+        panel.projectPath = panelPaths[i];
+        panel.canvas = loadProject(resolve(path, panel.projectPath), panel.scene);
+    }
+    return doc;
+}
+
+void StripDocument::save(const std::string &path) const
+{
+    for (const auto &panel : m_panels)
+        saveProject(resolve(path, panel.projectPath), panel.scene, panel.canvas);
+
+    std::ofstream out(path);
+    if (!out)
+        throw std::runtime_error("Strip write failed: " + path);
+
+    const sf::Color &bg = m_layout.background;
+    out << "STRIP 1\n"
+        << "LAYOUT " << m_layout.columns << " " << m_layout.rows << " " << m_layout.panelSize.x << " "
+        << m_layout.panelSize.y << " " << m_layout.gutter << " " << m_layout.margin << "\n"
+        << "BACKGROUND " << int(bg.r) << " " << int(bg.g) << " " << int(bg.b) << " " << int(bg.a) << "\n";
+    for (const auto &panel : m_panels)
+        out << "PANEL " << std::quoted(panel.projectPath) << "\n";
+    if (!out)
+        throw std::runtime_error("Strip write failed: " + path);
+}
+
+const StripLayout &StripDocument::getLayout() const { return m_layout; }
+
+std::size_t StripDocument::getPanelCount() const { return m_panels.size(); }
+
+std::size_t StripDocument::cacheBytes() const
+{
+    std::size_t bytes = 0;
+    for (const auto &panel : m_panels)
+        bytes += static_cast<std::size_t>(panel.render.getSize().x) * panel.render.getSize().y * 4;
+    return bytes;
+}
+
+Scene &StripDocument::getPanel(std::size_t index) { return m_panels.at(index).scene; }
+
+const Scene &StripDocument::getPanel(std::size_t index) const { return m_panels.at(index).scene; }
+
+const ProjectCanvas &StripDocument::getPanelCanvas(std::size_t index) const { return m_panels.at(index).canvas; }
+
+void StripDocument::setPanelCanvas(std::size_t index, const ProjectCanvas &canvas)
+{
+    m_panels.at(index).canvas = canvas;
+}
+
+sf::Vector2u StripDocument::getStripSize() const
+{
+    const StripLayout &l = m_layout;
+    return {2 * l.margin + l.columns * l.panelSize.x + (l.columns - 1) * l.gutter,
+            2 * l.margin + l.rows * l.panelSize.y + (l.rows - 1) * l.gutter};
+}
+
+sf::Vector2u StripDocument::getPanelOffset(std::size_t index) const
+{
+    const StripLayout &l = m_layout;
+    const unsigned column = static_cast<unsigned>(index % l.columns);
+    const unsigned row = static_cast<unsigned>(index / l.columns);
+    return {l.margin + column * (l.panelSize.x + l.gutter), l.margin + row * (l.panelSize.y + l.gutter)};
+}
+
+ProjectCanvas StripDocument::panelCanvas(const Panel &panel) const
+{
+    // Center the project's canvas in the cell (crop or pad, no scaling)
+    ProjectCanvas cell;
+    cell.size = m_layout.panelSize;
+    cell.origin = panel.canvas.origin;
+    if (panel.canvas.size.x > 0 && panel.canvas.size.y > 0)
+    {
+        cell.origin.x -= (static_cast<float>(cell.size.x) - static_cast<float>(panel.canvas.size.x)) / 2.f;
+        cell.origin.y -= (static_cast<float>(cell.size.y) - static_cast<float>(panel.canvas.size.y)) / 2.f;
+    }
+    return cell;
+}
+
+std::uint64_t StripDocument::panelKey(const Panel &panel, const Exporter &exporter) const
+{
+    // Fresh fold of the per-object hashes (cheap: objects cache their own)
+    return exporter.renderKey(SceneHasher().hash(panel.scene), panelCanvas(panel), nullptr);
+}
+
+std::size_t StripDocument::updateRenders(const Exporter &exporter)
+{
+    std::size_t rendered = 0;
+    for (auto &panel : m_panels)
+    {
+        const std::uint64_t key = panelKey(panel, exporter);
+        if (key == panel.renderKey && panel.render.getSize() == m_layout.panelSize)
+            continue;
+
+        if (!exporter.render(panel.scene, panelCanvas(panel), nullptr, panel.render))
+            throw std::runtime_error("Panel render failed: " + panel.projectPath);
+        panel.renderKey = key;
+        ++rendered;
+    }
+    return rendered;
+}
+
+bool StripDocument::exportStrip(const Exporter &exporter, const std::string &path)
+{
+    TimedScope timed("export/strip");
+    const std::string ext = fs::path(path).extension().string();
+    if (exporter.isVectorOutput() || ext == ".svg" || ext == ".SVG")
+    {
+        LOG_ERROR("Strip") << "SVG export of strips is not supported";
+        return false;
+    }
+
+    const sf::Vector2u size = getStripSize();
+    ProjectCanvas stripCanvas;
+    stripCanvas.size = size;
+
+    // Whole-strip cache key: layout + every panel's render key
+    std::uint64_t stripHash = hashValue(m_layout.columns);
+    stripHash = hashValue(m_layout.rows, stripHash);
+    stripHash = hashValue(m_layout.panelSize, stripHash);
+    stripHash = hashValue(m_layout.gutter, stripHash);
+    stripHash = hashValue(m_layout.margin, stripHash);
+    stripHash = hashValue(m_layout.background, stripHash);
+    for (const auto &panel : m_panels)
+        stripHash = hashValue(panelKey(panel, exporter), stripHash);
+
+    ExportCache *cache = exporter.getCache();
+    const std::uint64_t key = cache && path != "-" ? exporter.cacheKey(stripHash, stripCanvas, nullptr, path) : 0;
+    if (key != 0 && cache->fetch(key, path))
+    {
+        LOG_INFO("Strip") << "Unchanged strip, served from cache (" << toHex(key) << ")";
+        return true;
+    }
+
+    std::size_t rendered = updateRenders(exporter);
+    LOG_INFO("Strip") << "Re-rendered " << rendered << " of " << m_panels.size() << " panels";
+
+    // Single pass over the strip rows: background, then the panel spans
+    const std::size_t stride = static_cast<std::size_t>(size.x) * 4;
+    const std::size_t panelStride = static_cast<std::size_t>(m_layout.panelSize.x) * 4;
+    const std::uint8_t bg[4] = {m_layout.background.r, m_layout.background.g,
+                                m_layout.background.b, m_layout.background.a};
+    std::vector<std::uint8_t> bgRow(stride);
+    for (std::size_t i = 0; i < stride; i += 4)
+        std::memcpy(bgRow.data() + i, bg, 4);
+
+    std::vector<std::uint8_t> strip(stride * size.y);
+    for (unsigned y = 0; y < size.y; ++y)
+    {
+        std::uint8_t *row = strip.data() + y * stride;
+        std::memcpy(row, bgRow.data(), stride);
+
+        for (std::size_t i = 0; i < m_panels.size(); ++i)
+        {
+            const sf::Vector2u offset = getPanelOffset(i);
+            if (y < offset.y || y >= offset.y + m_layout.panelSize.y)
+                continue;
+            const std::uint8_t *src = m_panels[i].render.getPixelsPtr() + (y - offset.y) * panelStride;
+            std::memcpy(row + static_cast<std::size_t>(offset.x) * 4, src, panelStride);
+        }
+    }
+
+    if (!exporter.save(strip.data(), size, path))
+        return false;
+    if (key != 0)
+        cache->store(key, path);
+    return true;
+}
@@ -0,0 +1,103 @@
+//=============================================================================
+// StripDocument.h
+//=============================================================================
+// PURPOSE:
+//   A comic strip: N panels laid out on a grid with gutters. Every panel is
+//   its own Scene (stored as its own *.comic project) and keeps its own
+//   cached render, so editing one panel only re-renders that panel.
+//
+// FILE FORMAT (*.strip, strings use std::quoted):
+//   STRIP 1
+//   LAYOUT <columns> <rows> <panelWidth> <panelHeight> <gutter> <margin>
+//   BACKGROUND <r> <g> <b> <a>
+//   PANEL <project path, relative to the strip file>      (row-major)
+//
+// RENDERING:
+//   Panels are rendered through the Exporter (same backend, supersampling
+//   and encoder settings as single-panel exports) without scaling: each
+//   project's CANVAS is centered in its cell, cropped or padded.
+//   The render of a panel is reused while its scene hash (SceneHash.h) and
+//   the export settings are unchanged.
+//   exportStrip() composites in one pass, row by row, straight from the
+//   panel caches into the strip image, then encodes it once.
+//
+// WHERE TO MODIFY:
+//   - Layout rules: Modify StripDocument::getPanelOffset()
+//   - Panel fitting (e.g. scale to fit): Modify StripDocument::panelCanvas()
+//=============================================================================
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ProjectFile.h"
+#include "Scene.h"
+
+class Exporter;
+
+struct StripLayout {
+    unsigned columns{3};
+    unsigned rows{1};
+    sf::Vector2u panelSize{800, 600};         // Cell size in pixels
+    unsigned gutter{20};                      // Space between cells
+    unsigned margin{20};                      // Space around the grid
+    sf::Color background{sf::Color::White};   // Gutters and margins
+};
+
+class StripDocument {
+public:
+    explicit StripDocument(const StripLayout& layout = StripLayout());
+
+    // Empty panels named <stem>_panel<N>.comic next to the strip file, each
+    // with a cell-sized canvas starting at `canvasOrigin` (world coordinates)
+    static StripDocument create(const std::string& path, const StripLayout& layout,
+                                sf::Vector2f canvasOrigin = {0.f, 0.f});
+
+    // Read a *.strip file and every panel project it lists.
+    // Throws runtime_error on I/O or format errors.
+    static StripDocument load(const std::string& path);
+
+    // Write the strip file and every panel project. Throws runtime_error.
+    void save(const std::string& path) const;
+
+    const StripLayout& getLayout() const;
+    std::size_t getPanelCount() const;
+
+    // Bytes of the cached panel renders (see MemoryStats.h)
+    std::size_t cacheBytes() const;
+    Scene& getPanel(std::size_t index);
+    const Scene& getPanel(std::size_t index) const;
+    const ProjectCanvas& getPanelCanvas(std::size_t index) const;
+    void setPanelCanvas(std::size_t index, const ProjectCanvas& canvas);
+
+    sf::Vector2u getStripSize() const;
+    sf::Vector2u getPanelOffset(std::size_t index) const;  // Cell position in the strip
+
+    // Render every panel whose scene or settings changed since its last
+    // render. Returns how many panels were re-rendered.
+    std::size_t updateRenders(const Exporter& exporter);
+
+    // updateRenders() + composite + encode to `path` (raster formats only).
+    // Consults the exporter's ExportCache with a key built from the panel
+    // hashes. Returns false on failure.
+    bool exportStrip(const Exporter& exporter, const std::string& path);
+
+private:
+    struct Panel {
+        std::string projectPath;              // As written in the strip file
+        Scene scene;
+        ProjectCanvas canvas;
+        sf::Image render;                     // Cached panel image (cell size)
+        std::uint64_t renderKey{0};           // Scene + settings hash of `render`
+    };
+
+    ProjectCanvas panelCanvas(const Panel& panel) const;
+    std::uint64_t panelKey(const Panel& panel, const Exporter& exporter) const;
+
+    StripLayout m_layout;
+    std::vector<Panel> m_panels;
+};
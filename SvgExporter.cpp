@@ -0,0 +1,277 @@
+//=============================================================================
+// SvgExporter.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the SVG writer (see SvgExporter.h).
+//=============================================================================
+
+#include "SvgExporter.h"
+#include "AssetManager.h"
+#include "Base64.h"
+#include "GlyphCache.h"
+#include "Scene.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    // Escape for XML; bytes are Latin-1 (as sf::String reads std::string)
+    // and are re-encoded as UTF-8
+    std::string escapeXml(const std::string &text)
+    {
+        std::string out;
+        out.reserve(text.size());
+        for (char c : text)
+        {
+            unsigned char u = static_cast<unsigned char>(c);
+            if (u >= 0x80)
+            {
+                out += static_cast<char>(0xC0 | (u >> 6));
+                out += static_cast<char>(0x80 | (u & 0x3F));
+                continue;
+            }
+            switch (c)
+            {
+            case '&': out += "&amp;"; break;
+            case '<': out += "&lt;"; break;
+            case '>': out += "&gt;"; break;
+            case '"': out += "&quot;"; break;
+            case '\'': out += "&apos;"; break;
+            default: out += c; break;
+            }
+        }
+        return out;
+    }
+
+    std::string rgb(sf::Color c)
+    {
+        std::ostringstream ss;
+        ss << "rgb(" << int(c.r) << "," << int(c.g) << "," << int(c.b) << ")";
+        return ss.str();
+    }
+
+    // Fill/stroke opacity attribute (omitted when opaque)
+    std::string opacity(const char *attribute, sf::Color c)
+    {
+        if (c.a == 255)
+            return "";
+        std::ostringstream ss;
+        ss << " " << attribute << "=\"" << static_cast<float>(c.a) / 255.f << "\"";
+        return ss.str();
+    }
+
+    class SvgWriter
+    {
+    public:
+        SvgWriter(std::ostream &out, const SvgOptions &options, const fs::path &svgDir)
+            : m_out(out), m_options(options), m_svgDir(svgDir) {}
+
+        // Paint layer tiles are always embedded (they have no file)
+        void paintTile(PaintLayer::TileKey key, const PaintLayer::Tile &tile)
+        {
+            m_out << "<image x=\"" << key.x * PaintLayer::TileSize << "\" y=\"" << key.y * PaintLayer::TileSize
+                  << "\" width=\"" << PaintLayer::TileSize << "\" height=\"" << PaintLayer::TileSize
+                  << "\" style=\"image-rendering:pixelated\" href=\"data:image/png;base64,"
+                  << base64Encode(PaintLayer::encodeTile(tile)) << "\"/>\n";
+        }
+
+        void stroke(const BrushStroke &s)
+        {
+            const auto points = s.getWorldPoints();
+            if (points.empty())
+                return;
+
+            m_out << "<path d=\"M";
+            for (std::size_t i = 0; i < points.size(); ++i)
+                m_out << (i ? " L" : "") << points[i].x << " " << points[i].y;
+            if (points.size() == 1) // Zero-length segment draws a round dot
+                m_out << " L" << points[0].x << " " << points[0].y;
+
+            m_out << "\" fill=\"none\" stroke=\"" << rgb(s.getColor()) << "\""
+                  << opacity("stroke-opacity", s.getColor())
+                  << " stroke-width=\"" << std::max(s.getThickness(), 1.f)
+                  << "\" stroke-linecap=\"round\" stroke-linejoin=\"round\"/>\n";
+        }
+
+        // Same placement as the sprite: scale to size, flip around the
+        // left edge, then rotate about the position
+        void image(const std::string &assetKey, sf::Vector2f pos, sf::Vector2f size, float rotation, bool flipped)
+        {
+            std::string href = imageHref(assetKey);
+            if (href.empty())
+                return;
+
+            m_out << "<image x=\"0\" y=\"0\" width=\"" << size.x << "\" height=\"" << size.y
+                  << "\" preserveAspectRatio=\"none\" transform=\"translate(" << pos.x << " " << pos.y << ")";
+            if (rotation != 0.f)
+                m_out << " rotate(" << rotation << ")";
+            if (flipped)
+                m_out << " translate(" << size.x << " 0) scale(-1 1)";
+            m_out << "\" href=\"" << href << "\"/>\n";
+        }
+
+        void bubble(const SpeechBubble &b)
+        {
+            if (b.usesImageBubble())
+            {
+                image(b.getBubbleImageKey(), b.getPosition(), b.getSize(), 0.f, b.isFlipped());
+            }
+            else
+            {
+                sf::ConvexShape shape = b.getShape();
+                if (b.isFlipped())
+                {
+                    shape.setScale({-1.f, 1.f});
+                    shape.setOrigin({b.getSize().x, 0.f});
+                }
+                const sf::Transform &xf = shape.getTransform();
+
+                m_out << "<polygon points=\"";
+                for (std::size_t i = 0; i < shape.getPointCount(); ++i)
+                {
+                    sf::Vector2f p = xf.transformPoint(shape.getPoint(i));
+                    m_out << (i ? " " : "") << p.x << "," << p.y;
+                }
+                m_out << "\" fill=\"" << rgb(shape.getFillColor()) << "\"" << opacity("fill-opacity", shape.getFillColor());
+                if (shape.getOutlineThickness() > 0.f)
+                {
+                    m_out << " stroke=\"" << rgb(shape.getOutlineColor()) << "\""
+                          << opacity("stroke-opacity", shape.getOutlineColor())
+                          << " stroke-width=\"" << shape.getOutlineThickness() * 2.f
+                          << "\" stroke-linejoin=\"miter\" paint-order=\"stroke\"";
+                }
+                m_out << "/>\n";
+            }
+            text(b);
+        }
+
+        // sf::Text lays lines out left-aligned; the block is centered on
+        // getTextCenter() using its local bounds (see SpeechBubble::centerText)
+        void text(const SpeechBubble &b)
+        {
+            const std::string &text = b.getWrappedText();
+            if (text.empty())
+                return;
+
+            auto &GC = GlyphCache::getInstance();
+            const std::string fontPath = AssetManager::getInstance().getFontPath(b.getFontName());
+            const unsigned size = static_cast<unsigned>(b.getFontSize());
+            TextLayout layout = GC.layoutText(fontPath, size, text);
+            float lineSpacing = GC.getLineSpacing(fontPath, size);
+
+            sf::Vector2f anchor = b.getTextCenter();
+            float left = anchor.x - (layout.bounds.position.x + layout.bounds.size.x / 2.f);
+            float top = anchor.y - (layout.bounds.position.y + layout.bounds.size.y / 2.f);
+
+            m_fonts.insert(b.getFontName());
+            m_out << "<text font-family=\"" << escapeXml(b.getFontName()) << "\" font-size=\"" << size
+                  << "\" fill=\"" << rgb(b.getTextColor()) << "\"" << opacity("fill-opacity", b.getTextColor())
+                  << " xml:space=\"preserve\">";
+
+            std::istringstream lines(text);
+            std::string line;
+            for (int i = 0; std::getline(lines, line); ++i)
+            {
+                // First baseline sits at characterSize below the text origin
+                m_out << "<tspan x=\"" << left << "\" y=\""
+                      << top + static_cast<float>(size) + static_cast<float>(i) * lineSpacing << "\">"
+                      << escapeXml(line) << "</tspan>";
+            }
+            m_out << "</text>\n";
+        }
+
+        const std::set<std::string> &fontsUsed() const { return m_fonts; }
+
+    private:
+        std::string imageHref(const std::string &assetKey)
+        {
+            std::string path = AssetManager::getInstance().getTexturePath(assetKey);
+            if (path.empty())
+                return "";
+
+            if (m_options.embedImages)
+            {
+                std::ifstream in(path, std::ios::binary);
+                std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+                std::string ext = fs::path(path).extension().string();
+                std::string mime = (ext == ".jpg" || ext == ".jpeg" || ext == ".JPG") ? "image/jpeg" : "image/png";
+                return "data:" + mime + ";base64," + base64Encode(bytes);
+            }
+
+            std::error_code ec;
+            fs::path rel = fs::relative(fs::absolute(path), m_svgDir, ec);
+            return escapeXml(ec || rel.empty() ? fs::absolute(path).generic_string() : rel.generic_string());
+        }
+
+        std::ostream &m_out;
+        const SvgOptions &m_options;
+        fs::path m_svgDir;
+        std::set<std::string> m_fonts;
+    };
+}
+
+SvgExporter::SvgExporter(const SvgOptions &options) : m_options(options) {}
+
+bool SvgExporter::write(const Scene &scene, const ProjectCanvas &canvas, const std::string &path) const
+{
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+        return false;
+
+    fs::path svgDir = fs::absolute(path).parent_path();
+
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" width=\"" << canvas.size.x
+        << "\" height=\"" << canvas.size.y << "\" viewBox=\"" << canvas.origin.x << " " << canvas.origin.y
+        << " " << canvas.size.x << " " << canvas.size.y << "\">\n";
+    out << "<rect x=\"" << canvas.origin.x << "\" y=\"" << canvas.origin.y << "\" width=\"" << canvas.size.x
+        << "\" height=\"" << canvas.size.y << "\" fill=\"white\"/>\n";
+
+    // Same draw order as the editor: paint, strokes, characters, bubbles,
+    // groups (members placed in the world)
+    SvgWriter writer(out, m_options, svgDir);
+    if (scene.paint)
+        for (const auto &[key, tile] : scene.paint->tiles())
+            writer.paintTile(key, *tile);
+    for (const auto &s : scene.strokes)
+        writer.stroke(*s);
+    for (const auto &c : scene.characters)
+        writer.image(c->getImagePath(), c->getPosition(), c->getSize(), c->getRotation(), c->isFlipped());
+    for (const auto &b : scene.bubbles)
+        writer.bubble(*b);
+    for (const auto &g : scene.groups)
+    {
+        const Scene members = g->worldMembers();
+        for (const auto &s : members.strokes)
+            writer.stroke(*s);
+        for (const auto &c : members.characters)
+            writer.image(c->getImagePath(), c->getPosition(), c->getSize(), c->getRotation(), c->isFlipped());
+        for (const auto &b : members.bubbles)
+            writer.bubble(*b);
+    }
+
+    // Font files (may appear after use; CSS applies to the whole document)
+    auto &AM = AssetManager::getInstance();
+    if (!writer.fontsUsed().empty())
+    {
+        out << "<style>\n";
+        for (const auto &font : writer.fontsUsed())
+        {
+            std::error_code ec;
+            fs::path rel = fs::relative(fs::absolute(AM.getFontPath(font)), svgDir, ec);
+            out << "@font-face { font-family: \"" << escapeXml(font) << "\"; src: url(\""
+                << escapeXml(ec ? AM.getFontPath(font) : rel.generic_string()) << "\"); }\n";
+        }
+        out << "</style>\n";
+    }
+
+    out << "</svg>\n";
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,51 @@
+//=============================================================================
+// SvgExporter.h
+//=============================================================================
+// PURPOSE:
+//   Resolution-independent export: writes the Scene as SVG, streaming one
+//   element per object straight to the file (no rasterization, so export
+//   time depends on the object count, not the pixel count).
+//
+// MAPPING:
+//   PaintLayer   -> one <image> per tile, PNG embedded as a data URI (the
+//                   only raster part of the file)
+//   BrushStroke  -> <path> through the stored points, round caps/joins,
+//                   stroke-width = thickness (same coverage as the dots)
+//   Character    -> <image> referencing the asset file (or embedded as a
+//                   base64 data URI), positioned/rotated/flipped like the
+//                   sprite
+//   SpeechBubble -> <polygon> (procedural) or <image> (image bubbles), plus
+//                   <text> with one <tspan> per wrapped line, laid out like
+//                   sf::Text (left-aligned lines, block centered)
+//
+// NOTES:
+//   - SFML outlines grow outwards; emulated with a doubled stroke width and
+//     paint-order="stroke" so the fill covers the inner half.
+//   - Fonts are referenced with @font-face rules pointing at the asset files.
+//
+// WHERE TO MODIFY:
+//   - New object kinds: Add a write*() function in SvgExporter.cpp
+//=============================================================================
+
+#pragma once
+
+#include <string>
+
+#include "ProjectFile.h"
+
+struct Scene;
+
+struct SvgOptions {
+    bool embedImages{false};          // Inline PNGs as data URIs instead of file links
+};
+
+class SvgExporter {
+public:
+    explicit SvgExporter(const SvgOptions& options = SvgOptions());
+
+    // Write the canvas region of `scene` to `path`. Returns false on I/O errors.
+    bool write(const Scene& scene, const ProjectCanvas& canvas, const std::string& path) const;
+
+private:
+    SvgOptions m_options;
+};
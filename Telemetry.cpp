@@ -0,0 +1,194 @@
+//=============================================================================
+// Telemetry.cpp
+//=============================================================================
+// PURPOSE:
+//   Implementation of the session histograms, counters and the JSON file
+//   (see Telemetry.h).
+//=============================================================================
+
+#include "Telemetry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    const char *const MetricNames[] = {"input_to_render", "frame_draw", "wrap_text", "export"};
+    const char *const CounterNames[] = {"frames",  "input_events",  "commands_executed", "undos",
+                                        "redos",   "exports",       "project_saves",     "project_loads"};
+
+    static_assert(std::size(MetricNames) == static_cast<std::size_t>(Metric::Count_));
+    static_assert(std::size(CounterNames) == static_cast<std::size_t>(Counter::Count_));
+
+    constexpr std::uint64_t HalfSubBucket = Histogram::SubBucketCount / 2;
+}
+
+//-----------------------------------------------------------------------------
+// Histogram
+//-----------------------------------------------------------------------------
+
+std::size_t Histogram::bucketIndex(std::uint64_t us)
+{
+    if (us < SubBucketCount)
+        return static_cast<std::size_t>(us);
+    if (us >> MaxBits)
+        return BucketCount - 1;
+
+    unsigned msb = SubBucketBits;
+    while (us >> (msb + 1))
+        ++msb;
+    // Keep the top SubBucketBits bits: [16, 32) << shift
+    const unsigned shift = msb - (SubBucketBits - 1);
+    const std::uint64_t top = us >> shift;
+    return static_cast<std::size_t>(SubBucketCount + (shift - 1) * HalfSubBucket + (top - HalfSubBucket));
+}
+
+std::uint64_t Histogram::bucketLow(std::size_t index)
+{
+    if (index < SubBucketCount)
+        return index;
+    const std::uint64_t k = index - SubBucketCount;
+    const unsigned shift = static_cast<unsigned>(k / HalfSubBucket) + 1;
+    return (HalfSubBucket + k % HalfSubBucket) << shift;
+}
+
+std::uint64_t Histogram::bucketHigh(std::size_t index)
+{
+    if (index == BucketCount - 1)
+        return UINT64_MAX;
+    return bucketLow(index + 1) - 1;
+}
+
+void Histogram::record(std::uint64_t us)
+{
+    m_buckets[bucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(us, std::memory_order_relaxed);
+    std::uint64_t seen = m_max.load(std::memory_order_relaxed);
+    while (us > seen && !m_max.compare_exchange_weak(seen, us, std::memory_order_relaxed))
+    {
+    }
+}
+
+std::uint64_t Histogram::valueAt(double quantile) const
+{
+    const std::uint64_t total = count();
+    if (total == 0)
+        return 0;
+    const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(quantile * total)));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < BucketCount; ++i)
+    {
+        seen += bucketCount(i);
+        if (seen >= rank)
+            return std::min(bucketHigh(i), max());
+    }
+    return max();
+}
+
+//-----------------------------------------------------------------------------
+// Telemetry
+//-----------------------------------------------------------------------------
+
+Telemetry &Telemetry::getInstance()
+{
+    static Telemetry instance;
+    return instance;
+}
+
+Telemetry::Telemetry() : m_start(std::chrono::steady_clock::now()), m_startTime(std::time(nullptr)) {}
+
+void Telemetry::setEnabled(bool enabled)
+{
+    if (enabled && !isEnabled())
+    {
+        m_start = std::chrono::steady_clock::now();
+        m_startTime = std::time(nullptr);
+    }
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Telemetry::record(Metric metric, std::chrono::steady_clock::duration elapsed)
+{
+    if (!isEnabled())
+        return;
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    m_histograms[static_cast<std::size_t>(metric)].record(us > 0 ? static_cast<std::uint64_t>(us) : 0);
+}
+
+void Telemetry::count(Counter counter, std::uint64_t n)
+{
+    if (isEnabled())
+        m_counters[static_cast<std::size_t>(counter)].fetch_add(n, std::memory_order_relaxed);
+}
+
+void Telemetry::writeJson(std::ostream &out) const
+{
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+
+    out << std::setprecision(6) << std::defaultfloat;
+    out << "{\n  \"schema\": 1,\n  \"started\": " << m_startTime << ",\n  \"duration_s\": " << seconds
+        << ",\n  \"threads\": " << std::thread::hardware_concurrency() << ",\n";
+    out << "  \"histogram_layout\": { \"unit\": \"us\", \"sub_bucket_bits\": " << Histogram::SubBucketBits
+        << ", \"max_bits\": " << Histogram::MaxBits << ", \"buckets\": " << Histogram::BucketCount << " },\n";
+
+    out << "  \"counters\": {";
+    for (std::size_t i = 0; i < m_counters.size(); ++i)
+        out << (i ? "," : "") << "\n    \"" << CounterNames[i] << "\": " << m_counters[i].load(std::memory_order_relaxed);
+    out << "\n  },\n";
+
+    // Buckets are [low_us, high_us, count]; sessions merge by adding counts
+    out << "  \"histograms\": {";
+    for (std::size_t m = 0; m < m_histograms.size(); ++m)
+    {
+        const Histogram &h = m_histograms[m];
+        const std::uint64_t n = h.count();
+        out << (m ? "," : "") << "\n    \"" << MetricNames[m] << "\": { \"count\": " << n
+            << ", \"mean_us\": " << (n ? static_cast<double>(h.sum()) / n : 0.0) << ", \"max_us\": " << h.max()
+            << ", \"p50_us\": " << h.valueAt(0.5) << ", \"p90_us\": " << h.valueAt(0.9)
+            << ", \"p99_us\": " << h.valueAt(0.99) << ", \"p999_us\": " << h.valueAt(0.999) << ",\n      \"buckets\": [";
+        bool first = true;
+        for (std::size_t i = 0; i < Histogram::BucketCount; ++i)
+        {
+            const std::uint64_t c = h.bucketCount(i);
+            if (c == 0)
+                continue;
+            out << (first ? "" : ", ") << '[' << Histogram::bucketLow(i) << ", ";
+            if (i == Histogram::BucketCount - 1)
+                out << "null";
+            else
+                out << Histogram::bucketHigh(i);
+            out << ", " << c << ']';
+            first = false;
+        }
+        out << "] }";
+    }
+    out << "\n  }\n}\n";
+}
+
+bool Telemetry::save(const std::string &path) const
+{
+    std::error_code ec;
+    const fs::path parent = fs::path(path).parent_path();
+    if (!parent.empty())
+        fs::create_directories(parent, ec);
+    std::ofstream out(path);
+    writeJson(out);
+    return static_cast<bool>(out);
+}
+
+std::string Telemetry::defaultPath()
+{
+    std::time_t t = std::time(nullptr);
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", std::localtime(&t));
+    return (fs::path("SavedComics") / "telemetry" / ("session_" + std::string(stamp) + ".json")).string();
+}
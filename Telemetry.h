@@ -0,0 +1,168 @@
+//=============================================================================
+// Telemetry.h
+//=============================================================================
+// PURPOSE:
+//   Session telemetry for fleet-wide analysis: latency histograms of the
+//   editor's hot paths and operation counts, collected during an editing
+//   session and written to a local JSON file on exit. Nothing is sent
+//   anywhere; aggregating the files is up to us.
+//
+// HISTOGRAMS:
+//   HDR-style log-linear buckets over microseconds: values below 32 us get
+//   one bucket each, above that every power of two is split into 16
+//   buckets, so a bucket is at most ~6% wide relative to its value. The
+//   layout is fixed (Histogram::BucketCount buckets up to 2^32 us, larger
+//   values land in the last bucket), so files from different sessions and
+//   machines merge by adding counts per bucket.
+//
+// OVERHEAD:
+//   Recording is a few relaxed atomic increments into fixed arrays; it
+//   never locks or allocates and is safe from any thread (wrapText and
+//   exports also run on worker threads). While telemetry is disabled a
+//   timer costs one relaxed atomic load.
+//
+// METRICS:
+//   input_to_render  first input event of a frame -> that frame displayed
+//   frame_draw       drawing one frame (clear .. before display)
+//   wrap_text        SpeechBubble::wrapText
+//   export           Exporter::exportScene (render + encode + write)
+//
+// WHERE TO MODIFY:
+//   - New latency metric: Add a Metric value and its name in Telemetry.cpp,
+//     then wrap the code in a TelemetryTimer
+//   - New operation count: Add a Counter value and its name, then call
+//     Telemetry::count()
+//   - File contents: Modify Telemetry::writeJson()
+//=============================================================================
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+enum class Metric
+{
+    InputToRender,
+    FrameDraw,
+    WrapText,
+    Export,
+    Count_
+};
+
+enum class Counter
+{
+    Frames,
+    InputEvents,
+    CommandsExecuted,
+    Undos,
+    Redos,
+    Exports,
+    ProjectSaves,
+    ProjectLoads,
+    Count_
+};
+
+// Fixed-bucket latency histogram; concurrent record() calls are fine
+class Histogram {
+public:
+    static constexpr unsigned SubBucketBits = 5;
+    static constexpr std::uint64_t SubBucketCount = 1u << SubBucketBits;   // 32
+    static constexpr unsigned MaxBits = 32;                                // 2^32 us ~ 71 min
+    static constexpr std::size_t BucketCount =
+        SubBucketCount + (MaxBits - SubBucketBits) * (SubBucketCount / 2);
+
+    void record(std::uint64_t us);
+
+    std::uint64_t count() const { return m_count.load(std::memory_order_relaxed); }
+    std::uint64_t bucketCount(std::size_t index) const { return m_buckets[index].load(std::memory_order_relaxed); }
+
+    // Value at `quantile` (0..1): upper bound of the bucket that holds it
+    std::uint64_t valueAt(double quantile) const;
+
+    std::uint64_t sum() const { return m_sum.load(std::memory_order_relaxed); }
+    std::uint64_t max() const { return m_max.load(std::memory_order_relaxed); }
+
+    static std::size_t bucketIndex(std::uint64_t us);
+    static std::uint64_t bucketLow(std::size_t index);
+    static std::uint64_t bucketHigh(std::size_t index);
+
+private:
+    std::array<std::atomic<std::uint64_t>, BucketCount> m_buckets{};
+    std::atomic<std::uint64_t> m_count{0};
+    std::atomic<std::uint64_t> m_sum{0};
+    std::atomic<std::uint64_t> m_max{0};
+};
+
+class Telemetry {
+public:
+    static Telemetry& getInstance();
+
+    // Off until an editor session turns it on; enabling starts the session
+    // clock (call before any recording thread runs)
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    void record(Metric metric, std::chrono::steady_clock::duration elapsed);
+    void count(Counter counter, std::uint64_t n = 1);
+
+    const Histogram& histogram(Metric metric) const { return m_histograms[static_cast<std::size_t>(metric)]; }
+    std::uint64_t counter(Counter counter) const
+    {
+        return m_counters[static_cast<std::size_t>(counter)].load(std::memory_order_relaxed);
+    }
+
+    // Session summary plus the non-empty buckets of every histogram
+    void writeJson(std::ostream& out) const;
+
+    // Write to `path` (directories are created); false on I/O failure
+    bool save(const std::string& path) const;
+
+    // SavedComics/telemetry/session_<time>.json
+    static std::string defaultPath();
+
+private:
+    Telemetry();
+    Telemetry(const Telemetry&) = delete;
+    Telemetry& operator=(const Telemetry&) = delete;
+
+    std::atomic<bool> m_enabled{false};
+    std::chrono::steady_clock::time_point m_start;
+    std::int64_t m_startTime;                          // Unix seconds
+    std::array<Histogram, static_cast<std::size_t>(Metric::Count_)> m_histograms;
+    std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(Counter::Count_)> m_counters{};
+};
+
+// Records the time from construction to end() / destruction into a metric
+class TelemetryTimer {
+public:
+    explicit TelemetryTimer(Metric metric) : m_metric(metric)
+    {
+        if (Telemetry::getInstance().isEnabled())
+        {
+            m_running = true;
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+    ~TelemetryTimer() { end(); }
+
+    TelemetryTimer(const TelemetryTimer&) = delete;
+    TelemetryTimer& operator=(const TelemetryTimer&) = delete;
+
+    // Stop before the end of the block (idempotent)
+    void end()
+    {
+        if (!m_running)
+            return;
+        m_running = false;
+        Telemetry::getInstance().record(m_metric, std::chrono::steady_clock::now() - m_start);
+    }
+
+private:
+    Metric m_metric;
+    bool m_running{false};
+    std::chrono::steady_clock::time_point m_start;
+};
@@ -12,16 +12,106 @@
 //   - Draw mode & Eraser tools
 //   - Undo/Redo system
 //   - Interactive palette
+//
+// COMMAND LINE:
+//   --renderer=gl       Export from the window framebuffer (default)
+//   --renderer=cpu      Export through the CPU SoftwareRenderer (no GPU needed)
+//   --renderer=compare  Export via OpenGL and log the per-pixel difference
+//                       against the CPU renderer
+//   --format F          Export format: png, png8 (indexed), qoi, jpg, raw,
+//                       svg; default: by the output extension (batch: png)
+//   --colors N          png8: palette size limit 2..256, default 256
+//   --svg-embed         SVG: embed character/bubble images instead of linking
+//   --png-level L       PNG compression 0 (store) .. 9 (smallest), default 6
+//   --quality Q         JPEG quality 1..100, default 90
+//   --supersample N     Antialiased export: render at Nx (1..4), filter down
+//   --downscale F       Supersampling filter: box (default) or lanczos
+//   --bench-downscale   Print the downscale kernel throughput (MP/s) and exit
+//   --open FILE         Open a saved *.comic project on startup
+//   --open FILE --export OUT
+//                       Headless: render FILE with the CPU renderer, write
+//                       OUT ("-" = stdout, e.g. --format raw | tool), exit
+//   --strip FILE [--grid CxR]
+//                       Edit a multi-panel strip (see StripDocument.h); a new
+//                       strip with a CxR grid (default 3x1) is created if FILE
+//                       does not exist. With --export OUT: headless strip export
+//   --batch MANIFEST [--jobs N] [--out DIR] [--force]
+//                       Headless: render every project listed in MANIFEST
+//                       with N worker processes (see BatchRenderer.h).
+//                       Only new/changed pages are rendered unless --force.
+//   --generate N [--seed S]
+//                       Start from a synthetic scene of N objects (see
+//                       SceneGenerator.h); with --export OUT it is rendered
+//                       headlessly instead of an --open project
+//   --record FILE       Record the editing session's input to FILE
+//   --replay FILE [--fast] [--replay-report OUT]
+//                       Replay a recording (same --open/--generate/--strip
+//                       arguments as when it was recorded) and report
+//                       per-event and frame times; --fast skips the recorded
+//                       pauses and the frame limit. See InputRecorder.h
+//   --golden DIR [--update-golden [--golden-record-times]]
+//                       Headless render regression check against the golden
+//                       images in DIR (see GoldenSuite.h); exit code 1 on a
+//                       visual or (if times were recorded) render-time
+//                       regression
+//   --stall-ms MS       Frame stall watchdog threshold (default 250, 0 = off):
+//                       a frame taking longer dumps the operation in progress
+//                       and recent timings to SavedComics/stalls/ (see
+//                       FrameWatchdog.h)
+//   --log-level L       trace, debug (default), info, warn or error; levels
+//                       below COMIC_LOG_LEVEL are compiled out (Logger.h)
+//   --latency [--latency-report OUT]
+//                       Measure input-to-photon latency of drawing: pointer
+//                       event -> its stroke vertices presented; logged on
+//                       exit, OUT gets benchmark JSON (see LatencyProbe.h)
+//   --telemetry FILE    Write the session's latency histograms and operation
+//                       counts to FILE on exit (default SavedComics/telemetry/
+//                       session_<time>.json, see Telemetry.h)
+//   --no-telemetry      Do not collect or write session telemetry
+//   --no-cache          Always render; skip the export cache (ExportCache.h)
+//
+// SHORTCUTS:
+//   Ctrl+Z / Ctrl+Y     Undo / Redo
+//   Ctrl+S              Save the scene as SavedComics/Comic_<time>.comic
+//   F2                  Cycle export supersampling 1x / 2x / 4x
+//   PageUp / PageDown   Strip mode: edit the previous / next panel
+//   F3                  Toggle the stats overlay (frame time, memory per
+//                       subsystem; see MemoryStats.h)
+//   F4                  Log the memory report
+//   F6                  Toggle the raster brush: draw mode paints into the
+//                       tiled paint layer instead of adding vector strokes
+//                       (see PaintLayer.h)
+//   Drag on empty canvas
+//                       Select every object the rectangle touches (with
+//                       Shift: lasso, objects whose center is inside); drag
+//                       the selection or its handles to move / resize /
+//                       flip it as one undo step (see Selection.h)
+//   Ctrl+C / Ctrl+V     Copy the selected object(s) / paste (offset a bit
+//                       further with every paste)
+//   Ctrl+D              Duplicate the selected object(s). Stroke copies share
+//                       their points (BrushStroke.h), so this is O(1)
+//   F7                  Toggle the fill tool: a canvas click bucket-fills the
+//                       region under it into the paint layer (FloodFill.h)
+//   Ctrl+G              Group the selected objects; the group moves, resizes
+//                       and flips as one object and is drawn from a cached
+//                       texture (see ObjectGroup.h)
+//   Ctrl+Shift+G        Ungroup the selected group(s)
+//   Delete              Delete the picked character / bubble, or the
+//                       selected group(s) with their members
 //=============================================================================
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Window.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 #include <ctime>
@@ -33,6 +123,24 @@
 #include "Character.h"
 #include "BrushStroke.h"
 #include "Command.h"
+#include "ContentHash.h"
+#include "Scene.h"
+#include "Exporter.h"
+#include "FloodFill.h"
+#include "ProjectFile.h"
+#include "BatchRenderer.h"
+#include "SceneGenerator.h"
+#include "SceneHash.h"
+#include "Selection.h"
+#include "StripDocument.h"
+#include "InputRecorder.h"
+#include "LatencyProbe.h"
+#include "GoldenSuite.h"
+#include "FrameWatchdog.h"
+#include "Logger.h"
+#include "MemoryStats.h"
+#include "Telemetry.h"
+#include "SoftwareRenderer.h"
 
 // ----------------------------------------------------------------------------
 // Enums and Structures
@@ -62,7 +170,8 @@ enum class PickKind
 {
     None,
     Sprite,
-    Bubble
+    Bubble,
+    Stroke
 };
 
 // ----------------------------------------------------------------------------
@@ -96,25 +205,251 @@ static sf::Color hsvToRgb(float h, float s, float v)
         static_cast<std::uint8_t>(b * 255.f));
 }
 
+// Keyboard, mouse and text events; input_to_render is measured from these
+static bool isUserInput(const sf::Event &evt)
+{
+    return evt.is<sf::Event::KeyPressed>() || evt.is<sf::Event::KeyReleased>() ||
+           evt.is<sf::Event::TextEntered>() || evt.is<sf::Event::MouseButtonPressed>() ||
+           evt.is<sf::Event::MouseButtonReleased>() || evt.is<sf::Event::MouseMoved>() ||
+           evt.is<sf::Event::MouseWheelScrolled>();
+}
+
+// Asset folders ship as "Assets/" but older checkouts use "assets/"
+static std::string assetRoot()
+{
+    return std::filesystem::exists("assets") ? "assets" : "Assets";
+}
+
 // ----------------------------------------------------------------------------
 // Main Application Entry
 // ----------------------------------------------------------------------------
 
-int main()
+int main(int argc, char *argv[])
 {
+    // 0) COMMAND LINE
+    RenderBackend renderBackend = RenderBackend::OpenGL;
+    std::string openPath;
+    BatchOptions batch;
+    bool batchDriver = false;
+    bool batchWorker = false;
+    std::string exportPath;
+    bool benchDownscale = false;
+    std::string stripPath;
+    StripLayout stripLayout;
+    std::string recordPath;
+    GoldenOptions golden;
+    bool goldenRun = false;
+    std::string replayPath;
+    std::string replayReportPath;
+    bool replayFast = false;
+    WatchdogOptions watchdogOptions;
+    std::string telemetryPath = Telemetry::defaultPath();
+    bool latencyMode = false;
+    std::string latencyReportPath;
+    std::size_t generateCount = 0;
+    std::uint64_t generateSeed = 1;
+    batch.executable = argv[0];
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg.rfind("--renderer=", 0) == 0)
+        {
+            if (!parseRenderBackend(arg.substr(11), renderBackend))
+                std::cerr << "[Main] Unknown renderer: " << arg << "\n";
+        }
+        else if (arg == "--open" && hasValue)
+            openPath = argv[++i];
+        else if (arg == "--batch" && hasValue)
+        {
+            batchDriver = true;
+            batch.manifestPath = argv[++i];
+        }
+        else if (arg == "--batch-worker" && hasValue)
+        {
+            batchWorker = true;
+            batch.manifestPath = argv[++i];
+        }
+        else if (arg == "--jobs" && hasValue)
+            batch.jobs = static_cast<unsigned>(std::stoul(argv[++i]));
+        else if (arg == "--export" && hasValue)
+            exportPath = argv[++i];
+        else if (arg == "--format" && hasValue)
+        {
+            ImageFormat format;
+            batch.format = argv[++i];
+            if (batch.format != "svg" && !parseImageFormat(batch.format, format))
+            {
+                std::cerr << "[Main] Unknown format: " << batch.format << "\n";
+                return 1;
+            }
+        }
+        else if (arg == "--svg-embed")
+            batch.svgEmbed = true;
+        else if (arg == "--quality" && hasValue)
+            batch.jpegQuality = std::stoi(argv[++i]);
+        else if (arg == "--png-level" && hasValue)
+            batch.pngLevel = std::stoi(argv[++i]);
+        else if (arg == "--colors" && hasValue)
+            batch.paletteColors = static_cast<unsigned>(std::stoul(argv[++i]));
+        else if (arg == "--supersample" && hasValue)
+        {
+            batch.supersample = static_cast<unsigned>(std::stoul(argv[++i]));
+            if (batch.supersample < 1 || batch.supersample > 4)
+            {
+                std::cerr << "[Main] --supersample must be 1..4\n";
+                return 1;
+            }
+        }
+        else if (arg == "--downscale" && hasValue)
+        {
+            DownscaleFilter filter;
+            batch.downscaleFilter = argv[++i];
+            if (!parseDownscaleFilter(batch.downscaleFilter, filter))
+            {
+                std::cerr << "[Main] Unknown downscale filter: " << batch.downscaleFilter << "\n";
+                return 1;
+            }
+        }
+        else if (arg == "--golden" && hasValue)
+        {
+            goldenRun = true;
+            golden.dir = argv[++i];
+        }
+        else if (arg == "--update-golden")
+            golden.update = true;
+        else if (arg == "--golden-record-times")
+            golden.recordTimes = true;
+        else if (arg == "--golden-threshold" && hasValue)
+            golden.threshold = std::stod(argv[++i]);
+        else if (arg == "--golden-max-diff" && hasValue)
+            golden.maxDiffRatio = std::stod(argv[++i]);
+        else if (arg == "--golden-time-factor" && hasValue)
+            golden.timeFactor = std::stod(argv[++i]);
+        else if (arg == "--record" && hasValue)
+            recordPath = argv[++i];
+        else if (arg == "--replay" && hasValue)
+            replayPath = argv[++i];
+        else if (arg == "--fast")
+            replayFast = true;
+        else if (arg == "--replay-report" && hasValue)
+            replayReportPath = argv[++i];
+        else if (arg == "--log-level" && hasValue)
+        {
+            LogLevel level;
+            if (!parseLogLevel(argv[++i], level))
+            {
+                std::cerr << "[Main] Unknown log level: " << argv[i] << "\n";
+                return 1;
+            }
+            Logger::getInstance().setLevel(level);
+        }
+        else if (arg == "--latency")
+            latencyMode = true;
+        else if (arg == "--latency-report" && hasValue)
+        {
+            latencyMode = true;
+            latencyReportPath = argv[++i];
+        }
+        else if (arg == "--telemetry" && hasValue)
+            telemetryPath = argv[++i];
+        else if (arg == "--no-telemetry")
+            telemetryPath.clear();
+        else if (arg == "--stall-ms" && hasValue)
+            watchdogOptions.stallMs = std::stod(argv[++i]);
+        else if (arg == "--generate" && hasValue)
+            generateCount = static_cast<std::size_t>(std::stoull(argv[++i]));
+        else if (arg == "--seed" && hasValue)
+            generateSeed = std::stoull(argv[++i]);
+        else if (arg == "--strip" && hasValue)
+            stripPath = argv[++i];
+        else if (arg == "--grid" && hasValue)
+        {
+            std::string grid = argv[++i];
+            std::size_t x = grid.find('x');
+            try
+            {
+                stripLayout.columns = static_cast<unsigned>(std::stoul(grid.substr(0, x)));
+                stripLayout.rows = static_cast<unsigned>(std::stoul(grid.substr(x + 1)));
+            }
+            catch (const std::exception &)
+            {
+                stripLayout.columns = 0;
+            }
+            if (x == std::string::npos || stripLayout.columns == 0 || stripLayout.rows == 0)
+            {
+                std::cerr << "[Main] --grid expects COLUMNSxROWS, e.g. 3x2\n";
+                return 1;
+            }
+        }
+        else if (arg == "--bench-downscale")
+            benchDownscale = true;
+        else if (arg == "--force")
+            batch.force = true;
+        else if (arg == "--no-cache")
+            batch.useCache = false;
+        else if (arg == "--out" && hasValue)
+            batch.outputDir = argv[++i];
+        else if (arg == "--shard" && hasValue)
+            batch.shard = static_cast<unsigned>(std::stoul(argv[++i]));
+        else if (arg == "--shard-list" && hasValue)
+            batch.shardList = argv[++i];
+        else if (arg == "--run-id" && hasValue)
+            batch.runId = argv[++i];
+        else
+            std::cerr << "[Main] Unknown argument: " << arg << "\n";
+    }
+
+    // Image bytes go to stdout: keep all logging on stderr
+    if (exportPath == "-")
+    {
+        Logger::getInstance().setStreams(std::cerr, std::cerr);
+        std::cout.rdbuf(std::cerr.rdbuf());
+    }
+
+    if (benchDownscale)
+    {
+        for (const auto &r : benchmarkDownscale())
+            std::cout << "[Bench] downscale " << r.name << ": " << r.megapixelsPerSecond
+                      << " MP/s (" << r.milliseconds << " ms per 2048x2048 output)\n";
+        return 0;
+    }
+
+    // Batch driver only schedules workers: no assets, no window
+    if (batchDriver)
+    {
+        try
+        {
+            return BatchRenderer(batch).run();
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "[Batch] " << e.what() << "\n";
+            return 1;
+        }
+    }
+
     // 1) AUTO-LOAD ASSETS
     try
     {
         auto &AM = AssetManager::getInstance();
 
+        // Workers and headless exports never open a window: decode images on the CPU only
+        AM.setHeadless(batchWorker || goldenRun || !exportPath.empty());
+
         std::cout << "====================================\n";
         std::cout << " Comic Strip Maker - Asset Loader\n";
         std::cout << "====================================\n\n";
 
-        AM.autoLoadCharacters("assets/Characters");
-        AM.autoLoadFonts("assets/Font");
-        AM.autoLoadBubbles("assets/SpeechBubbles");
+        const std::string root = assetRoot();
+        AM.autoLoadCharacters(root + "/Characters");
+        AM.autoLoadFonts(root + "/Font");
+        AM.autoLoadBubbles(root + "/SpeechBubbles");
 
+        // Asset lines are logged asynchronously: let them print first
+        Logger::getInstance().flush();
         std::cout << "\n[Main] All assets loaded successfully!\n";
         std::cout << "====================================\n\n";
     }
@@ -124,6 +459,93 @@ int main()
         return 1;
     }
 
+    if (batchWorker)
+        return BatchRenderer(batch).runWorker();
+
+    // Render regression check against golden images
+    if (goldenRun)
+    {
+        try
+        {
+            return GoldenSuite(golden).run();
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "[Golden] " << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    // Headless strip export
+    if (!stripPath.empty() && !exportPath.empty())
+    {
+        try
+        {
+            StripDocument strip = StripDocument::load(stripPath);
+            Exporter exporter(RenderBackend::Software);
+            configureExporter(exporter, batch);
+            ExportCache cache;
+            if (batch.useCache)
+                exporter.setCache(&cache);
+
+            if (!strip.exportStrip(exporter, exportPath))
+            {
+                std::cerr << "[Strip] Failed to export " << stripPath << "\n";
+                return 1;
+            }
+            std::cout << "[Strip] " << strip.getStripSize().x << "x" << strip.getStripSize().y << " -> "
+                      << exportPath << std::endl;
+            return 0;
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "[Strip] " << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    // Headless single-page export
+    if (!exportPath.empty())
+    {
+        try
+        {
+            Scene scene;
+            ProjectCanvas canvas;
+            if (generateCount > 0)
+            {
+                auto options = SceneGeneratorOptions::forObjectCount(generateCount, generateSeed);
+                SceneGenerator(options).generate(scene);
+                canvas.size = options.area;
+                std::cout << "[Generate] " << generateCount << " objects, seed " << generateSeed
+                          << ", scene hash " << toHex(SceneHasher().hash(scene)) << std::endl;
+            }
+            else
+            {
+                canvas = loadProject(openPath, scene);
+            }
+
+            Exporter exporter(RenderBackend::Software);
+            configureExporter(exporter, batch);
+            ExportCache cache;
+            if (batch.useCache)
+                exporter.setCache(&cache);
+
+            if (!exporter.exportScene(scene, canvas, nullptr, exportPath, SceneHasher().hash(scene)))
+            {
+                std::cerr << "[Export] Failed to export " << (generateCount > 0 ? "generated scene" : openPath) << "\n";
+                return 1;
+            }
+            std::cout << "[Export] " << canvas.size.x << "x" << canvas.size.y << " -> "
+                      << exportPath << std::endl;
+            return 0;
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "[Export] " << e.what() << "\n";
+            return 1;
+        }
+    }
+
     // 2) Dynamic Window Setup
     auto desktop = sf::VideoMode::getDesktopMode();
     unsigned int screenWidth = desktop.size.x;
@@ -137,6 +559,34 @@ int main()
         sf::String("Comic Strip Maker - Final"));
     window.setFramerateLimit(60);
 
+    // Event source: live window, recording or replay (see InputRecorder.h)
+    InputRecorder input;
+    try
+    {
+        if (!recordPath.empty())
+            input = InputRecorder::record(recordPath, window.getSize());
+        else if (!replayPath.empty())
+            input = InputRecorder::replay(replayPath, replayFast);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "[Main] " << e.what() << std::endl;
+        return 1;
+    }
+    if (input.isFastReplay())
+        window.setFramerateLimit(0);
+
+    // Dumps the flight recorder when a frame stalls (see FrameWatchdog.h)
+    FrameWatchdog watchdog(watchdogOptions);
+
+    // Session histograms and counts, written on exit (see Telemetry.h)
+    Telemetry &telemetry = Telemetry::getInstance();
+    telemetry.setEnabled(!telemetryPath.empty());
+    std::optional<std::chrono::steady_clock::time_point> pendingInput;
+
+    // Pointer event -> stroke vertices on screen (see LatencyProbe.h)
+    LatencyProbe latency(latencyMode);
+
     int windowX = static_cast<int>((screenWidth - windowWidth) / 2);
     int windowY = static_cast<int>((screenHeight - windowHeight) / 2);
     window.setPosition({windowX, windowY});
@@ -224,13 +674,114 @@ int main()
     bool isEraserHovered = false;
     bool eraserActive = false;
 
+    // Raster brush (F6): the stroke in progress and the layer before it
+    bool rasterBrush = false;
+    bool painting = false;
+    sf::Vector2f lastPaintPos;
+    PaintLayer::Snapshot paintBefore;
+
+    // Fill tool (F7): canvas clicks bucket-fill instead of drawing/selecting
+    bool fillTool = false;
+
+    // Stats overlay (F3): frame time and memory, refreshed twice a second
+    bool showStats = false;
+    sf::Clock frameClock;
+    sf::Clock statsClock;
+    float frameMs = 0.f;
+    std::string statsText;
+
     // 5) Command Manager
     CommandManager commandManager;
 
+    // Scene hash for the export cache: objects rehash themselves when edited,
+    // commands (add/delete/undo/redo) invalidate the combined hash
+    SceneHasher sceneHasher;
+    commandManager.setChangeListener([&sceneHasher]() { sceneHasher.invalidate(); });
+
     // 6) Scene containers
-    std::vector<std::unique_ptr<Character>> characters;
-    std::vector<std::unique_ptr<SpeechBubble>> bubbles;
-    std::vector<std::unique_ptr<BrushStroke>> strokes;
+    Scene scene;
+    auto &characters = scene.characters;
+    auto &bubbles = scene.bubbles;
+    auto &strokes = scene.strokes;
+
+    if (!openPath.empty())
+    {
+        try
+        {
+            loadProject(openPath, scene);
+            LOG_INFO("Project") << "Opened " << openPath;
+        }
+        catch (const std::exception &e)
+        {
+            LOG_ERROR("Project") << e.what();
+        }
+    }
+
+    if (generateCount > 0)
+    {
+        // Fill the visible canvas (right of the sidebar)
+        auto options = SceneGeneratorOptions::forObjectCount(generateCount, generateSeed);
+        options.origin = sf::Vector2f(SidebarW, 0.f);
+        options.area = sf::Vector2u(windowWidth - static_cast<unsigned>(SidebarW), windowHeight);
+        SceneGenerator(options).generate(scene);
+        LOG_INFO("Generate") << generateCount << " objects, seed " << generateSeed;
+    }
+
+    // Strip mode: the edited panel lives in `scene`, the others in the
+    // document (contents are swapped, so the container references and the
+    // commands' vectors stay valid)
+    std::optional<StripDocument> strip;
+    std::size_t activePanel = 0;
+    if (!stripPath.empty())
+    {
+        try
+        {
+            strip = std::filesystem::exists(stripPath)
+                        ? StripDocument::load(stripPath)
+                        : StripDocument::create(stripPath, stripLayout, sf::Vector2f(SidebarW, 0.f));
+            std::swap(scene, strip->getPanel(activePanel));
+            LOG_INFO("Strip") << stripPath << ": " << strip->getPanelCount()
+                              << " panels, editing panel 1 (PageUp/PageDown to switch)";
+        }
+        catch (const std::exception &e)
+        {
+            LOG_ERROR("Strip") << e.what();
+            strip.reset();
+        }
+    }
+
+    // Run `fn` with the edited panel back in the document
+    auto withStripSynced = [&](auto fn)
+    {
+        std::swap(scene, strip->getPanel(activePanel));
+        try
+        {
+            fn();
+        }
+        catch (...)
+        {
+            std::swap(scene, strip->getPanel(activePanel));
+            throw;
+        }
+        std::swap(scene, strip->getPanel(activePanel));
+    };
+    // Memory of the edited scene, the other strip panels (the edited
+    // panel's slot holds an empty scene while it is swapped out), history
+    // and assets (see MemoryStats.h)
+    auto memoryReport = [&]()
+    {
+        std::vector<const Scene *> scenes{&scene};
+        for (std::size_t i = 0; strip && i < strip->getPanelCount(); ++i)
+            scenes.push_back(&strip->getPanel(i));
+        return collectMemoryReport(scenes, &commandManager, strip ? &*strip : nullptr);
+    };
+
+
+    Exporter exporter(renderBackend);
+    configureExporter(exporter, batch);
+    ExportCache exportCache;
+    if (batch.useCache)
+        exporter.setCache(&exportCache);
 
     // 7) Palette Data
     std::vector<PaletteItem> palette;
@@ -280,6 +831,18 @@ int main()
     int dragSpriteIdx = -1;
     bool draggingBubble = false;
     int dragBubbleIdx = -1;
+    bool draggingStroke = false;
+    int dragStrokeIdx = -1;
+
+    // Multi-selection: rubber band / lasso in progress, then group gestures
+    Selection selection;
+    bool selecting = false;
+    bool lassoSelect = false;
+    std::vector<sf::Vector2f> selectPath;        // Rectangle: start, end
+    bool groupMoving = false;
+    bool groupResizing = false;
+    sf::Vector2f groupStartMouse{0.f, 0.f};
+    sf::FloatRect groupStartBounds;
     sf::Vector2f dragOffset{0.f, 0.f};
 
     SpeechBubble *activeBubble = nullptr;
@@ -352,6 +915,11 @@ int main()
         return sf::FloatRect(c.getPosition(), c.getSize());
     };
 
+    auto strokeRect = [&](const BrushStroke &s)
+    {
+        return sf::FloatRect(s.getPosition(), s.getSize());
+    };
+
     // Resize Handle (Bottom-Right)
     auto handleRect = [&](const sf::FloatRect &r)
     {
@@ -371,9 +939,103 @@ int main()
             sf::Vector2f{h, h});
     };
 
+    // Clipboard (Ctrl+C / Ctrl+V / Ctrl+D): copies of objects kept in a
+    // Scene; stroke copies share their points with the original
+    Scene clipboard;
+    int pasteCount = 0;
+
+    // The selected objects as a scene (empty when nothing is selected)
+    auto copySelection = [&]()
+    {
+        if (!selection.empty())
+            return selection.copy();
+        Scene copy;
+        if (picked == PickKind::Stroke && pickedIndex >= 0 && pickedIndex < static_cast<int>(strokes.size()))
+            copy.strokes.push_back(strokes[pickedIndex]->clone(strokes[pickedIndex]->getId()));
+        else if (picked == PickKind::Sprite && pickedIndex >= 0 &&
+                 pickedIndex < static_cast<int>(characters.size()))
+            copy.characters.push_back(characters[pickedIndex]->clone(characters[pickedIndex]->getId()));
+        else if (picked == PickKind::Bubble && pickedIndex >= 0 && pickedIndex < static_cast<int>(bubbles.size()))
+            copy.bubbles.push_back(bubbles[pickedIndex]->clone(bubbles[pickedIndex]->getId()));
+        return copy;
+    };
+
+    // Number for the next "group_<n>" id: above every group id in the scene,
+    // so ids stay unique after ungroup and undo (a count would repeat them)
+    auto nextGroupNumber = [&]()
+    {
+        int highest = 0;
+        for (const auto &g : scene.groups)
+        {
+            const std::string &id = g->getId();
+            if (id.rfind("group_", 0) == 0)
+                highest = std::max(highest, std::atoi(id.c_str() + 6));
+        }
+        return highest + 1;
+    };
+
+    // Add copies of `objects`, moved by `offset`, as one undo step and select
+    // them (a single object is picked instead)
+    auto pasteObjects = [&](const Scene &objects, sf::Vector2f offset, const std::string &commandName)
+    {
+        Scene pasted;
+        for (const auto &s : objects.strokes)
+        {
+            pasted.strokes.push_back(
+                s->clone("stroke_" + std::to_string(strokes.size() + pasted.strokes.size() + 1)));
+            pasted.strokes.back()->move(offset);
+        }
+        for (const auto &c : objects.characters)
+        {
+            pasted.characters.push_back(c->clone(c->getId()));
+            pasted.characters.back()->move(offset.x, offset.y);
+        }
+        for (const auto &b : objects.bubbles)
+        {
+            pasted.bubbles.push_back(b->clone(b->getId()));
+            pasted.bubbles.back()->setPosition(b->getPosition().x + offset.x, b->getPosition().y + offset.y);
+        }
+        const int firstGroup = nextGroupNumber();
+        for (const auto &g : objects.groups)
+        {
+            pasted.groups.push_back(
+                g->clone("group_" + std::to_string(firstGroup + static_cast<int>(pasted.groups.size()))));
+            pasted.groups.back()->move(offset.x, offset.y);
+        }
+
+        // Groups are only moved through the selection
+        selection.clear();
+        if (pasted.strokes.size() + pasted.characters.size() + pasted.bubbles.size() > 1 || !pasted.groups.empty())
+        {
+            for (const auto &s : pasted.strokes)
+                selection.add(s.get());
+            for (const auto &c : pasted.characters)
+                selection.add(c.get());
+            for (const auto &b : pasted.bubbles)
+                selection.add(b.get());
+            for (const auto &g : pasted.groups)
+                selection.add(g.get());
+            commandManager.executeCommand(std::make_unique<PasteCommand>(scene, std::move(pasted), commandName));
+            picked = PickKind::None;
+            pickedIndex = -1;
+            activeBubble = nullptr;
+            return;
+        }
+
+        picked = !pasted.bubbles.empty()      ? PickKind::Bubble
+                 : !pasted.characters.empty() ? PickKind::Sprite
+                                              : PickKind::Stroke;
+        commandManager.executeCommand(std::make_unique<PasteCommand>(scene, std::move(pasted), commandName));
+        pickedIndex = static_cast<int>(picked == PickKind::Bubble   ? bubbles.size()
+                                       : picked == PickKind::Sprite ? characters.size()
+                                                                    : strokes.size()) -
+                      1;
+        activeBubble = picked == PickKind::Bubble ? bubbles.back().get() : nullptr;
+    };
+
     auto mousePositionF = [&](sf::RenderWindow &win)
     {
-        auto mp = sf::Mouse::getPosition(win);
+        auto mp = input.mousePosition(win);
         return sf::Vector2f{static_cast<float>(mp.x), static_cast<float>(mp.y)};
     };
 
@@ -439,7 +1101,7 @@ int main()
     sf::Texture colorWheelTexture;
     if (!colorWheelTexture.loadFromImage(colorWheelImage))
     {
-        std::cerr << "[ColorWheel] Failed to load texture from generated image\n";
+        LOG_ERROR("ColorWheel") << "Failed to load texture from generated image";
     }
 
     sf::Sprite colorWheelSprite(colorWheelTexture);
@@ -510,6 +1172,13 @@ int main()
     // ------------------------------------------------------------------------
     while (window.isOpen())
     {
+        input.beginFrame();
+        if (input.finished())
+        {
+            window.close();
+            break;
+        }
+
         // Update mouse pos
         sf::Vector2f mpos = mousePositionF(window);
 
@@ -532,8 +1201,18 @@ int main()
             isEraserHovered = false;
         }
 
-        for (auto evt = window.pollEvent(); evt; evt = window.pollEvent())
+        TimedScope eventsTimed("frame/events");
+        for (auto evt = input.poll(window); evt; evt = input.poll(window))
         {
+            if (isUserInput(*evt))
+            {
+                telemetry.count(Counter::InputEvents);
+                if (!pendingInput)
+                    pendingInput = std::chrono::steady_clock::now();
+            }
+            if (evt->is<sf::Event::MouseMoved>() || evt->is<sf::Event::MouseButtonPressed>())
+                latency.pointerArrived();
+
             // System Events
             if (evt->is<sf::Event::Closed>())
             {
@@ -560,9 +1239,10 @@ int main()
 
                 // Undo: Ctrl+Z
                 if (key == sf::Keyboard::Key::Z &&
-                    sf::Keyboard::isKeyPressed(sf::Keyboard::Key::LControl))
+                    input.isKeyDown(sf::Keyboard::Key::LControl))
                 {
                     commandManager.undo();
+                    selection.clear();
                     picked = PickKind::None;
                     pickedIndex = -1;
                     activeBubble = nullptr;
@@ -570,12 +1250,191 @@ int main()
 
                 // Redo: Ctrl+Y
                 if (key == sf::Keyboard::Key::Y &&
-                    sf::Keyboard::isKeyPressed(sf::Keyboard::Key::LControl))
+                    input.isKeyDown(sf::Keyboard::Key::LControl))
                 {
                     commandManager.redo();
+                    selection.clear();
+                    picked = PickKind::None;
+                    pickedIndex = -1;
+                    activeBubble = nullptr;
+                }
+
+                // Copy / paste / duplicate the selected object
+                if ((key == sf::Keyboard::Key::C || key == sf::Keyboard::Key::V ||
+                     key == sf::Keyboard::Key::D) &&
+                    input.isKeyDown(sf::Keyboard::Key::LControl))
+                {
+                    const sf::Vector2f step(20.f, 20.f);
+                    if (key == sf::Keyboard::Key::V)
+                    {
+                        if (!clipboard.strokes.empty() || !clipboard.characters.empty() ||
+                            !clipboard.bubbles.empty() || !clipboard.groups.empty())
+                            pasteObjects(clipboard, step * static_cast<float>(++pasteCount), "Paste");
+                        continue;
+                    }
+
+                    Scene selection = copySelection();
+                    if (selection.strokes.empty() && selection.characters.empty() && selection.bubbles.empty() &&
+                        selection.groups.empty())
+                        continue;
+                    if (key == sf::Keyboard::Key::C)
+                    {
+                        clipboard = std::move(selection);
+                        pasteCount = 0;
+                        LOG_DEBUG("Edit") << "Copied to clipboard";
+                    }
+                    else
+                    {
+                        pasteObjects(selection, step, "Duplicate");
+                    }
+                    continue;
+                }
+
+                // Group / ungroup the selection: Ctrl+G / Ctrl+Shift+G
+                if (key == sf::Keyboard::Key::G && input.isKeyDown(sf::Keyboard::Key::LControl))
+                {
+                    if (input.isKeyDown(sf::Keyboard::Key::LShift))
+                    {
+                        const std::vector<ObjectGroup *> groups = selection.groups();
+                        selection.clear();
+                        for (ObjectGroup *g : groups)
+                            commandManager.executeCommand(std::make_unique<UngroupCommand>(scene, g));
+                        if (!groups.empty())
+                        {
+                            LOG_INFO("Edit") << "Ungrouped " << groups.size() << " group(s)";
+                        }
+                        continue;
+                    }
+
+                    if (selection.size() < 2 || !selection.groups().empty())
+                    {
+                        LOG_WARN("Edit") << "Grouping needs at least two selected objects and no groups";
+                        continue;
+                    }
+                    const std::vector<CanvasObject *> &chosen = selection.objects();
+                    auto indicesOf = [&](const auto &list)
+                    {
+                        std::vector<std::size_t> indices;
+                        for (std::size_t i = 0; i < list.size(); ++i)
+                            if (std::find(chosen.begin(), chosen.end(), list[i].get()) != chosen.end())
+                                indices.push_back(i);
+                        return indices;
+                    };
+                    auto cmd = std::make_unique<GroupCommand>(scene, indicesOf(strokes), indicesOf(characters),
+                                                              indicesOf(bubbles),
+                                                              "group_" + std::to_string(nextGroupNumber()));
+                    ObjectGroup *group = cmd->getGroup();
+                    commandManager.executeCommand(std::move(cmd));
+                    selection.clear();
+                    selection.add(group);
+                    picked = PickKind::None;
+                    pickedIndex = -1;
+                    activeBubble = nullptr;
+                    LOG_INFO("Edit") << "Grouped " << group->memberCount() << " objects as " << group->getId();
+                    continue;
+                }
+
+                // Save strip (all panels): Ctrl+S in strip mode
+                if (strip && key == sf::Keyboard::Key::S &&
+                    input.isKeyDown(sf::Keyboard::Key::LControl))
+                {
+                    try
+                    {
+                        withStripSynced([&]() { strip->save(stripPath); });
+                        LOG_INFO("Strip") << "Saved to: " << stripPath;
+                    }
+                    catch (const std::exception &e)
+                    {
+                        LOG_ERROR("Strip") << e.what();
+                    }
+                    continue;
+                }
+
+                // Switch strip panel: PageUp / PageDown
+                if (strip && (key == sf::Keyboard::Key::PageUp || key == sf::Keyboard::Key::PageDown))
+                {
+                    std::size_t count = strip->getPanelCount();
+                    std::size_t next = key == sf::Keyboard::Key::PageDown ? (activePanel + 1) % count
+                                                                          : (activePanel + count - 1) % count;
+                    std::swap(scene, strip->getPanel(activePanel));
+                    activePanel = next;
+                    std::swap(scene, strip->getPanel(activePanel));
+
+                    // History refers to the previous panel's objects
+                    commandManager.clear();
+                    selection.clear();
                     picked = PickKind::None;
                     pickedIndex = -1;
                     activeBubble = nullptr;
+                    activeStroke = nullptr;
+                    painting = false;
+                    paintBefore.clear();
+                    sceneHasher.invalidate();
+                    LOG_INFO("Strip") << "Editing panel " << activePanel + 1 << " of " << count;
+                    continue;
+                }
+
+                // Save project: Ctrl+S
+                if (key == sf::Keyboard::Key::S &&
+                    input.isKeyDown(sf::Keyboard::Key::LControl))
+                {
+                    ProjectCanvas canvas;
+                    canvas.origin = sf::Vector2f(SidebarW, 0.f);
+                    canvas.size = sf::Vector2u(window.getSize().x > static_cast<unsigned>(SidebarW)
+                                                   ? window.getSize().x - static_cast<unsigned>(SidebarW)
+                                                   : 0,
+                                               window.getSize().y);
+                    std::string path = Exporter::nextExportPath("SavedComics", ".comic");
+                    try
+                    {
+                        saveProject(path, scene, canvas);
+                        LOG_INFO("Project") << "Saved to: " << path;
+                    }
+                    catch (const std::exception &e)
+                    {
+                        LOG_ERROR("Project") << e.what();
+                    }
+                    continue;
+                }
+
+                // Cycle export supersampling: F2
+                if (key == sf::Keyboard::Key::F2)
+                {
+                    unsigned factor = exporter.getSupersample() >= 4 ? 1 : exporter.getSupersample() * 2;
+                    DownscaleFilter filter = DownscaleFilter::Box;
+                    parseDownscaleFilter(batch.downscaleFilter, filter);
+                    exporter.setSupersample(factor, filter);
+                    LOG_INFO("Export") << "Supersampling " << factor << "x";
+                    continue;
+                }
+
+                // Stats overlay / memory report: F3 / F4
+                if (key == sf::Keyboard::Key::F3)
+                {
+                    showStats = !showStats;
+                    statsText.clear();
+                    continue;
+                }
+                if (key == sf::Keyboard::Key::F4)
+                {
+                    logMemoryReport(memoryReport());
+                    continue;
+                }
+
+                // Raster brush on/off: F6
+                if (key == sf::Keyboard::Key::F6)
+                {
+                    rasterBrush = !rasterBrush;
+                    LOG_INFO("Paint") << (rasterBrush ? "Raster brush (paint layer)" : "Vector strokes");
+                    continue;
+                }
+
+                // Fill tool on/off: F7
+                if (key == sf::Keyboard::Key::F7)
+                {
+                    fillTool = !fillTool;
+                    LOG_INFO("Paint") << (fillTool ? "Fill tool" : "Fill tool off");
+                    continue;
                 }
 
                 // Backspace text in active bubble
@@ -589,6 +1448,22 @@ int main()
                     }
                 }
 
+                // Delete selected groups (highest index first, so the
+                // recorded indices of the others stay valid)
+                if (key == sf::Keyboard::Key::Delete && !selection.groups().empty())
+                {
+                    std::vector<int> indices;
+                    for (ObjectGroup *g : selection.groups())
+                        for (std::size_t i = 0; i < scene.groups.size(); ++i)
+                            if (scene.groups[i].get() == g)
+                                indices.push_back(static_cast<int>(i));
+                    std::sort(indices.rbegin(), indices.rend());
+                    selection.clear();
+                    for (int i : indices)
+                        commandManager.executeCommand(std::make_unique<DeleteGroupCommand>(scene.groups, i));
+                    continue;
+                }
+
                 // Delete selected object
                 if (key == sf::Keyboard::Key::Delete && pickedIndex >= 0)
                 {
@@ -673,7 +1548,7 @@ int main()
                         if (exportButton.getGlobalBounds().contains(mpos))
                         {
                             saveNextFrame = true; // Trigger save on next render
-                            std::cout << "[Export] Snapshot requested..." << std::endl;
+                            LOG_INFO("Export") << "Snapshot requested...";
                             continue;
                         }
 
@@ -688,7 +1563,7 @@ int main()
                                 if (cursor)
                                     window.setMouseCursor(*cursor);
                             }
-                            std::cout << "[Eraser] " << (eraserActive ? "ON" : "OFF") << std::endl;
+                            LOG_INFO("Eraser") << (eraserActive ? "ON" : "OFF");
                             continue;
                         }
 
@@ -766,7 +1641,7 @@ int main()
                                 drawButton.setFillColor(sf::Color(200, 200, 200));
                             }
 
-                            std::cout << "[DrawMode] " << (drawMode ? "ON" : "OFF") << "\n";
+                            LOG_INFO("DrawMode") << (drawMode ? "ON" : "OFF");
                             continue;
                         }
 
@@ -774,6 +1649,7 @@ int main()
                         if (undoButton.getGlobalBounds().contains(mpos))
                         {
                             commandManager.undo();
+                            selection.clear();
                             picked = PickKind::None;
                             pickedIndex = -1;
                             activeBubble = nullptr;
@@ -784,6 +1660,7 @@ int main()
                         if (redoButton.getGlobalBounds().contains(mpos))
                         {
                             commandManager.redo();
+                            selection.clear();
                             picked = PickKind::None;
                             pickedIndex = -1;
                             activeBubble = nullptr;
@@ -852,11 +1729,11 @@ int main()
                                 if (activeBubble)
                                 {
                                     activeBubble->setFontName(item.assetKey);
-                                    std::cout << "[Font] Changed to: " << item.assetKey << "\n";
+                                    LOG_INFO("Font") << "Changed to: " << item.assetKey;
                                 }
                                 else
                                 {
-                                    std::cout << "[Font] No bubble selected.\n";
+                                    LOG_INFO("Font") << "No bubble selected.";
                                 }
                             }
 
@@ -874,6 +1751,50 @@ int main()
                     {
                     }
 
+                    if (fillTool && mpos.x > SidebarW && mpos.y >= 0.f)
+                    {
+                        // Bucket fill: the region under the click in a CPU render
+                        // of the visible canvas (strokes act as borders), painted
+                        // into the layer as one undoable step
+                        TimedScope timed("paint/fill");
+                        sf::Clock fillClock;
+                        RasterSettings rs;
+                        rs.origin = sf::Vector2f(SidebarW, 0.f);
+                        rs.size = sf::Vector2u(window.getSize().x > static_cast<unsigned>(SidebarW)
+                                                   ? window.getSize().x - static_cast<unsigned>(SidebarW)
+                                                   : 0,
+                                               window.getSize().y);
+                        const RgbaBuffer pixels = SoftwareRenderer(rs).render(scene);
+                        const sf::Vector2u seed(static_cast<unsigned>(mpos.x - SidebarW),
+                                                static_cast<unsigned>(mpos.y));
+                        const FillRegion region = floodFill(pixels.getPixelsPtr(), rs.size, seed);
+                        if (region.pixels > 0)
+                        {
+                            if (!scene.paint)
+                                scene.paint = std::make_unique<PaintLayer>();
+                            PaintLayer::Snapshot before = scene.paint->snapshot();
+                            scene.paint->fillMask(region.mask.data(), region.size, region.bounds,
+                                                  sf::Vector2i(static_cast<int>(SidebarW), 0), currentBrushColor);
+                            commandManager.executeCommand(std::make_unique<PaintCommand>(
+                                scene.paint.get(), std::move(before), scene.paint->snapshot(), "Fill"));
+                            LOG_DEBUG("Paint") << "Filled " << region.pixels << " px in "
+                                               << fillClock.getElapsedTime().asMicroseconds() / 1000.0 << " ms";
+                        }
+                        continue;
+                    }
+
+                    if (drawMode && rasterBrush && mpos.x > SidebarW)
+                    {
+                        // Paint straight into the layer; one PaintCommand on release
+                        if (!scene.paint)
+                            scene.paint = std::make_unique<PaintLayer>();
+                        paintBefore = scene.paint->snapshot();
+                        painting = true;
+                        lastPaintPos = mpos;
+                        scene.paint->dab(mpos, currentBrushThickness * 0.5f, currentBrushColor, eraserActive);
+                        continue;
+                    }
+
                     if (drawMode && mpos.x > SidebarW)
                     {
                         // Start new stroke
@@ -885,13 +1806,56 @@ int main()
                             id, brushColor, currentBrushThickness);
                         activeStroke = stroke.get();
                         activeStroke->beginAt(mpos);
+                        latency.tagVertices(*activeStroke, activeStroke->getPointCount());
 
                         auto cmd = std::make_unique<AddStrokeCommand>(strokes, std::move(stroke));
                         commandManager.executeCommand(std::move(cmd));
                         continue;
                     }
 
+                    // Multi-selection: its handles and objects act on the whole group
+                    if (!selection.empty())
+                    {
+                        const sf::FloatRect gb = selection.bounds();
+                        if (flipHandleRect(gb).contains(mpos))
+                        {
+                            commandManager.executeCommand(selection.flipCommand());
+                            continue;
+                        }
+                        groupResizing = handleRect(gb).contains(mpos);
+                        groupMoving = !groupResizing && selection.hit(mpos);
+                        if (groupResizing || groupMoving)
+                        {
+                            groupStartMouse = mpos;
+                            groupStartBounds = gb;
+                            selection.beginTransform();
+                            continue;
+                        }
+                        selection.clear();
+                    }
+
+                    // Groups are drawn on top: clicking one selects it and starts moving it
+                    for (int i = static_cast<int>(scene.groups.size()) - 1; i >= 0; --i)
+                    {
+                        if (scene.groups[i]->isClicked(mpos.x, mpos.y))
+                        {
+                            selection.add(scene.groups[i].get());
+                            groupMoving = true;
+                            groupStartMouse = mpos;
+                            groupStartBounds = selection.bounds();
+                            selection.beginTransform();
+                            picked = PickKind::None;
+                            pickedIndex = -1;
+                            activeBubble = nullptr;
+                            break;
+                        }
+                    }
+                    if (groupMoving)
+                        continue;
+
                     // If not in draw mode, handle selection / dragging / resizing
+                    const PickKind picked0 = picked;
+                    const int picked0Index = pickedIndex;
                     picked = PickKind::None;
                     pickedIndex = -1;
                     activeBubble = nullptr;
@@ -923,6 +1887,16 @@ int main()
                             }
                         }
                     }
+                    // Strokes only show the flip handle while selected
+                    if (!hit && picked0 == PickKind::Stroke && picked0Index >= 0 &&
+                        picked0Index < static_cast<int>(strokes.size()) &&
+                        flipHandleRect(strokeRect(*strokes[picked0Index])).contains(mpos))
+                    {
+                        strokes[picked0Index]->setFlipped(!strokes[picked0Index]->isFlipped());
+                        picked = PickKind::Stroke;
+                        pickedIndex = picked0Index;
+                        hit = true;
+                    }
                     if (hit)
                         continue;
 
@@ -999,6 +1973,31 @@ int main()
                             }
                         }
                     }
+
+                    // Drag strokes (moving only changes the stroke's transform)
+                    if (!draggingSprite && !draggingBubble)
+                    {
+                        for (int i = static_cast<int>(strokes.size()) - 1; i >= 0; --i)
+                        {
+                            if (strokes[i]->isClicked(mpos.x, mpos.y))
+                            {
+                                draggingStroke = true;
+                                dragStrokeIdx = i;
+                                dragOffset = mpos - strokes[i]->getPosition();
+                                picked = PickKind::Stroke;
+                                pickedIndex = i;
+                                break;
+                            }
+                        }
+                    }
+
+                    // Nothing under the pointer: rubber band (Shift: lasso)
+                    if (picked == PickKind::None && mpos.x > SidebarW)
+                    {
+                        selecting = true;
+                        lassoSelect = input.isKeyDown(sf::Keyboard::Key::LShift);
+                        selectPath.assign(lassoSelect ? 1 : 2, mpos);
+                    }
                 }
 
                 continue;
@@ -1026,14 +2025,52 @@ int main()
 
                 // End stroke
                 activeStroke = nullptr;
+                if (painting && scene.paint)
+                {
+                    commandManager.executeCommand(std::make_unique<PaintCommand>(
+                        scene.paint.get(), std::move(paintBefore), scene.paint->snapshot()));
+                    paintBefore.clear();
+                }
+                painting = false;
 
                 resizing = false;
                 resizeKind = PickKind::None;
                 resizeIndex = -1;
                 draggingSprite = false;
                 draggingBubble = false;
+                draggingStroke = false;
                 dragSpriteIdx = -1;
                 dragBubbleIdx = -1;
+                dragStrokeIdx = -1;
+
+                if (selecting)
+                {
+                    if (lassoSelect)
+                    {
+                        selection.selectLasso(scene, selectPath);
+                    }
+                    else
+                    {
+                        const sf::Vector2f a = selectPath.front(), b = selectPath.back();
+                        selection.selectRect(scene, sf::FloatRect({std::min(a.x, b.x), std::min(a.y, b.y)},
+                                                                  {std::abs(b.x - a.x), std::abs(b.y - a.y)}));
+                    }
+                    selecting = false;
+                    selectPath.clear();
+                    if (!selection.empty())
+                    {
+                        LOG_DEBUG("Edit") << "Selected " << selection.size() << " objects";
+                    }
+                }
+
+                // The whole gesture is one undo step
+                if (groupMoving || groupResizing)
+                {
+                    if (auto cmd = selection.endTransform(groupMoving ? "Move" : "Resize"))
+                        commandManager.executeCommand(std::move(cmd));
+                    groupMoving = false;
+                    groupResizing = false;
+                }
 
                 continue;
             }
@@ -1117,10 +2154,44 @@ int main()
                     }
                 }
 
+                // Raster brush: dabs along the movement
+                if (drawMode && painting && scene.paint && mpos.x > SidebarW)
+                {
+                    scene.paint->segment(lastPaintPos, mpos, currentBrushThickness * 0.5f, currentBrushColor,
+                                         eraserActive);
+                    lastPaintPos = mpos;
+                    continue;
+                }
+
                 // Draw mode: extend active stroke (only if not over sidebar)
                 if (drawMode && activeStroke && mpos.x > SidebarW)
                 {
                     activeStroke->addPoint(mpos);
+                    latency.tagVertices(*activeStroke, activeStroke->getPointCount());
+                    continue;
+                }
+
+                // Rubber band / lasso
+                if (selecting)
+                {
+                    if (!lassoSelect)
+                        selectPath.back() = mpos;
+                    else if (std::hypot(mpos.x - selectPath.back().x, mpos.y - selectPath.back().y) >= 3.f)
+                        selectPath.push_back(mpos);
+                    continue;
+                }
+
+                // Group move / resize: every object is re-placed from its
+                // start placement, one transform per object
+                if (groupMoving)
+                {
+                    selection.moveBy(mpos - groupStartMouse);
+                    continue;
+                }
+                if (groupResizing)
+                {
+                    sf::Vector2f newSize = groupStartBounds.size + (mpos - groupStartMouse);
+                    selection.resizeTo({std::max(newSize.x, 10.f), std::max(newSize.y, 10.f)});
                     continue;
                 }
 
@@ -1158,16 +2229,28 @@ int main()
                     bubbles[dragBubbleIdx]->setPosition(newPos.x, newPos.y);
                 }
 
+                // Drag strokes
+                if (draggingStroke && dragStrokeIdx >= 0)
+                {
+                    strokes[dragStrokeIdx]->setPosition(mpos - dragOffset);
+                }
+
                 continue;
             }
         }
 
+        eventsTimed.end();
+
         // --------------------------------------------------------------------
         // RENDER LOOP
         // --------------------------------------------------------------------
+        TimedScope drawTimed("frame/draw");
+        TelemetryTimer drawTelemetry(Metric::FrameDraw);
         window.clear(sf::Color::White);
 
-        // 1. Draw Scene Objects
+        // 1. Draw Scene Objects (paint layer first, see Scene.h)
+        if (scene.paint)
+            scene.paint->draw(window);
         for (const auto &s : strokes)
         {
             s->draw(window);
@@ -1180,56 +2263,49 @@ int main()
         {
             b->draw(window);
         }
+        for (const auto &g : scene.groups)
+        {
+            g->draw(window);
+        }
 
         // 2. Handle Export (Capture Scene Only)
         if (saveNextFrame)
         {
-            sf::Texture texture;
-            if (texture.resize(window.getSize())) // Check return for nodiscard
+            // Crop out the sidebar (Start from SidebarW)
+            unsigned int cropX = static_cast<unsigned int>(SidebarW);
+            ProjectCanvas canvas;
+            canvas.origin = sf::Vector2f(SidebarW, 0.f);
+            canvas.size = sf::Vector2u(window.getSize().x > cropX ? window.getSize().x - cropX : 0,
+                                       window.getSize().y);
+
+            std::string filename = Exporter::nextExportPath("SavedComics", exporter.getExtension());
+            if (strip)
             {
-                texture.update(window);
-                sf::Image screenshot = texture.copyToImage();
-
-                // Crop out the sidebar (Start from SidebarW)
-                unsigned int cropX = static_cast<unsigned int>(SidebarW);
-                unsigned int cropW = window.getSize().x - cropX;
-                unsigned int cropH = window.getSize().y;
-
-                // Define output folder
-                namespace fs = std::filesystem;
-                std::string exportDir = "SavedComics";
-
-                // Create directory if it doesn't exist
-                if (!fs::exists(exportDir))
+                bool ok = false;
+                try
                 {
-                    fs::create_directory(exportDir);
+                    withStripSynced([&]() { ok = strip->exportStrip(exporter, filename); });
                 }
-
-                if (cropW > 0 && cropH > 0)
+                catch (const std::exception &e)
                 {
-                    sf::Image finalImage;
-                    // SFML 3: resize takes Vector2u, returns void
-                    finalImage.resize(sf::Vector2u(cropW, cropH));
-
-                    // SFML 3: copy takes Vector2u for dest, IntRect for source
-                    if (finalImage.copy(
-                            screenshot,
-                            sf::Vector2u(0, 0),
-                            sf::IntRect(sf::Vector2i(static_cast<int>(cropX), 0),
-                                        sf::Vector2i(static_cast<int>(cropW), static_cast<int>(cropH)))))
-                    {
-                        std::string filename = exportDir + "/Comic_" + std::to_string(std::time(nullptr)) + ".png";
-
-                        if (finalImage.saveToFile(filename))
-                        {
-                            std::cout << "[Export] Success! Saved to: " << filename << std::endl;
-                        }
-                        else
-                        {
-                            std::cerr << "[Export] Failed to save image." << std::endl;
-                        }
-                    }
+                    LOG_ERROR("Strip") << e.what();
                 }
+                if (ok)
+                    LOG_INFO("Export") << "Strip saved to: " << filename;
+                else
+                    LOG_ERROR("Export") << "Failed to save strip.";
+            }
+            else if (exporter.exportScene(scene, canvas, &window, filename, sceneHasher.hash(scene)))
+            {
+                if (exporter.getSupersample() > 1)
+                    LOG_INFO("Export") << "Success! Saved to: " << filename << " (" << exporter.getSupersample()
+                                       << "x supersampled)";
+                else
+                    LOG_INFO("Export") << "Success! Saved to: " << filename;
+            }
+            else
+            {
+                LOG_ERROR("Export") << "Failed to save image.";
             }
             saveNextFrame = false;
         }
@@ -1542,9 +2618,131 @@ int main()
             drawResizeHandle(r);
             drawFlipHandle(r);
         }
+        else if (picked == PickKind::Stroke &&
+                 pickedIndex >= 0 &&
+                 pickedIndex < static_cast<int>(strokes.size()))
+        {
+            // No resize handle: strokes keep their size when picked
+            sf::FloatRect r = strokeRect(*strokes[pickedIndex]);
+            sf::RectangleShape outline(r.size);
+            outline.setPosition(r.position);
+            outline.setFillColor(sf::Color::Transparent);
+            outline.setOutlineColor(sf::Color(0, 200, 255));
+            outline.setOutlineThickness(1.f);
+            window.draw(outline);
+            drawFlipHandle(r);
+        }
+
+        // Multi-selection: object outlines batched into one vertex array,
+        // then the group box with its resize and flip handles
+        if (!selection.empty())
+        {
+            const sf::Color selColor(0, 120, 255);
+            sf::VertexArray outlines(sf::PrimitiveType::Lines);
+            for (const CanvasObject *o : selection.objects())
+            {
+                const sf::Vector2f p = o->getPosition(), q = p + o->getSize();
+                const sf::Vector2f corners[4] = {p, {q.x, p.y}, q, {p.x, q.y}};
+                for (int i = 0; i < 4; ++i)
+                {
+                    outlines.append(sf::Vertex{corners[i], selColor, {}});
+                    outlines.append(sf::Vertex{corners[(i + 1) % 4], selColor, {}});
+                }
+            }
+            window.draw(outlines);
+
+            const sf::FloatRect gb = selection.bounds();
+            sf::RectangleShape box(gb.size);
+            box.setPosition(gb.position);
+            box.setFillColor(sf::Color::Transparent);
+            box.setOutlineColor(selColor);
+            box.setOutlineThickness(1.f);
+            window.draw(box);
+            drawResizeHandle(gb);
+            drawFlipHandle(gb);
+        }
 
-        window.display();
+        // Rubber band / lasso in progress
+        if (selecting && !selectPath.empty())
+        {
+            if (lassoSelect)
+            {
+                sf::VertexArray lasso(sf::PrimitiveType::LineStrip);
+                for (const auto &p : selectPath)
+                    lasso.append(sf::Vertex{p, sf::Color(0, 120, 255), {}});
+                lasso.append(sf::Vertex{selectPath.front(), sf::Color(0, 120, 255), {}});
+                window.draw(lasso);
+            }
+            else
+            {
+                const sf::Vector2f a = selectPath.front(), b = selectPath.back();
+                sf::RectangleShape band({std::abs(b.x - a.x), std::abs(b.y - a.y)});
+                band.setPosition({std::min(a.x, b.x), std::min(a.y, b.y)});
+                band.setFillColor(sf::Color(0, 120, 255, 40));
+                band.setOutlineColor(sf::Color(0, 120, 255));
+                band.setOutlineThickness(1.f);
+                window.draw(band);
+            }
+        }
+
+        // 10. Stats overlay (F3)
+        frameMs = frameMs * 0.9f + frameClock.restart().asSeconds() * 1000.f * 0.1f;
+        if (showStats)
+        {
+            if (statsText.empty() || statsClock.getElapsedTime().asSeconds() >= 0.5f)
+            {
+                statsClock.restart();
+                MemoryReport report = memoryReport();
+
+                char frameLine[64];
+                std::snprintf(frameLine, sizeof(frameLine), "Frame %.2f ms (%.0f FPS)\n\n", frameMs,
+                              frameMs > 0.f ? 1000.f / frameMs : 0.f);
+                statsText = frameLine;
+                for (const auto &c : report.categories)
+                    statsText += c.name + ": " + formatBytes(c.bytes) + " (" + std::to_string(c.count) + ")\n";
+                statsText += "Total: " + formatBytes(report.totalBytes());
+            }
+
+            sf::Text stats(AM.getFont("actionman"));
+            stats.setCharacterSize(13);
+            stats.setFillColor(sf::Color::White);
+            stats.setString(statsText);
+            sf::FloatRect sb = stats.getLocalBounds();
+            sf::RectangleShape statsBg(sf::Vector2f(sb.size.x + 16.f, sb.size.y + 16.f));
+            statsBg.setFillColor(sf::Color(0, 0, 0, 180));
+            statsBg.setPosition(sf::Vector2f(static_cast<float>(window.getSize().x) - statsBg.getSize().x - 8.f, 8.f));
+            stats.setPosition(statsBg.getPosition() + sf::Vector2f(8.f, 8.f) - sb.position);
+            window.draw(statsBg);
+            window.draw(stats);
+        }
+
+        drawTimed.end();
+        drawTelemetry.end();
+        latency.frameDrawn(strokes);
+        {
+            TimedScope displayTimed("frame/display");
+            window.display();
+        }
+        latency.framePresented();
+        watchdog.frameCompleted();
+        telemetry.count(Counter::Frames);
+        if (pendingInput)
+        {
+            telemetry.record(Metric::InputToRender, std::chrono::steady_clock::now() - *pendingInput);
+            pendingInput.reset();
+        }
     }
 
+    if (telemetry.isEnabled())
+    {
+        telemetry.setEnabled(false);
+        if (telemetry.save(telemetryPath))
+            LOG_INFO("Telemetry") << "Session telemetry written to " << telemetryPath;
+        else
+            LOG_WARN("Telemetry") << "Cannot write " << telemetryPath;
+    }
+
+    if (!input.finish(replayReportPath) || !latency.finish(latencyReportPath))
+        return 1;
     return 0;
 }
\ No newline at end of file